@@ -0,0 +1,64 @@
+/**
+ * \file
+ * \brief CaptureReplay class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "CaptureReplay.hpp"
+
+#include "distortos/ThisThread.hpp"
+
+#include <cerrno>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int CaptureReplay::next(CaptureRing::Record& record)
+{
+	if (position_ == 0)
+	{
+		const auto ret = CaptureRing::parsePcapHeader(pcap_, size_);
+		if (ret != 0)
+			return ret;
+
+		position_ = CaptureRing::pcapHeaderSize;
+	}
+
+	if (position_ == size_)
+		return ENOENT;
+
+	size_t recordSize;
+	const auto ret = CaptureRing::parsePcapRecord(pcap_ + position_, size_ - position_, record, recordSize);
+	if (ret != 0)
+		return ret;
+
+	position_ += recordSize;
+	return 0;
+}
+
+void CaptureReplay::waitFor(const CaptureRing::Record& record)
+{
+	if (speedup_ == 0)
+		return;
+
+	if (started_ == false)
+	{
+		start_ = distortos::TickClock::now();
+		firstTimestamp_ = record.timestamp;
+		started_ = true;
+		return;
+	}
+
+	// records older than the first waited record are not delayed
+	if (record.timestamp <= firstTimestamp_)
+		return;
+
+	const std::chrono::microseconds offset {(record.timestamp - firstTimestamp_) / speedup_};
+	distortos::ThisThread::sleepUntil(start_ + std::chrono::duration_cast<distortos::TickClock::duration>(offset));
+}
@@ -0,0 +1,325 @@
+/**
+ * \file
+ * \brief CaptureRing class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "CaptureRing.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <cerrno>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// tag of exported PDU - end of tags
+constexpr uint16_t exportedPduTagEnd {0};
+
+/// tag of exported PDU - name of protocol which dissects the PDU
+constexpr uint16_t exportedPduTagProtocolName {12};
+
+/// tag of exported PDU - type of ports
+constexpr uint16_t exportedPduTagPortType {24};
+
+/// tag of exported PDU - source port
+constexpr uint16_t exportedPduTagSourcePort {25};
+
+/// tag of exported PDU - destination port
+constexpr uint16_t exportedPduTagDestinationPort {26};
+
+/// magic value of pcap file with microsecond resolution
+constexpr uint32_t pcapMagic {0xa1b2c3d4};
+
+/// type of ports of exported PDU - TCP
+constexpr uint32_t exportedPduPortTypeTcp {2};
+
+/// type of ports of exported PDU - UDP
+constexpr uint32_t exportedPduPortTypeUdp {3};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Parses 16-bit value in big-endian byte order.
+ *
+ * \param [in] buffer is a pointer to serialized value
+ *
+ * \return parsed value
+ */
+
+uint16_t parseBigEndian16(const uint8_t* const buffer)
+{
+	return buffer[0] << 8 | buffer[1];
+}
+
+/**
+ * \brief Parses 32-bit value in big-endian byte order.
+ *
+ * \param [in] buffer is a pointer to serialized value
+ *
+ * \return parsed value
+ */
+
+uint32_t parseBigEndian32(const uint8_t* const buffer)
+{
+	return static_cast<uint32_t>(parseBigEndian16(buffer)) << 16 | parseBigEndian16(buffer + 2);
+}
+
+/**
+ * \brief Parses 32-bit value in little-endian byte order.
+ *
+ * \param [in] buffer is a pointer to serialized value
+ *
+ * \return parsed value
+ */
+
+uint32_t parseLittleEndian32(const uint8_t* const buffer)
+{
+	return buffer[0] | buffer[1] << 8 | buffer[2] << 16 | static_cast<uint32_t>(buffer[3]) << 24;
+}
+
+/**
+ * \brief Serializes 16-bit value in big-endian byte order.
+ *
+ * \param [out] buffer is a pointer to buffer for serialized value
+ * \param [in] value is the value which will be serialized
+ *
+ * \return pointer to first byte after serialized value
+ */
+
+uint8_t* serializeBigEndian16(uint8_t* const buffer, const uint16_t value)
+{
+	buffer[0] = value >> 8;
+	buffer[1] = value;
+	return buffer + 2;
+}
+
+/**
+ * \brief Serializes 32-bit value in big-endian byte order.
+ *
+ * \param [out] buffer is a pointer to buffer for serialized value
+ * \param [in] value is the value which will be serialized
+ *
+ * \return pointer to first byte after serialized value
+ */
+
+uint8_t* serializeBigEndian32(uint8_t* const buffer, const uint32_t value)
+{
+	return serializeBigEndian16(serializeBigEndian16(buffer, value >> 16), value);
+}
+
+/**
+ * \brief Serializes 32-bit value in little-endian byte order.
+ *
+ * \param [out] buffer is a pointer to buffer for serialized value
+ * \param [in] value is the value which will be serialized
+ *
+ * \return pointer to first byte after serialized value
+ */
+
+uint8_t* serializeLittleEndian32(uint8_t* const buffer, const uint32_t value)
+{
+	buffer[0] = value;
+	buffer[1] = value >> 8;
+	buffer[2] = value >> 16;
+	buffer[3] = value >> 24;
+	return buffer + 4;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+uint32_t CaptureRing::getOldestTicket() const
+{
+	const auto writeTicket = writeTicket_.load(std::memory_order_acquire);
+	return writeTicket - std::min<uint32_t>(writeTicket, slotsRange_.size());
+}
+
+void CaptureRing::push(const uint8_t channel, const Direction direction, const Protocol protocol,
+		const uint8_t* const frame, const size_t size)
+{
+	const auto timestamp = std::chrono::duration_cast<std::chrono::microseconds>(
+			distortos::TickClock::now().time_since_epoch()).count();
+	const auto ticket = writeTicket_.fetch_add(1, std::memory_order_relaxed);
+	auto& slot = slotsRange_[ticket % slotsRange_.size()];
+	slot.sequence.store(2 * ticket + 1, std::memory_order_relaxed);
+	// readers which observe any of the following writes must also observe odd sequence
+	std::atomic_thread_fence(std::memory_order_release);
+
+	auto& record = slot.record;
+	record.timestamp = timestamp;
+	record.size = size;
+	record.capturedSize = size < snapLength ? size : size_t{snapLength};
+	record.channel = channel;
+	record.direction = direction;
+	record.protocol = protocol;
+	memcpy(record.data, frame, record.capturedSize);
+
+	slot.sequence.store(2 * (ticket + 1), std::memory_order_release);
+}
+
+int CaptureRing::parsePcapHeader(const uint8_t* const buffer, const size_t size)
+{
+	if (size < pcapHeaderSize || parseLittleEndian32(buffer) != pcapMagic ||
+			parseLittleEndian32(buffer + 20) != pcapLinkType)
+		return EINVAL;
+
+	return 0;
+}
+
+int CaptureRing::parsePcapRecord(const uint8_t* const buffer, const size_t size, Record& record, size_t& recordSize)
+{
+	if (size < 16)
+		return EINVAL;
+
+	const auto seconds = parseLittleEndian32(buffer);
+	const auto microseconds = parseLittleEndian32(buffer + 4);
+	const auto includedSize = parseLittleEndian32(buffer + 8);
+	const auto originalSize = parseLittleEndian32(buffer + 12);
+	if (includedSize > size - 16 || originalSize < includedSize)
+		return EINVAL;
+
+	const auto end = buffer + 16 + includedSize;
+	auto position = buffer + 16;
+	auto protocol = Protocol::tcp;
+	uint32_t sourcePort {};
+	uint32_t destinationPort {};
+	while (1)
+	{
+		if (end - position < 4)
+			return EINVAL;
+
+		const auto tag = parseBigEndian16(position);
+		const auto length = parseBigEndian16(position + 2);
+		position += 4;
+		if (tag == exportedPduTagEnd)
+			break;
+
+		if (end - position < length)
+			return EINVAL;
+
+		if (tag == exportedPduTagProtocolName)
+			protocol = strncmp(reinterpret_cast<const char*>(position), "mbudp", length) == 0 ? Protocol::udp :
+					strncmp(reinterpret_cast<const char*>(position), "mbrtu", length) == 0 ? Protocol::rtu :
+					Protocol::tcp;
+		else if (tag == exportedPduTagSourcePort && length == 4)
+			sourcePort = parseBigEndian32(position);
+		else if (tag == exportedPduTagDestinationPort && length == 4)
+			destinationPort = parseBigEndian32(position);
+		position += length;
+	}
+
+	const size_t tagsSize = position - (buffer + 16);
+	// original size of the record includes the tags, the rest must fit in size of the frame
+	if (originalSize < tagsSize || originalSize - tagsSize > std::numeric_limits<decltype(record.size)>::max())
+		return EINVAL;
+
+	const size_t capturedSize = end - position;
+	const auto received = destinationPort == serverPort;
+	record.timestamp = static_cast<uint64_t>(seconds) * 1000000 + microseconds;
+	record.size = originalSize - tagsSize;
+	record.capturedSize = std::min(capturedSize, size_t{snapLength});
+	record.channel = (received == true ? sourcePort : destinationPort) - clientPortBase;
+	record.direction = received == true ? Direction::received : Direction::sent;
+	record.protocol = protocol;
+	memcpy(record.data, position, record.capturedSize);
+	recordSize = 16 + includedSize;
+	return 0;
+}
+
+bool CaptureRing::read(uint32_t& ticket, Record& record) const
+{
+	const auto writeTicket = writeTicket_.load(std::memory_order_acquire);
+	// records which were already overwritten are skipped
+	if (writeTicket - ticket > slotsRange_.size())
+		ticket = writeTicket - slotsRange_.size();
+
+	while (ticket != writeTicket)
+	{
+		const auto& slot = slotsRange_[ticket % slotsRange_.size()];
+		const auto sequence = slot.sequence.load(std::memory_order_acquire);
+		// writer which took this ticket has not completed the record yet
+		if (static_cast<int32_t>(sequence - 2 * (ticket + 1)) < 0)
+			return false;
+
+		if (sequence == 2 * (ticket + 1))
+		{
+			record = slot.record;
+			std::atomic_thread_fence(std::memory_order_acquire);
+			if (slot.sequence.load(std::memory_order_relaxed) == sequence)
+			{
+				++ticket;
+				return true;
+			}
+		}
+
+		// record was overwritten by a writer which lapped the reader
+		++ticket;
+	}
+
+	return false;
+}
+
+void CaptureRing::serializePcapHeader(uint8_t (&buffer)[pcapHeaderSize])
+{
+	auto position = serializeLittleEndian32(buffer, pcapMagic);
+	position = serializeLittleEndian32(position, 2 | 4 << 16);		// version 2.4
+	position = serializeLittleEndian32(position, 0);				// reserved
+	position = serializeLittleEndian32(position, 0);				// reserved
+	position = serializeLittleEndian32(position, pcapRecordHeaderSize - 16 + snapLength);
+	serializeLittleEndian32(position, pcapLinkType);
+}
+
+size_t CaptureRing::serializePcapRecordHeader(const Record& record, const uint32_t epochSeconds,
+		uint8_t (&buffer)[pcapRecordHeaderSize])
+{
+	// tags of exported PDU follow the header of record, they are big-endian and padded to multiple of 4 bytes
+	auto position = buffer + 16;
+	const char* const protocolName = record.protocol == Protocol::tcp ? "mbtcp" :
+			record.protocol == Protocol::udp ? "mbudp" : "mbrtu";
+	const auto protocolNameLength = strlen(protocolName);
+	const auto paddedProtocolNameLength = (protocolNameLength + 3) / 4 * 4;
+	position = serializeBigEndian16(position, exportedPduTagProtocolName);
+	position = serializeBigEndian16(position, paddedProtocolNameLength);
+	memset(position, 0, paddedProtocolNameLength);
+	memcpy(position, protocolName, protocolNameLength);
+	position += paddedProtocolNameLength;
+
+	const uint16_t clientPort = clientPortBase + record.channel;
+	const auto received = record.direction == Direction::received;
+	position = serializeBigEndian16(position, exportedPduTagPortType);
+	position = serializeBigEndian16(position, 4);
+	position = serializeBigEndian32(position, record.protocol == Protocol::udp ? exportedPduPortTypeUdp :
+			exportedPduPortTypeTcp);
+	position = serializeBigEndian16(position, exportedPduTagSourcePort);
+	position = serializeBigEndian16(position, 4);
+	position = serializeBigEndian32(position, received == true ? clientPort : serverPort);
+	position = serializeBigEndian16(position, exportedPduTagDestinationPort);
+	position = serializeBigEndian16(position, 4);
+	position = serializeBigEndian32(position, received == true ? serverPort : clientPort);
+	position = serializeBigEndian16(position, exportedPduTagEnd);
+	position = serializeBigEndian16(position, 0);
+
+	const size_t tagsSize = position - (buffer + 16);
+	auto header = serializeLittleEndian32(buffer, epochSeconds + record.timestamp / 1000000);
+	header = serializeLittleEndian32(header, record.timestamp % 1000000);
+	header = serializeLittleEndian32(header, tagsSize + record.capturedSize);
+	serializeLittleEndian32(header, tagsSize + record.size);
+	return position - buffer;
+}
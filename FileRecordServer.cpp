@@ -0,0 +1,210 @@
+/**
+ * \file
+ * \brief FileRecordServer class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FileRecordServer.hpp"
+
+#include "FileRecordBackend.hpp"
+
+#include <cerrno>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// SubRequest is a parsed sub-request of Read File Record request
+struct SubRequest
+{
+	/// file number
+	uint16_t file;
+
+	/// number of first record
+	uint16_t record;
+
+	/// number of records
+	uint16_t length;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// reference type of all sub-requests
+constexpr uint8_t referenceType {6};
+
+/// size of sub-request header - reference type, file number, record number and record length
+constexpr size_t subRequestSize {7};
+
+/// min value of byte count of Read File Record request
+constexpr uint8_t minReadByteCount {subRequestSize};
+
+/// max value of byte count of Read File Record request
+constexpr uint8_t maxReadByteCount {0xf5};
+
+/// min value of request data length of Write File Record request
+constexpr uint8_t minWriteDataLength {subRequestSize + 2};
+
+/// max value of request data length of Write File Record request
+constexpr uint8_t maxWriteDataLength {0xfb};
+
+/// max number of sub-requests in Read File Record request
+constexpr size_t maxReadSubRequests {maxReadByteCount / subRequestSize};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts error code returned by FileRecordBackend to Modbus exception.
+ *
+ * \param [in] ret is the error code returned by FileRecordBackend
+ *
+ * \return Modbus exception which corresponds to \a ret
+ */
+
+eMBException backendErrorToException(const int ret)
+{
+	if (ret == 0)
+		return MB_EX_NONE;
+	if (ret == EINVAL || ret == ENOENT)
+		return MB_EX_ILLEGAL_DATA_ADDRESS;
+	return MB_EX_SLAVE_DEVICE_FAILURE;
+}
+
+/**
+ * \brief Parses and validates header of sub-request.
+ *
+ * \param [in] buffer is a pointer to header of sub-request, subRequestSize bytes
+ * \param [out] subRequest is a reference to variable for parsed sub-request
+ *
+ * \return MB_EX_NONE if sub-request is valid, exception code which will be sent in response otherwise
+ */
+
+eMBException parseSubRequest(const uint8_t* const buffer, SubRequest& subRequest)
+{
+	subRequest.file = buffer[1] << 8 | buffer[2];
+	subRequest.record = buffer[3] << 8 | buffer[4];
+	subRequest.length = buffer[5] << 8 | buffer[6];
+
+	if (subRequest.length == 0)
+		return MB_EX_ILLEGAL_DATA_VALUE;
+	if (buffer[0] != referenceType || subRequest.file == 0 ||
+			subRequest.record >= FileRecordServer::recordsPerFile ||
+			subRequest.length > FileRecordServer::recordsPerFile - subRequest.record)
+		return MB_EX_ILLEGAL_DATA_ADDRESS;
+
+	return MB_EX_NONE;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+eMBException FileRecordServer::readFileRecord(uint8_t* const pdu, uint16_t* const pduSize) const
+{
+	if (*pduSize < 2)
+		return MB_EX_ILLEGAL_DATA_VALUE;
+
+	const auto byteCount = pdu[1];
+	if (byteCount < minReadByteCount || byteCount > maxReadByteCount ||
+			byteCount % subRequestSize != 0 || *pduSize != 2 + byteCount)
+		return MB_EX_ILLEGAL_DATA_VALUE;
+
+	// response overwrites the request, so all sub-requests are parsed first
+	SubRequest subRequests[maxReadSubRequests];
+	const size_t subRequestsCount {byteCount / subRequestSize};
+	size_t responseSize {2};
+	for (size_t index {}; index < subRequestsCount; ++index)
+	{
+		const auto exception = parseSubRequest(pdu + 2 + index * subRequestSize, subRequests[index]);
+		if (exception != MB_EX_NONE)
+			return exception;
+
+		responseSize += 2 + subRequests[index].length * 2;
+		if (responseSize > maxPduSize)
+			return MB_EX_ILLEGAL_DATA_VALUE;
+	}
+
+	size_t position {2};
+	for (size_t index {}; index < subRequestsCount; ++index)
+	{
+		const auto& subRequest = subRequests[index];
+		const size_t size = subRequest.length * 2;
+		pdu[position++] = 1 + size;
+		pdu[position++] = referenceType;
+		const auto ret = backend_.read(subRequest.file, subRequest.record * 2, pdu + position, size);
+		if (ret != 0)
+			return backendErrorToException(ret);
+		position += size;
+	}
+
+	const auto& lastSubRequest = subRequests[subRequestsCount - 1];
+	const size_t lastSize = lastSubRequest.length * 2;
+	backend_.prefetch(lastSubRequest.file, lastSubRequest.record * 2 + lastSize, lastSize);
+
+	pdu[1] = responseSize - 2;
+	*pduSize = responseSize;
+	return MB_EX_NONE;
+}
+
+eMBException FileRecordServer::writeFileRecord(uint8_t* const pdu, uint16_t* const pduSize) const
+{
+	if (*pduSize < 2)
+		return MB_EX_ILLEGAL_DATA_VALUE;
+
+	const auto dataLength = pdu[1];
+	if (dataLength < minWriteDataLength || dataLength > maxWriteDataLength ||
+			*pduSize != 2 + dataLength)
+		return MB_EX_ILLEGAL_DATA_VALUE;
+
+	// all sub-requests are validated, also against sizes of files, before anything is written
+	const size_t end {2u + dataLength};
+	size_t position {2};
+	while (position < end)
+	{
+		SubRequest subRequest;
+		if (end - position < subRequestSize)
+			return MB_EX_ILLEGAL_DATA_VALUE;
+		const auto exception = parseSubRequest(pdu + position, subRequest);
+		if (exception != MB_EX_NONE)
+			return exception;
+		position += subRequestSize;
+		if (end - position < subRequest.length * 2u)
+			return MB_EX_ILLEGAL_DATA_VALUE;
+		position += subRequest.length * 2;
+
+		const auto ret = backend_.getSize(subRequest.file);
+		if (ret.first != 0)
+			return backendErrorToException(ret.first);
+		if (ret.second < (subRequest.record + subRequest.length) * 2u)
+			return MB_EX_ILLEGAL_DATA_ADDRESS;
+	}
+
+	position = 2;
+	while (position < end)
+	{
+		SubRequest subRequest;
+		parseSubRequest(pdu + position, subRequest);
+		position += subRequestSize;
+		const size_t size = subRequest.length * 2;
+		const auto ret = backend_.write(subRequest.file, subRequest.record * 2, pdu + position, size);
+		if (ret != 0)
+			return backendErrorToException(ret);
+		position += size;
+	}
+
+	// response is an echo of the request
+	return MB_EX_NONE;
+}
@@ -0,0 +1,93 @@
+/**
+ * \file
+ * \brief FrameBufferPool class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FrameBufferPool.hpp"
+
+#include <cassert>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// mask of index of first free buffer in head of stack
+constexpr uint32_t indexMask {UINT16_MAX};
+
+/// increment of modification tag in head of stack
+constexpr uint32_t tagIncrement {indexMask + 1};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void FrameBufferPool::deallocate(uint8_t* const buffer)
+{
+	assert(buffer >= storage_ && buffer < storage_ + blockSize_ * blocksCount_ &&
+			(buffer - storage_) % blockSize_ == 0);
+
+	const uint16_t index = (buffer - storage_) / blockSize_;
+	auto head = head_.load(std::memory_order_relaxed);
+	uint32_t newHead;
+	do
+	{
+		links_[index].store(head & indexMask, std::memory_order_relaxed);
+		newHead = ((head & ~indexMask) + tagIncrement) | index;
+	} while (head_.compare_exchange_weak(head, newHead, std::memory_order_release, std::memory_order_relaxed) ==
+			false);
+
+	usedBlocks_.fetch_sub(1, std::memory_order_relaxed);
+}
+
+uint8_t* FrameBufferPool::tryAllocate()
+{
+	{
+		auto head = head_.load(std::memory_order_acquire);
+		while ((head & indexMask) != endIndex)
+		{
+			const auto index = head & indexMask;
+			// tag makes the exchange fail if the buffer was allocated and freed again after the link was read
+			const auto newHead = ((head & ~indexMask) + tagIncrement) | links_[index].load(std::memory_order_relaxed);
+			if (head_.compare_exchange_weak(head, newHead, std::memory_order_acquire, std::memory_order_acquire) ==
+					true)
+			{
+				updateCounters();
+				return storage_ + index * blockSize_;
+			}
+		}
+	}
+
+	auto index = nextUnusedBlock_.load(std::memory_order_relaxed);
+	while (index < blocksCount_)
+		if (nextUnusedBlock_.compare_exchange_weak(index, index + 1, std::memory_order_relaxed) == true)
+		{
+			updateCounters();
+			return storage_ + index * blockSize_;
+		}
+
+	allocationFailures_.fetch_add(1, std::memory_order_relaxed);
+	return {};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void FrameBufferPool::updateCounters()
+{
+	const uint16_t usedBlocks = usedBlocks_.fetch_add(1, std::memory_order_relaxed) + 1;
+	auto peakUsedBlocks = peakUsedBlocks_.load(std::memory_order_relaxed);
+	while (usedBlocks > peakUsedBlocks &&
+			peakUsedBlocks_.compare_exchange_weak(peakUsedBlocks, usedBlocks, std::memory_order_relaxed) == false);
+}
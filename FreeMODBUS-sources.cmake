@@ -8,13 +8,33 @@
 #
 
 add_library(FreeMODBUS-integration STATIC
+		${CMAKE_CURRENT_LIST_DIR}/CaptureReplay.cpp
+		${CMAKE_CURRENT_LIST_DIR}/CaptureRing.cpp
 		${CMAKE_CURRENT_LIST_DIR}/errorCodeToFreemodbusError.cpp
+		${CMAKE_CURRENT_LIST_DIR}/FileRecordServer.cpp
+		${CMAKE_CURRENT_LIST_DIR}/FrameBufferPool.cpp
 		${CMAKE_CURRENT_LIST_DIR}/freemodbusErrorToErrorCode.cpp
 		${CMAKE_CURRENT_LIST_DIR}/freemodbusEvents.cpp
+		${CMAKE_CURRENT_LIST_DIR}/FreemodbusExecutor.cpp
+		${CMAKE_CURRENT_LIST_DIR}/freemodbusFrameBuffer.cpp
+		${CMAKE_CURRENT_LIST_DIR}/freemodbusLocal.cpp
+		${CMAKE_CURRENT_LIST_DIR}/FreemodbusScheduler.cpp
 		${CMAKE_CURRENT_LIST_DIR}/freemodbusSerial.cpp
 		${CMAKE_CURRENT_LIST_DIR}/freemodbusTcp.cpp
 		${CMAKE_CURRENT_LIST_DIR}/freemodbusTimers.cpp
-		${CMAKE_CURRENT_LIST_DIR}/ListenSocket.cpp)
+		${CMAKE_CURRENT_LIST_DIR}/freemodbusUdp.cpp
+		${CMAKE_CURRENT_LIST_DIR}/FreemodbusWaitSet.cpp
+		${CMAKE_CURRENT_LIST_DIR}/FreemodbusWorkerPool.cpp
+		${CMAKE_CURRENT_LIST_DIR}/HotRangeCache.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ListenSocket.cpp
+		${CMAKE_CURRENT_LIST_DIR}/LocalRing.cpp
+		${CMAKE_CURRENT_LIST_DIR}/MbedtlsTransport.cpp
+		${CMAKE_CURRENT_LIST_DIR}/modbusAscii.cpp
+		${CMAKE_CURRENT_LIST_DIR}/modbusCrc16.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ModbusGateway.cpp
+		${CMAKE_CURRENT_LIST_DIR}/ModbusTcpMaster.cpp
+		${CMAKE_CURRENT_LIST_DIR}/RequestRateLimiter.cpp
+		${CMAKE_CURRENT_LIST_DIR}/WriteNotificationQueue.cpp)
 target_include_directories(FreeMODBUS-integration PUBLIC
 		${CMAKE_CURRENT_LIST_DIR}/include
 		$<TARGET_PROPERTY:FreeMODBUS,INTERFACE_INCLUDE_DIRECTORIES>)
@@ -26,6 +46,25 @@ if(TARGET lwipcore)
 			lwipcore)
 endif()
 
+if(TARGET mbedtls)
+	target_link_libraries(FreeMODBUS-integration PUBLIC
+			mbedtls)
+endif()
+
+option(FreeMODBUS_INTEGRATION_BENCHMARK
+		"Build FreeMODBUS-integration-benchmark - micro-benchmark of port layer for ARMv7-M cores" OFF)
+
+if(FreeMODBUS_INTEGRATION_BENCHMARK)
+	add_library(FreeMODBUS-integration-benchmark STATIC
+			${CMAKE_CURRENT_LIST_DIR}/benchmark/FreemodbusBenchmark.cpp)
+	target_include_directories(FreeMODBUS-integration-benchmark PUBLIC
+			${CMAKE_CURRENT_LIST_DIR}/benchmark
+			PRIVATE
+			${CMAKE_CURRENT_LIST_DIR})
+	target_link_libraries(FreeMODBUS-integration-benchmark PUBLIC
+			FreeMODBUS-integration)
+endif()
+
 target_link_libraries(FreeMODBUS PUBLIC
 		FreeMODBUS-integration)
 add_library(FreeMODBUS::FreeMODBUS ALIAS FreeMODBUS)
@@ -0,0 +1,186 @@
+/**
+ * \file
+ * \brief FreemodbusExecutor class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FreemodbusExecutor.hpp"
+
+#if defined(__cpp_impl_coroutine)
+
+#include "freemodbusEvents.hpp"
+#include "FreemodbusSerialInstance.hpp"
+#include "freemodbusSerialPoll.hpp"
+#include "FreemodbusTcpInstance.hpp"
+#include "freemodbusTcpPoll.hpp"
+#include "freemodbusTimersPoll.hpp"
+#include "FreemodbusWaitSet.hpp"
+
+#include "mb.h"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| FreemodbusExecutor::Awaitable's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void FreemodbusExecutor::Awaitable::await_suspend(const std::coroutine_handle<> coroutine)
+{
+	coroutine_ = coroutine;
+	next_ = executor_.head_;
+	executor_.head_ = this;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| FreemodbusExecutor::Awaitable's private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool FreemodbusExecutor::Awaitable::isReady()
+{
+	if (type_ == Type::timerExpired)
+		return distortos::TickClock::now() >= deadline_;
+
+#if MB_TCP_ENABLED == 1
+
+	if (type_ == Type::writable)
+	{
+		fd_set fdSet;
+		FD_ZERO(&fdSet);
+		FD_SET(socket_, &fdSet);
+		timeval timeout {};
+		return lwip_select(socket_ + 1, nullptr, &fdSet, nullptr, &timeout) != 0;
+	}
+
+#endif	// MB_TCP_ENABLED == 1
+
+	auto& instance = *instance_;
+	const auto mode = instance.rawInstance.eMBCurrentMode;
+	if (type_ == Type::responseSent)
+	{
+#if MB_TCP_ENABLED == 1
+		if (mode == MB_TCP)
+			return freemodbusTcpFlush(static_cast<FreemodbusTcpInstance&>(instance));
+#endif	// MB_TCP_ENABLED == 1
+
+		return freemodbusSerialFlush(static_cast<FreemodbusSerialInstance&>(instance));
+	}
+
+	instance.nonBlocking = true;
+	if (freemodbusHasPendingEvents(instance) == true)
+		return true;
+
+	// serial port is read before timers are checked, as bytes waiting in serial port belong to the current frame
+	if (mode == MB_RTU || mode == MB_ASCII)
+	{
+		auto& serialInstance = static_cast<FreemodbusSerialInstance&>(instance);
+		freemodbusSerialPoll(serialInstance, distortos::TickClock::now());
+		freemodbusTimersPoll(serialInstance);
+	}
+#if MB_TCP_ENABLED == 1
+	else if (mode == MB_TCP)
+		freemodbusTcpPoll(static_cast<FreemodbusTcpInstance&>(instance), distortos::TickClock::now());
+#endif	// MB_TCP_ENABLED == 1
+
+	return freemodbusHasPendingEvents(instance);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void FreemodbusExecutor::poll(const distortos::TickClock::time_point deadline)
+{
+	// ready awaitables are moved to separate list first, as resumed coroutines add new awaitables to the executor
+	Awaitable* readyHead {};
+	auto previous = &head_;
+	while (*previous != nullptr)
+	{
+		const auto awaitable = *previous;
+		if (awaitable->isReady() == true)
+		{
+			*previous = awaitable->next_;
+			awaitable->next_ = readyHead;
+			readyHead = awaitable;
+		}
+		else
+			previous = &awaitable->next_;
+	}
+
+	if (readyHead != nullptr)
+	{
+		while (readyHead != nullptr)
+		{
+			const auto awaitable = readyHead;
+			readyHead = awaitable->next_;
+			awaitable->coroutine_.resume();
+		}
+
+		return;
+	}
+
+	wait(deadline);
+}
+
+void FreemodbusExecutor::run()
+{
+	while (1)
+		poll(distortos::TickClock::time_point::max());
+}
+
+FreemodbusTask FreemodbusExecutor::serve(FreemodbusInstance& instance)
+{
+	instance.nonBlockingSend = true;
+	while (1)
+	{
+		co_await frameReceived(instance);
+
+		// first step handles the received frame, following ones handle events generated by it (execution, sending),
+		// instance which is not enabled does not consume its events; response left in the frame buffer is sent by the
+		// executor before next step
+		do
+		{
+			if (eMBPoll(&instance.rawInstance) != MB_ENOERR)
+				break;
+
+			co_await responseSent(instance);
+		} while (freemodbusHasPendingEvents(instance) == true);
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void FreemodbusExecutor::wait(const distortos::TickClock::time_point deadline) const
+{
+	FreemodbusWaitSet waitSet {deadline, serialPollPeriod_};
+	for (auto awaitable = head_; awaitable != nullptr; awaitable = awaitable->next_)
+	{
+		if (awaitable->type_ == Awaitable::Type::timerExpired)
+			waitSet.addDeadline(awaitable->deadline_);
+#if MB_TCP_ENABLED == 1
+		else if (awaitable->type_ == Awaitable::Type::writable)
+			waitSet.addWritable(awaitable->socket_);
+#endif	// MB_TCP_ENABLED == 1
+		else if (awaitable->type_ == Awaitable::Type::responseSent)
+		{
+#if MB_TCP_ENABLED == 1
+			const auto& instance = *awaitable->instance_;
+			if (instance.rawInstance.eMBCurrentMode == MB_TCP)
+				waitSet.addWritable(static_cast<const FreemodbusTcpInstance&>(instance).clientSocket);
+			else
+#endif	// MB_TCP_ENABLED == 1
+				// write buffer of serial port is not visible to select, so it is checked on every serial poll
+				waitSet.addSerialPoll();
+		}
+		else
+			waitSet.addInstance(*awaitable->instance_);
+	}
+
+	waitSet.wait();
+}
+
+#endif	// defined(__cpp_impl_coroutine)
@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief FreemodbusScheduler class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FreemodbusScheduler.hpp"
+
+#include "freemodbusEvents.hpp"
+#include "FreemodbusTcpInstance.hpp"
+#include "FreemodbusWaitSet.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "FreemodbusTcpExtensions.hpp"
+#include "FreemodbusWorkerPool.hpp"
+
+#endif	// MB_TCP_ENABLED == 1
+
+#include "mb.h"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void FreemodbusScheduler::poll(const distortos::TickClock::time_point deadline) const
+{
+#if MB_TCP_ENABLED == 1
+
+	// executions done after this point wake the scheduler again
+	if (workerPool_ != nullptr)
+		workerPool_->consumeWake();
+
+#endif	// MB_TCP_ENABLED == 1
+
+	for (const auto instance : range_)
+	{
+		instance->nonBlocking = true;
+
+#if MB_TCP_ENABLED == 1
+
+		// instance without Modbus TCP extensions has no flag of execution, so it is always executed here
+		const auto tcpExtensions = instance->rawInstance.eMBCurrentMode == MB_TCP ?
+				static_cast<FreemodbusTcpInstance&>(*instance).tcpExtensions : nullptr;
+		if (workerPool_ != nullptr && tcpExtensions != nullptr)
+		{
+			auto& tcpInstance = static_cast<FreemodbusTcpInstance&>(*instance);
+			if (tcpExtensions->executing.load(std::memory_order_acquire) == true)
+				continue;
+
+			// only I/O and reassembly are done here, stepping stops when complete request is ready for execution
+			while (eMBPoll(&instance->rawInstance) == MB_ENOERR && instance->pendingEvents[EV_EXECUTE] == 0 &&
+					freemodbusHasPendingEvents(*instance) == true);
+
+			if (instance->pendingEvents[EV_EXECUTE] == 0)
+				continue;
+
+			tcpExtensions->executing.store(true, std::memory_order_relaxed);
+			if (workerPool_->submit(tcpInstance) == true)
+				continue;
+
+			// queues of the pool are full, so the request is executed here
+			tcpExtensions->executing.store(false, std::memory_order_relaxed);
+		}
+
+#endif	// MB_TCP_ENABLED == 1
+
+		// first step handles available data, following ones handle events generated by it (execution, sending),
+		// instance which is not enabled does not consume its events
+		while (eMBPoll(&instance->rawInstance) == MB_ENOERR && freemodbusHasPendingEvents(*instance) == true);
+	}
+
+	wait(deadline);
+}
+
+void FreemodbusScheduler::run() const
+{
+	while (1)
+		poll(distortos::TickClock::time_point::max());
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void FreemodbusScheduler::wait(const distortos::TickClock::time_point deadline) const
+{
+	FreemodbusWaitSet waitSet {deadline, serialPollPeriod_};
+	for (const auto instance : range_)
+	{
+#if MB_TCP_ENABLED == 1
+
+		// instance executed by worker pool is not touched until its execution is done, which is signaled by wake
+		// socket of the pool
+		const auto tcpExtensions = instance->rawInstance.eMBCurrentMode == MB_TCP ?
+				static_cast<const FreemodbusTcpInstance&>(*instance).tcpExtensions : nullptr;
+		if (tcpExtensions != nullptr && tcpExtensions->executing.load(std::memory_order_relaxed) == true)
+		{
+			if (workerPool_->getWakeSocket() != -1)
+				waitSet.addReadable(workerPool_->getWakeSocket());
+			else
+				waitSet.addSerialPoll();
+			continue;
+		}
+
+#endif	// MB_TCP_ENABLED == 1
+
+		waitSet.addInstance(*instance);
+	}
+
+	waitSet.wait();
+}
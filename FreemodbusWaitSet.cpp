@@ -0,0 +1,142 @@
+/**
+ * \file
+ * \brief FreemodbusWaitSet class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FreemodbusWaitSet.hpp"
+
+#include "FreemodbusSerialInstance.hpp"
+#include "FreemodbusTcpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "freemodbusListenSockets.hpp"
+#include "FreemodbusTcpExtensions.hpp"
+#include "TcpTransport.hpp"
+
+#endif	// MB_TCP_ENABLED == 1
+
+#include "distortos/ThisThread.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+FreemodbusWaitSet::FreemodbusWaitSet(const distortos::TickClock::time_point deadline,
+		const distortos::TickClock::duration serialPollPeriod) :
+#if MB_TCP_ENABLED == 1
+				readFdSet_{},
+				writeFdSet_{},
+				maxSocket_{-1},
+#endif	// MB_TCP_ENABLED == 1
+				deadline_{deadline},
+				now_{distortos::TickClock::now()},
+				serialPollPeriod_{serialPollPeriod}
+{
+#if MB_TCP_ENABLED == 1
+	FD_ZERO(&readFdSet_);
+	FD_ZERO(&writeFdSet_);
+#endif	// MB_TCP_ENABLED == 1
+}
+
+void FreemodbusWaitSet::addInstance(const FreemodbusInstance& instance)
+{
+#if MB_TCP_ENABLED == 1
+
+	if (instance.rawInstance.eMBCurrentMode == MB_TCP)
+	{
+		const auto& tcpInstance = static_cast<const FreemodbusTcpInstance&>(instance);
+		const auto extensions = tcpInstance.tcpExtensions;
+		if (extensions != nullptr && extensions->txBatchSize != 0)
+			addDeadline(extensions->txBatchDeadline);
+		// nothing is received while request is deferred, so the instance waits only for its admission
+		if (extensions != nullptr && extensions->admissionTime != distortos::TickClock::time_point{})
+		{
+			addDeadline(extensions->admissionTime);
+			return;
+		}
+
+		if (tcpInstance.clientSocket != -1)
+			addReadable(tcpInstance.clientSocket);
+		else
+			forEachListenSocket(tcpInstance,
+					[this](const ListenSocket& listenSocket)
+					{
+						if (listenSocket.getSocket() != -1)
+							addReadable(listenSocket.getSocket());
+					});
+		if (tcpInstance.clientSocket != -1 &&
+				tcpInstance.tcpKeepaliveDuration != distortos::TickClock::duration{})
+			addDeadline(tcpInstance.tcpKeepaliveDeadline);
+		// data already decrypted by transport and timeouts of transport are not visible to select
+		if (tcpInstance.clientSocket != -1 && extensions != nullptr && extensions->transport != nullptr)
+			addDeadline(extensions->transport->hasBufferedData() == true ? now_ : extensions->transport->getDeadline());
+
+		return;
+	}
+
+#endif	// MB_TCP_ENABLED == 1
+
+	const auto& serialInstance = static_cast<const FreemodbusSerialInstance&>(instance);
+	addDeadline(serialInstance.timerDeadline);
+	if (serialInstance.serialMode != FreemodbusSerialInstance::SerialMode::disabled)
+		addSerialPoll();
+}
+
+#if MB_TCP_ENABLED == 1
+
+void FreemodbusWaitSet::addReadable(const int socket)
+{
+	FD_SET(socket, &readFdSet_);
+	maxSocket_ = std::max(maxSocket_, socket);
+}
+
+void FreemodbusWaitSet::addWritable(const int socket)
+{
+	FD_SET(socket, &writeFdSet_);
+	maxSocket_ = std::max(maxSocket_, socket);
+}
+
+#endif	// MB_TCP_ENABLED == 1
+
+void FreemodbusWaitSet::wait()
+{
+#if MB_TCP_ENABLED == 1
+
+	if (maxSocket_ != -1)
+	{
+		auto timeout = toTimeval(deadline_ - distortos::TickClock::now());
+		lwip_select(maxSocket_ + 1, &readFdSet_, &writeFdSet_, nullptr,
+				deadline_ != distortos::TickClock::time_point::max() ? &timeout : nullptr);
+		return;
+	}
+
+#endif	// MB_TCP_ENABLED == 1
+
+	distortos::ThisThread::sleepUntil(deadline_);
+}
+
+#if MB_TCP_ENABLED == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+timeval toTimeval(distortos::TickClock::duration duration)
+{
+	duration = std::max(duration, distortos::TickClock::duration{});
+	const auto seconds = std::chrono::duration_cast<std::chrono::seconds>(duration);
+	const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(duration - seconds);
+	timeval timeout {};
+	timeout.tv_sec = seconds.count();
+	timeout.tv_usec = microseconds.count();
+	return timeout;
+}
+
+#endif	// MB_TCP_ENABLED == 1
@@ -0,0 +1,153 @@
+/**
+ * \file
+ * \brief FreemodbusWaitSet class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_FREEMODBUSWAITSET_HPP_
+#define FREEMODBUS_INTEGRATION_FREEMODBUSWAITSET_HPP_
+
+#include "FreemodbusInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "lwip/sockets.h"
+
+#endif	// MB_TCP_ENABLED == 1
+
+#include "distortos/TickClock.hpp"
+
+#include <algorithm>
+
+/**
+ * FreemodbusWaitSet collects sockets and deadlines of instances of FreeMODBUS handled by one thread, then waits for
+ * activity on any of them.
+ *
+ * Used by FreemodbusScheduler and FreemodbusExecutor, which poll instances in non-blocking mode.
+ */
+
+class FreemodbusWaitSet
+{
+public:
+
+	/**
+	 * \brief FreemodbusWaitSet's constructor
+	 *
+	 * \param [in] deadline is the initial deadline of waiting
+	 * \param [in] serialPollPeriod is the max interval between polls of serial ports
+	 */
+
+	FreemodbusWaitSet(distortos::TickClock::time_point deadline, distortos::TickClock::duration serialPollPeriod);
+
+	/**
+	 * \brief Adds deadline of waiting.
+	 *
+	 * \param [in] deadline is the deadline, waiting ends at the earliest of added deadlines
+	 */
+
+	void addDeadline(const distortos::TickClock::time_point deadline)
+	{
+		deadline_ = std::min(deadline_, deadline);
+	}
+
+	/**
+	 * \brief Adds instance of FreeMODBUS.
+	 *
+	 * Modbus TCP instance adds its client socket (or its listen sockets if no client is connected) and deadlines of
+	 * keepalive, batch of responses and transport - instance with deferred request adds only deadline of its admission
+	 * and of batch of responses. Other instances add deadline of their timer and - if their serial port is enabled -
+	 * deadline of next serial poll.
+	 *
+	 * \param [in] instance is a reference to instance of FreeMODBUS
+	 */
+
+	void addInstance(const FreemodbusInstance& instance);
+
+	/**
+	 * \brief Adds deadline of next serial poll.
+	 *
+	 * Used for instances whose activity is not visible in the wait set.
+	 */
+
+	void addSerialPoll()
+	{
+		addDeadline(now_ + serialPollPeriod_);
+	}
+
+#if MB_TCP_ENABLED == 1
+
+	/**
+	 * \brief Adds socket which is waited for until it can be read without blocking.
+	 *
+	 * \param [in] socket is the socket
+	 */
+
+	void addReadable(int socket);
+
+	/**
+	 * \brief Adds socket which is waited for until it can be written without blocking.
+	 *
+	 * \param [in] socket is the socket
+	 */
+
+	void addWritable(int socket);
+
+#endif	// MB_TCP_ENABLED == 1
+
+	/**
+	 * \brief Waits for activity on any of added sockets, bounded by the earliest of added deadlines.
+	 *
+	 * If no socket was added, current thread just sleeps until the deadline.
+	 */
+
+	void wait();
+
+private:
+
+#if MB_TCP_ENABLED == 1
+
+	/// set of sockets waited for until they can be read
+	fd_set readFdSet_;
+
+	/// set of sockets waited for until they can be written
+	fd_set writeFdSet_;
+
+	/// highest added socket, -1 if no socket was added
+	int maxSocket_;
+
+#endif	// MB_TCP_ENABLED == 1
+
+	/// deadline of waiting
+	distortos::TickClock::time_point deadline_;
+
+	/// time point at which the wait set was created
+	distortos::TickClock::time_point now_;
+
+	/// max interval between polls of serial ports
+	distortos::TickClock::duration serialPollPeriod_;
+};
+
+#if MB_TCP_ENABLED == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts duration to timeval.
+ *
+ * \param [in] duration is the duration which will be converted, negative values are treated as zero
+ *
+ * \return \a duration converted to timeval
+ */
+
+timeval toTimeval(distortos::TickClock::duration duration);
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_FREEMODBUSWAITSET_HPP_
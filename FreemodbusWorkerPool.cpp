@@ -0,0 +1,176 @@
+/**
+ * \file
+ * \brief FreemodbusWorkerPool class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FreemodbusWorkerPool.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "freemodbusEvents.hpp"
+#include "FreemodbusTcpExtensions.hpp"
+#include "FreemodbusTcpInstance.hpp"
+
+#include "mb.h"
+
+#include "lwip/sockets.h"
+
+#include "estd/ScopeGuard.hpp"
+
+#include <mutex>
+
+#include <cassert>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| FreemodbusWorkerPool::Worker's private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+FreemodbusTcpInstance* FreemodbusWorkerPool::Worker::tryPopFront()
+{
+	std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+
+	if (queueSize_ == 0)
+		return {};
+
+	const auto instance = queueRange_[queueBegin_];
+	queueBegin_ = (queueBegin_ + 1) % queueRange_.size();
+	--queueSize_;
+	return instance;
+}
+
+FreemodbusTcpInstance* FreemodbusWorkerPool::Worker::tryPopBack()
+{
+	std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+
+	if (queueSize_ == 0)
+		return {};
+
+	--queueSize_;
+	return queueRange_[(queueBegin_ + queueSize_) % queueRange_.size()];
+}
+
+bool FreemodbusWorkerPool::Worker::tryPush(FreemodbusTcpInstance& instance)
+{
+	{
+		std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+
+		if (queueSize_ >= queueRange_.size())
+			return false;
+
+		queueRange_[(queueBegin_ + queueSize_) % queueRange_.size()] = &instance;
+		++queueSize_;
+	}
+
+	semaphore_.post();	// EOVERFLOW is expected if the worker was not woken since previous post
+	return true;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void FreemodbusWorkerPool::consumeWake()
+{
+	if (wakeSocket_ == -1)
+		return;
+
+	wakePending_.store(false, std::memory_order_release);
+	uint8_t buffer[4];
+	while (lwip_recv(wakeSocket_, buffer, sizeof(buffer), MSG_DONTWAIT) > 0);
+}
+
+int FreemodbusWorkerPool::openWakeSocket()
+{
+	if (wakeSocket_ != -1)
+		return EBUSY;
+
+	const auto wakeSocket = lwip_socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (wakeSocket == -1)
+		return errno;
+
+	auto closeScopeGuard = estd::makeScopeGuard(
+			[wakeSocket]()
+			{
+				lwip_close(wakeSocket);
+			});
+
+	sockaddr_in address {};
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	if (lwip_bind(wakeSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+		return errno;
+
+	// socket is connected to its own port, selected by lwIP
+	socklen_t length = sizeof(address);
+	if (lwip_getsockname(wakeSocket, reinterpret_cast<sockaddr*>(&address), &length) == -1)
+		return errno;
+	if (lwip_connect(wakeSocket, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1)
+		return errno;
+
+	closeScopeGuard.release();
+	wakeSocket_ = wakeSocket;
+	return 0;
+}
+
+void FreemodbusWorkerPool::runWorker(const size_t index)
+{
+	assert(index < workersRange_.size());
+
+	auto& worker = workersRange_[index];
+	while (1)
+	{
+		auto instance = worker.tryPopFront();
+		for (size_t i {1}; instance == nullptr && i < workersRange_.size(); ++i)
+			instance = workersRange_[(index + i) % workersRange_.size()].tryPopBack();
+
+		if (instance == nullptr)
+		{
+			worker.semaphore_.wait();
+			continue;
+		}
+
+		worker.busy_.store(true, std::memory_order_relaxed);
+
+		// pending EV_EXECUTE is handled - function handler is executed and response is sent, instance which is not
+		// enabled does not consume its events
+		while (eMBPoll(&instance->rawInstance) == MB_ENOERR && freemodbusHasPendingEvents(*instance) == true);
+
+		worker.busy_.store(false, std::memory_order_relaxed);
+		instance->tcpExtensions->executing.store(false, std::memory_order_release);
+
+		// only one datagram is in flight, the scheduler checks all instances when it is received
+		if (wakeSocket_ != -1 && wakePending_.exchange(true, std::memory_order_acq_rel) == false)
+		{
+			const uint8_t byte {};
+			lwip_send(wakeSocket_, &byte, sizeof(byte), MSG_DONTWAIT);
+		}
+	}
+}
+
+bool FreemodbusWorkerPool::submit(FreemodbusTcpInstance& instance)
+{
+	assert(instance.tcpExtensions != nullptr &&
+			instance.tcpExtensions->executing.load(std::memory_order_relaxed) == true);
+
+	const auto first = nextWorker_.fetch_add(1, std::memory_order_relaxed);
+	for (size_t i {}; i < workersRange_.size(); ++i)
+	{
+		auto& worker = workersRange_[(first + i) % workersRange_.size()];
+		if (worker.busy_.load(std::memory_order_relaxed) == false && worker.tryPush(instance) == true)
+			return true;
+	}
+
+	for (size_t i {}; i < workersRange_.size(); ++i)
+		if (workersRange_[(first + i) % workersRange_.size()].tryPush(instance) == true)
+			return true;
+
+	return false;
+}
+
+#endif	// MB_TCP_ENABLED == 1
@@ -0,0 +1,217 @@
+/**
+ * \file
+ * \brief HotRangeCache class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "HotRangeCache.hpp"
+
+#include "modbusCrc16.hpp"
+
+#include "mb.h"
+
+#include <algorithm>
+#include <mutex>
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// max number of registers in a single read request
+constexpr uint16_t maxCount {125};
+
+/// offset of register values in Modbus RTU response frame
+constexpr size_t valuesOffset {3};
+
+/// size of Modbus RTU frame fields which are not part of PDU - address and CRC
+constexpr size_t rtuOverhead {3};
+
+/// size of chunks in which CRC of difference between old and new values is calculated
+constexpr size_t differenceChunkSize {16};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Writes CRC to the end of Modbus RTU frame.
+ *
+ * \param [in] frame is a pointer to Modbus RTU frame
+ * \param [in] frameSize is the size of \a frame, including CRC field, bytes
+ * \param [in] crc is the CRC which will be written
+ */
+
+void writeCrc(uint8_t* const frame, const size_t frameSize, const uint16_t crc)
+{
+	frame[frameSize - 2] = crc;
+	frame[frameSize - 1] = crc >> 8;
+}
+
+/**
+ * \brief Patches bytes of Modbus RTU frame and updates its CRC incrementally.
+ *
+ * CRC is linear, so CRC of patched frame is equal to CRC of original frame xor CRC (with zero initial value) of the
+ * difference between both frames. Only the range between first and last changed byte is xored, the zero tail up to
+ * the CRC field only shifts the CRC of difference, so the cost never exceeds calculating CRC of the whole frame.
+ *
+ * \param [in,out] frame is a pointer to Modbus RTU frame
+ * \param [in] frameSize is the size of \a frame, including CRC field, bytes
+ * \param [in] offset is the offset of patched bytes in \a frame
+ * \param [in] values is a pointer to new values of patched bytes
+ * \param [in] size is the number of patched bytes
+ */
+
+void patchFrame(uint8_t* const frame, const size_t frameSize, const size_t offset, const uint8_t* const values,
+		const size_t size)
+{
+	const auto patched = frame + offset;
+	size_t first {};
+	while (first < size && patched[first] == values[first])
+		++first;
+	if (first == size)
+		return;
+
+	auto last = size;
+	while (patched[last - 1] == values[last - 1])
+		--last;
+
+	uint16_t crcDifference {};
+	for (auto position = first; position < last;)
+	{
+		uint8_t difference[differenceChunkSize];
+		const auto chunkSize = std::min(last - position, sizeof(difference));
+		for (size_t i {}; i < chunkSize; ++i)
+		{
+			difference[i] = patched[position + i] ^ values[position + i];
+			patched[position + i] = values[position + i];
+		}
+		crcDifference = modbusCrc16(difference, chunkSize, crcDifference);
+		position += chunkSize;
+	}
+
+	static const uint8_t zeros[differenceChunkSize] {};
+	for (auto left = frameSize - 2 - (offset + last); left != 0;)
+	{
+		const auto chunkSize = std::min(left, sizeof(zeros));
+		crcDifference = modbusCrc16(zeros, chunkSize, crcDifference);
+		left -= chunkSize;
+	}
+
+	const uint16_t crc = frame[frameSize - 2] | frame[frameSize - 1] << 8;
+	writeCrc(frame, frameSize, crc ^ crcDifference);
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool HotRangeCache::answerPdu(const uint8_t unitId, uint8_t* const pdu, size_t& pduSize, const size_t bufferSize)
+{
+	if (initialized_ == false || pduSize != requestFrameSize - rtuOverhead)
+		return false;
+
+	for (auto& entry : entriesRange_)
+	{
+		if (entry.unitId != unitId || memcmp(entry.request + 1, pdu, pduSize) != 0)
+			continue;
+
+		const auto responseSize = Entry::getFrameSize(entry.count) - rtuOverhead;
+		if (responseSize > bufferSize)
+			return false;
+
+		const std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+		memcpy(pdu, entry.frame + 1, responseSize);
+		pduSize = responseSize;
+		++hits_;
+		return true;
+	}
+
+	return false;
+}
+
+bool HotRangeCache::answerRtuFrame(uint8_t* const frame, size_t& frameSize, const size_t bufferSize)
+{
+	if (initialized_ == false || frameSize != requestFrameSize)
+		return false;
+
+	for (auto& entry : entriesRange_)
+	{
+		if (memcmp(entry.request, frame, frameSize) != 0)
+			continue;
+
+		const auto responseSize = Entry::getFrameSize(entry.count);
+		if (responseSize > bufferSize)
+			return false;
+
+		const std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+		memcpy(frame, entry.frame, responseSize);
+		frameSize = responseSize;
+		++hits_;
+		return true;
+	}
+
+	return false;
+}
+
+void HotRangeCache::initialize()
+{
+	const std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+
+	for (auto& entry : entriesRange_)
+	{
+		assert(entry.unitId != MB_ADDRESS_BROADCAST);
+		assert(entry.functionCode == MB_FUNC_READ_HOLDING_REGISTER ||
+				entry.functionCode == MB_FUNC_READ_INPUT_REGISTER);
+		assert(entry.count != 0 && entry.count <= maxCount);
+
+		entry.request[0] = entry.unitId;
+		entry.request[1] = entry.functionCode;
+		entry.request[2] = entry.address >> 8;
+		entry.request[3] = entry.address;
+		entry.request[4] = entry.count >> 8;
+		entry.request[5] = entry.count;
+		writeCrc(entry.request, sizeof(entry.request), modbusCrc16(entry.request, sizeof(entry.request) - 2));
+
+		const auto frameSize = Entry::getFrameSize(entry.count);
+		entry.frame[0] = entry.unitId;
+		entry.frame[1] = entry.functionCode;
+		entry.frame[2] = entry.count * 2;
+		memset(entry.frame + valuesOffset, 0, entry.count * 2);
+		writeCrc(entry.frame, frameSize, modbusCrc16(entry.frame, frameSize - 2));
+	}
+
+	initialized_ = true;
+}
+
+void HotRangeCache::update(const uint8_t functionCode, const uint16_t address, const uint8_t* const values,
+		const uint16_t count)
+{
+	const std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+
+	for (auto& entry : entriesRange_)
+	{
+		if (entry.functionCode != functionCode)
+			continue;
+
+		const auto begin = std::max<size_t>(entry.address, address);
+		const auto end = std::min<size_t>(entry.address + entry.count, address + count);
+		if (begin >= end)
+			continue;
+
+		patchFrame(entry.frame, Entry::getFrameSize(entry.count), valuesOffset + (begin - entry.address) * 2,
+				values + (begin - address) * 2, (end - begin) * 2);
+	}
+}
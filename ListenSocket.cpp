@@ -2,7 +2,7 @@
  * \file
  * \brief ListenSocket class implementatnion
  *
- * \author Copyright (C) 2019 Aleksander Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2019-2026 Aleksander Szczygiel https://distortec.com https://freddiechopin.info
  * \author Copyright (C) 2022 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
@@ -19,6 +19,7 @@
 #include "estd/ScopeGuard.hpp"
 
 #include <cassert>
+#include <cstring>
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | public functions
@@ -26,7 +27,7 @@
 
 int ListenSocket::bind(const uint16_t port)
 {
-	if (socket_ != -1 && port_ != port)
+	if ((socket_ != -1 && port_ != port) || (fixedPort_ != 0 && fixedPort_ != port))
 		return EBUSY;
 
 	if (socket_ == -1)
@@ -99,7 +100,20 @@ int ListenSocket::unbind()
 
 int ListenSocket::openSocket(const uint16_t port)
 {
-	const auto listenSocket = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+#if LWIP_IPV6 != 1
+
+	if (localAddress_.family != Family::ipv4)
+		return EAFNOSUPPORT;
+
+	const auto domain = AF_INET;
+
+#else	// LWIP_IPV6 == 1
+
+	const auto domain = localAddress_.family == Family::ipv4 ? AF_INET : AF_INET6;
+
+#endif	// LWIP_IPV6 == 1
+
+	const auto listenSocket = lwip_socket(domain, SOCK_STREAM, IPPROTO_TCP);
 	if (listenSocket == -1)
 		return errno;
 
@@ -114,10 +128,31 @@ int ListenSocket::openSocket(const uint16_t port)
 		if (lwip_setsockopt(listenSocket, SOL_SOCKET, SO_REUSEADDR, &optionValue, sizeof(optionValue)) == -1)
 			return errno;
 	}
+
+#if LWIP_IPV6 == 1
+
+	if (domain == AF_INET6)
+	{
+		// dual-stack socket accepts also IPv4 clients
+		const int optionValue = localAddress_.family == Family::ipv6;
+		if (lwip_setsockopt(listenSocket, IPPROTO_IPV6, IPV6_V6ONLY, &optionValue, sizeof(optionValue)) == -1)
+			return errno;
+
+		sockaddr_in6 serverAddress {};
+		serverAddress.sin6_family = AF_INET6;
+		memcpy(&serverAddress.sin6_addr, localAddress_.bytes.begin(), sizeof(serverAddress.sin6_addr));
+		serverAddress.sin6_port = htons(port);
+		if (lwip_bind(listenSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) == -1)
+			return errno;
+	}
+	else
+
+#endif	// LWIP_IPV6 == 1
+
 	{
 		sockaddr_in serverAddress {};
 		serverAddress.sin_family = AF_INET;
-		serverAddress.sin_addr.s_addr = htonl(INADDR_ANY);
+		memcpy(&serverAddress.sin_addr, localAddress_.bytes.begin(), sizeof(serverAddress.sin_addr));
 		serverAddress.sin_port = htons(port);
 		if (lwip_bind(listenSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) == -1)
 			return errno;
@@ -126,7 +161,7 @@ int ListenSocket::openSocket(const uint16_t port)
 	if (lwip_listen(listenSocket, backlogSize_) == -1)
 		return errno;
 
-	sockaddr_in serverAddress {};
+	sockaddr_storage serverAddress {};
 	socklen_t length = sizeof(serverAddress);
 	if (lwip_getsockname(listenSocket, reinterpret_cast<sockaddr*>(&serverAddress), &length) == -1)
 		return errno;
@@ -134,7 +169,8 @@ int ListenSocket::openSocket(const uint16_t port)
 	closeScopeGuard.release();
 
 	socket_ = listenSocket;
-	port_ = ntohs(serverAddress.sin_port);
+	// port is at the same offset in sockaddr_in and sockaddr_in6
+	port_ = ntohs(reinterpret_cast<const sockaddr_in&>(serverAddress).sin_port);
 	return 0;
 }
 
@@ -0,0 +1,79 @@
+/**
+ * \file
+ * \brief LocalRing class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "LocalRing.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "freemodbusMbap.hpp"
+
+#include <cerrno>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void LocalRing::complete(const size_t size)
+{
+	getRequest().size = size;
+	++handledPosition_;
+	// contents of the slot are published to the client by the semaphore
+	responseSemaphore_.post();
+}
+
+uint8_t* LocalRing::getRequestFrame() const
+{
+	if (writePosition_ - readPosition_ >= slotsRange_.size())
+		return {};
+
+	return slotsRange_[writePosition_ % slotsRange_.size()].frame;
+}
+
+void LocalRing::releaseResponse()
+{
+	++readPosition_;
+}
+
+int LocalRing::submit(const size_t size)
+{
+	const auto frame = getRequestFrame();
+	if (frame == nullptr)
+		return ENOBUFS;
+
+	if (size < FreemodbusTcpInstance::mbapHeaderSize || size > FreemodbusTcpInstance::tcpBufferSize ||
+			getMbapFrameSize(frame, size) != size)
+		return EINVAL;
+
+	slotsRange_[writePosition_ % slotsRange_.size()].size = size;
+	++writePosition_;
+	// contents of the slot are published to the port by the semaphore
+	requestSemaphore_.post();
+	return 0;
+}
+
+int LocalRing::waitRequest(const distortos::TickClock::time_point deadline)
+{
+	return requestSemaphore_.tryWaitUntil(deadline);
+}
+
+int LocalRing::waitResponse(const distortos::TickClock::time_point deadline, const uint8_t*& frame, size_t& size)
+{
+	const auto ret = responseSemaphore_.tryWaitUntil(deadline);
+	if (ret != 0)
+		return ret;
+
+	const auto& slot = slotsRange_[readPosition_ % slotsRange_.size()];
+	frame = slot.frame;
+	size = slot.size;
+	return 0;
+}
+
+#endif	// MB_TCP_ENABLED == 1
@@ -0,0 +1,226 @@
+/**
+ * \file
+ * \brief MbedtlsTransport class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "MbedtlsTransport.hpp"
+
+#if MB_TCP_ENABLED == 1 && MB_TCP_TLS_ENABLED == 1
+
+#include "FreemodbusWaitSet.hpp"
+
+#include "mbedtls/net_sockets.h"
+
+#include <cerrno>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+MbedtlsTransport::MbedtlsTransport(const mbedtls_ssl_config& configuration,
+		const distortos::TickClock::duration handshakeTimeout, const distortos::TickClock::duration sendTimeout) :
+				context_{},
+				configuration_{configuration},
+				handshakeDeadline_{distortos::TickClock::time_point::max()},
+				handshakeTimeout_{handshakeTimeout},
+				sendTimeout_{sendTimeout},
+				socket_{-1},
+				setUp_{}
+{
+	mbedtls_ssl_init(&context_);
+}
+
+MbedtlsTransport::~MbedtlsTransport()
+{
+	mbedtls_ssl_free(&context_);
+}
+
+int MbedtlsTransport::accept(const int socket)
+{
+	if (setUp_ == false)
+	{
+		if (mbedtls_ssl_setup(&context_, &configuration_) != 0)
+			return ENOMEM;
+
+		setUp_ = true;
+	}
+	else if (mbedtls_ssl_session_reset(&context_) != 0)
+		return ENOMEM;
+
+	// mbedTLS never waits for the socket, incomplete records are left for the next select() of the poll loop
+	const auto flags = lwip_fcntl(socket, F_GETFL, 0);
+	if (flags == -1 || lwip_fcntl(socket, F_SETFL, flags | O_NONBLOCK) == -1)
+		return errno;
+
+	socket_ = socket;
+	mbedtls_ssl_set_bio(&context_, this, sendCallback, receiveCallback, nullptr);
+
+	handshakeDeadline_ = distortos::TickClock::now() + handshakeTimeout_;
+	// first flight of the client is usually already received, so the handshake is started right away
+	const auto ret = handshake();
+	if (ret != 0 && ret != EAGAIN)
+	{
+		handshakeDeadline_ = distortos::TickClock::time_point::max();
+		socket_ = -1;
+		return ECONNABORTED;
+	}
+
+	return 0;
+}
+
+void MbedtlsTransport::close(int)
+{
+	if (socket_ == -1)
+		return;
+
+	// close notification is sent only if it fits in the socket, the connection is closed anyway
+	mbedtls_ssl_close_notify(&context_);
+	mbedtls_ssl_session_reset(&context_);
+	handshakeDeadline_ = distortos::TickClock::time_point::max();
+	socket_ = -1;
+}
+
+bool MbedtlsTransport::hasBufferedData() const
+{
+	return socket_ != -1 && mbedtls_ssl_get_bytes_avail(&context_) != 0;
+}
+
+ssize_t MbedtlsTransport::receive(int, void* const buffer, const size_t size)
+{
+	if (handshakeDeadline_ != distortos::TickClock::time_point::max())
+	{
+		const auto ret = handshake();
+		if (ret != 0)
+		{
+			errno = ret;
+			return -1;
+		}
+	}
+
+	const auto ret = mbedtls_ssl_read(&context_, static_cast<unsigned char*>(buffer), size);
+	if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+	{
+		errno = EAGAIN;
+		return -1;
+	}
+	if (ret == MBEDTLS_ERR_SSL_PEER_CLOSE_NOTIFY)
+		return 0;
+	// errno may still hold EAGAIN of the last read of the socket, so it is set for all other errors of mbedTLS
+	if (ret < 0)
+	{
+		errno = ECONNABORTED;
+		return -1;
+	}
+
+	return ret;
+}
+
+ssize_t MbedtlsTransport::send(int, const iovec* const iov, const int iovCount)
+{
+	const auto deadline = distortos::TickClock::now() + sendTimeout_;
+	ssize_t sent {};
+	for (int i {}; i < iovCount; ++i)
+	{
+		auto buffer = static_cast<const unsigned char*>(iov[i].iov_base);
+		auto left = iov[i].iov_len;
+		while (left != 0)
+		{
+			const auto ret = mbedtls_ssl_write(&context_, buffer, left);
+			if (ret == MBEDTLS_ERR_SSL_WANT_READ || ret == MBEDTLS_ERR_SSL_WANT_WRITE)
+			{
+				// peer which stops reading must not block the poll loop forever
+				if (waitSocket(ret, deadline) != 0)
+				{
+					errno = ETIMEDOUT;
+					return -1;
+				}
+
+				continue;
+			}
+			if (ret < 0)
+			{
+				errno = ECONNABORTED;
+				return -1;
+			}
+
+			buffer += ret;
+			left -= ret;
+			sent += ret;
+		}
+	}
+
+	return sent;
+}
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+
+void MbedtlsTransport::enableSessionCache(mbedtls_ssl_config& configuration, mbedtls_ssl_cache_context& cache)
+{
+	mbedtls_ssl_conf_session_cache(&configuration, &cache, mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
+}
+
+#endif	// defined(MBEDTLS_SSL_CACHE_C)
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int MbedtlsTransport::handshake()
+{
+	int ret;
+	// only full socket is waited for here - the client waits for this flight, so the socket drains quickly, and waiting
+	// is bounded by the deadline of the handshake anyway
+	while ((ret = mbedtls_ssl_handshake(&context_)) == MBEDTLS_ERR_SSL_WANT_WRITE &&
+			waitSocket(ret, handshakeDeadline_) == 0);
+
+	if (ret == 0)
+	{
+		handshakeDeadline_ = distortos::TickClock::time_point::max();
+		return 0;
+	}
+
+	if (ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE)
+		return ECONNABORTED;
+
+	return distortos::TickClock::now() < handshakeDeadline_ ? EAGAIN : ETIMEDOUT;
+}
+
+int MbedtlsTransport::receiveCallback(void* const context, unsigned char* const buffer, const size_t size)
+{
+	const auto& that = *static_cast<MbedtlsTransport*>(context);
+	const auto ret = lwip_recv(that.socket_, buffer, size, {});
+	if (ret < 0)
+		return errno == EAGAIN || errno == EWOULDBLOCK ? MBEDTLS_ERR_SSL_WANT_READ : MBEDTLS_ERR_NET_RECV_FAILED;
+
+	return ret;
+}
+
+int MbedtlsTransport::sendCallback(void* const context, const unsigned char* const buffer, const size_t size)
+{
+	const auto& that = *static_cast<MbedtlsTransport*>(context);
+	const auto ret = lwip_send(that.socket_, buffer, size, {});
+	if (ret < 0)
+		return errno == EAGAIN || errno == EWOULDBLOCK ? MBEDTLS_ERR_SSL_WANT_WRITE : MBEDTLS_ERR_NET_SEND_FAILED;
+
+	return ret;
+}
+
+int MbedtlsTransport::waitSocket(const int want, const distortos::TickClock::time_point deadline) const
+{
+	fd_set fdSet;
+	FD_ZERO(&fdSet);
+	FD_SET(socket_, &fdSet);
+	auto timeout = toTimeval(deadline - distortos::TickClock::now());
+	const auto ret = lwip_select(socket_ + 1, want == MBEDTLS_ERR_SSL_WANT_READ ? &fdSet : nullptr,
+			want == MBEDTLS_ERR_SSL_WANT_WRITE ? &fdSet : nullptr, nullptr,
+			deadline != distortos::TickClock::time_point::max() ? &timeout : nullptr);
+	return ret > 0 ? 0 : ETIMEDOUT;
+}
+
+#endif	// MB_TCP_ENABLED == 1 && MB_TCP_TLS_ENABLED == 1
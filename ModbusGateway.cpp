@@ -0,0 +1,649 @@
+/**
+ * \file
+ * \brief ModbusGateway class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "ModbusGateway.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "modbusAscii.hpp"
+#include "modbusCrc16.hpp"
+
+#include "mbproto.h"
+
+#include "distortos/devices/communication/SerialPort.hpp"
+#include "distortos/ThisThread.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of chunks in which Modbus ASCII frames are encoded and sent, characters
+constexpr size_t asciiChunkSize {64};
+
+/// max duration between characters of Modbus ASCII frame
+constexpr std::chrono::seconds asciiCharacterTimeout {1};
+
+/// size of address and CRC fields of Modbus RTU frame
+constexpr size_t rtuOverheadSize {3};
+
+/// size of the shortest valid Modbus RTU response frame (exception response)
+constexpr size_t minResponseFrameSize {5};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Gets the expected size of Modbus RTU response frame.
+ *
+ * \param [in] frame is a pointer to response frame, possibly incomplete
+ * \param [in] size is the number of bytes of \a frame which were already received
+ *
+ * \return expected size of complete \a frame, 0 if it cannot be determined
+ */
+
+size_t getExpectedFrameSize(const uint8_t* const frame, const size_t size)
+{
+	if (size < 2)
+		return 0;
+
+	const auto functionCode = frame[1];
+	if ((functionCode & MB_FUNC_ERROR) != 0)
+		return minResponseFrameSize;
+
+	if (functionCode == MB_FUNC_READ_COILS || functionCode == MB_FUNC_READ_DISCRETE_INPUTS ||
+			functionCode == MB_FUNC_READ_HOLDING_REGISTER || functionCode == MB_FUNC_READ_INPUT_REGISTER ||
+			functionCode == MB_FUNC_READWRITE_MULTIPLE_REGISTERS)
+		return size < 3 ? 0 : rtuOverheadSize + 2 + frame[2];
+
+	if (functionCode == MB_FUNC_WRITE_SINGLE_COIL || functionCode == MB_FUNC_WRITE_REGISTER ||
+			functionCode == MB_FUNC_WRITE_MULTIPLE_COILS || functionCode == MB_FUNC_WRITE_MULTIPLE_REGISTERS)
+		return rtuOverheadSize + 5;
+
+	return 0;
+}
+
+/**
+ * \brief Gets the number of registers read by request.
+ *
+ * \param [in] header is a pointer to request PDU of register read
+ *
+ * \return number of registers read by request
+ */
+
+uint16_t getRegisterCount(const uint8_t* const header)
+{
+	return header[3] << 8 | header[4];
+}
+
+/**
+ * \brief Gets the starting address of registers read by request.
+ *
+ * \param [in] header is a pointer to request PDU of register read
+ *
+ * \return starting address of registers read by request
+ */
+
+uint16_t getStartingAddress(const uint8_t* const header)
+{
+	return header[1] << 8 | header[2];
+}
+
+/**
+ * \brief Checks whether function code is one of the read functions whose responses can be cached.
+ *
+ * \param [in] functionCode is the checked function code
+ *
+ * \return true if \a functionCode is one of the read functions, false otherwise
+ */
+
+bool isReadFunction(const uint8_t functionCode)
+{
+	return functionCode == MB_FUNC_READ_COILS || functionCode == MB_FUNC_READ_DISCRETE_INPUTS ||
+			functionCode == MB_FUNC_READ_HOLDING_REGISTER || functionCode == MB_FUNC_READ_INPUT_REGISTER;
+}
+
+/**
+ * \brief Checks whether function code is one of the register read functions which can be coalesced.
+ *
+ * \param [in] functionCode is the checked function code
+ *
+ * \return true if \a functionCode is one of the register read functions, false otherwise
+ */
+
+bool isRegisterReadFunction(const uint8_t functionCode)
+{
+	return functionCode == MB_FUNC_READ_HOLDING_REGISTER || functionCode == MB_FUNC_READ_INPUT_REGISTER;
+}
+
+/**
+ * \brief Replaces request PDU with exception response PDU.
+ *
+ * \param [in,out] pdu is a pointer to buffer with request PDU, exception response PDU is written here
+ * \param [in] exception is the exception code
+ *
+ * \return size of exception response PDU, bytes
+ */
+
+size_t makeExceptionResponse(uint8_t* const pdu, const eMBException exception)
+{
+	pdu[0] |= MB_FUNC_ERROR;
+	pdu[1] = exception;
+	return 2;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int ModbusGateway::close()
+{
+	std::unique_lock<distortos::Mutex> uniqueLock {mutex_};
+
+	if (opened_ == false)
+		return EBADF;
+
+	opened_ = false;
+
+	while (busy_ == true)
+		conditionVariable_.wait(mutex_);
+
+	return serialPort_.close();
+}
+
+int ModbusGateway::open(const uint32_t baudRate, const uint8_t characterLength,
+		const distortos::devices::UartParity parity, const Mode mode)
+{
+	assert(baudRate != 0);
+
+	std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+
+	if (opened_ == true)
+		return EBADF;
+
+	const auto ret = serialPort_.open(baudRate, characterLength, parity, false);
+	if (ret != 0)
+		return ret;
+
+	// frames of Modbus ASCII are delimited by characters, so no silence between them is required
+	frameDelay_ = {};
+	if (mode == Mode::rtu)
+	{
+		// above 19200 bps T3.5 is fixed, otherwise it is the duration of 3.5 characters, 11 bits each
+		const auto frameDelay = baudRate > 19200 ? std::chrono::microseconds{1750} :
+				std::chrono::microseconds{7 * 11 * 1000000 / (2 * baudRate)};
+		frameDelay_ = std::chrono::duration_cast<decltype(frameDelay_)>(frameDelay);
+		if (frameDelay_ < frameDelay)
+			++frameDelay_;
+		// deadline may expire up to one tick too early, so one more tick is required to guarantee the silence
+		++frameDelay_;
+	}
+
+	mode_ = mode;
+	lastActivity_ = distortos::TickClock::now();
+	opened_ = true;
+	return 0;
+}
+
+size_t ModbusGateway::transact(const uint8_t unitId, uint8_t* const pdu, const size_t pduSize, const size_t bufferSize)
+{
+	assert(pdu != nullptr);
+	assert(pduSize >= 1 && pduSize <= maxPduSize);
+	assert(bufferSize >= 2);
+
+	Request request {};
+	request.pdu = pdu;
+	memcpy(request.header, pdu, std::min(pduSize, sizeof(request.header)));
+	request.bufferSize = bufferSize;
+	request.requestSize = pduSize;
+	request.unitId = unitId;
+
+	std::unique_lock<distortos::Mutex> uniqueLock {mutex_};
+
+	if (opened_ == false)
+		return makeExceptionResponse(pdu, MB_EX_GATEWAY_PATH_FAILED);
+
+	if (findInCache(request) == true)
+		return request.responseSize;
+
+	if (queueTail_ != nullptr)
+		queueTail_->next = &request;
+	else
+		queueHead_ = &request;
+	queueTail_ = &request;
+
+	// request may also be completed by other request with which it was coalesced
+	while (request.done == false && (busy_ == true || queueHead_ != &request))
+		conditionVariable_.wait(mutex_);
+
+	if (request.done == true)
+		return request.responseSize;
+
+	queueHead_ = request.next;
+	if (queueHead_ == nullptr)
+		queueTail_ = nullptr;
+	request.next = {};
+
+	// identical request executed while this one was waiting in the queue may have already filled the cache
+	if (opened_ == false)
+		request.responseSize = makeExceptionResponse(pdu, MB_EX_GATEWAY_PATH_FAILED);
+	else if (findInCache(request) == false)
+	{
+		busy_ = true;
+		const auto coalesced = coalesce(request);
+		uniqueLock.unlock();
+		if (coalesced == true)
+			executeCoalesced(request);
+		else
+			execute(request);
+		uniqueLock.lock();
+		busy_ = false;
+
+		// coalesced requests cannot return before the mutex is unlocked, so their list is still valid
+		for (auto coalescedRequest = &request; coalescedRequest != nullptr; coalescedRequest = coalescedRequest->next)
+		{
+			updateCache(*coalescedRequest);
+			coalescedRequest->done = true;
+		}
+	}
+
+	conditionVariable_.notifyAll();
+	return request.responseSize;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool ModbusGateway::coalesce(Request& request)
+{
+	const auto canBeCoalesced = [](const Request& checkedRequest) -> bool
+			{
+				const auto registerCount = getRegisterCount(checkedRequest.header);
+				return checkedRequest.unitId != 0 && checkedRequest.requestSize == cachedRequestSize &&
+						isRegisterReadFunction(checkedRequest.header[0]) == true && registerCount != 0 &&
+						registerCount <= maxCoalescedRegisters && 2u + registerCount * 2u <= checkedRequest.bufferSize;
+			};
+
+	if (canBeCoalesced(request) == false)
+		return false;
+
+	// range of coalesced registers, end is exclusive
+	uint32_t begin {getStartingAddress(request.header)};
+	uint32_t end {begin + getRegisterCount(request.header)};
+	auto last = &request;
+
+	// each extension of the range may allow coalescing requests which were already checked, so repeat until no change
+	auto changed = true;
+	while (changed == true)
+	{
+		changed = false;
+		Request* previous {};
+		for (auto checkedRequest = queueHead_; checkedRequest != nullptr;)
+		{
+			const auto next = checkedRequest->next;
+			const uint32_t checkedBegin {getStartingAddress(checkedRequest->header)};
+			const uint32_t checkedEnd {checkedBegin + getRegisterCount(checkedRequest->header)};
+			const auto newBegin = std::min(begin, checkedBegin);
+			const auto newEnd = std::max(end, checkedEnd);
+			// overlapping or adjacent ranges of the same function and slave
+			if (canBeCoalesced(*checkedRequest) == true && checkedRequest->unitId == request.unitId &&
+					checkedRequest->header[0] == request.header[0] && checkedBegin <= end && checkedEnd >= begin &&
+					newEnd - newBegin <= maxCoalescedRegisters)
+			{
+				(previous != nullptr ? previous->next : queueHead_) = next;
+				if (queueTail_ == checkedRequest)
+					queueTail_ = previous;
+
+				checkedRequest->next = {};
+				last->next = checkedRequest;
+				last = checkedRequest;
+				begin = newBegin;
+				end = newEnd;
+				changed = true;
+			}
+			else
+				previous = checkedRequest;
+
+			checkedRequest = next;
+		}
+	}
+
+	return last != &request;
+}
+
+void ModbusGateway::execute(Request& request)
+{
+	size_t frameSize {};
+	frameBuffer_[frameSize++] = request.unitId;
+	memcpy(&frameBuffer_[frameSize], request.pdu, request.requestSize);
+	frameSize += request.requestSize;
+	if (mode_ == Mode::rtu)
+	{
+		const auto crc = modbusCrc16(frameBuffer_, frameSize);
+		frameBuffer_[frameSize++] = crc;
+		frameBuffer_[frameSize++] = crc >> 8;
+	}
+
+	distortos::ThisThread::sleepUntil(lastActivity_ + frameDelay_);
+
+	{
+		const auto ret = mode_ == Mode::ascii ? writeAsciiFrame(frameSize) :
+				serialPort_.write(frameBuffer_, frameSize).first;
+		lastActivity_ = distortos::TickClock::now();
+		if (ret != 0)
+		{
+			request.responseSize = makeExceptionResponse(request.pdu, MB_EX_GATEWAY_PATH_FAILED);
+			return;
+		}
+	}
+
+	// broadcast requests are never answered
+	if (request.unitId == 0)
+	{
+		request.responseSize = {};
+		return;
+	}
+
+	const auto responseDeadline = lastActivity_ + responseTimeout_;
+	if (mode_ == Mode::ascii)
+	{
+		// frames of other slaves are dropped, waiting continues until the response deadline
+		while ((frameSize = readAsciiFrame(responseDeadline)) != 0)
+			if (frameBuffer_[0] == request.unitId && (frameBuffer_[1] & ~MB_FUNC_ERROR) == request.header[0] &&
+					frameSize - 1 <= request.bufferSize)
+			{
+				request.responseSize = frameSize - 1;
+				memcpy(request.pdu, &frameBuffer_[1], request.responseSize);
+				return;
+			}
+
+		request.responseSize = makeExceptionResponse(request.pdu, MB_EX_GATEWAY_TGT_FAILED);
+		return;
+	}
+
+	size_t received {};
+	while (1)
+	{
+		const auto deadline = received == 0 ? responseDeadline : lastActivity_ + frameDelay_;
+		const auto ret = serialPort_.tryReadUntil(deadline, &frameBuffer_[received], sizeof(frameBuffer_) - received);
+		if (ret.second != 0)
+		{
+			received += ret.second;
+			lastActivity_ = distortos::TickClock::now();
+		}
+		else if (received == 0)
+			break;	// response timeout
+
+		const auto expectedSize = getExpectedFrameSize(frameBuffer_, received);
+		const auto complete = ret.second == 0 || (expectedSize != 0 && received >= expectedSize) ||
+				received == sizeof(frameBuffer_);
+		if (complete == false)
+			continue;
+
+		frameSize = expectedSize != 0 ? std::min(expectedSize, received) : received;
+		if (frameSize >= minResponseFrameSize && modbusCrc16(frameBuffer_, frameSize) == 0 &&
+				frameBuffer_[0] == request.unitId && (frameBuffer_[1] & ~MB_FUNC_ERROR) == request.header[0] &&
+				frameSize - rtuOverheadSize <= request.bufferSize)
+		{
+			request.responseSize = frameSize - rtuOverheadSize;
+			memcpy(request.pdu, &frameBuffer_[1], request.responseSize);
+			return;
+		}
+
+		// corrupted frame or frame of other slave - drop it and keep waiting for the response
+		received = {};
+		if (distortos::TickClock::now() >= responseDeadline)
+			break;
+	}
+
+	request.responseSize = makeExceptionResponse(request.pdu, MB_EX_GATEWAY_TGT_FAILED);
+}
+
+void ModbusGateway::executeCoalesced(Request& request)
+{
+	auto begin = getStartingAddress(request.header);
+	auto end = begin + getRegisterCount(request.header);
+	for (auto coalescedRequest = request.next; coalescedRequest != nullptr; coalescedRequest = coalescedRequest->next)
+	{
+		const auto coalescedBegin = getStartingAddress(coalescedRequest->header);
+		begin = std::min(begin, coalescedBegin);
+		end = std::max(end, coalescedBegin + getRegisterCount(coalescedRequest->header));
+	}
+
+	const auto registerCount = end - begin;
+	Request wideRequest {};
+	wideRequest.pdu = coalescedPdu_;
+	wideRequest.header[0] = request.header[0];
+	wideRequest.header[1] = begin >> 8;
+	wideRequest.header[2] = begin;
+	wideRequest.header[3] = registerCount >> 8;
+	wideRequest.header[4] = registerCount;
+	memcpy(coalescedPdu_, wideRequest.header, sizeof(wideRequest.header));
+	wideRequest.bufferSize = sizeof(coalescedPdu_);
+	wideRequest.requestSize = cachedRequestSize;
+	wideRequest.unitId = request.unitId;
+	execute(wideRequest);
+
+	const auto valid = wideRequest.responseSize == 2u + registerCount * 2u && coalescedPdu_[0] == request.header[0] &&
+			coalescedPdu_[1] == registerCount * 2u;
+	for (auto coalescedRequest = &request; coalescedRequest != nullptr; coalescedRequest = coalescedRequest->next)
+	{
+		if (valid == false)
+		{
+			execute(*coalescedRequest);
+			continue;
+		}
+
+		const auto offset = (getStartingAddress(coalescedRequest->header) - begin) * 2u;
+		const auto size = getRegisterCount(coalescedRequest->header) * 2u;
+		coalescedRequest->pdu[0] = coalescedRequest->header[0];
+		coalescedRequest->pdu[1] = size;
+		memcpy(&coalescedRequest->pdu[2], &coalescedPdu_[2 + offset], size);
+		coalescedRequest->responseSize = 2 + size;
+	}
+}
+
+bool ModbusGateway::findInCache(Request& request) const
+{
+	if (request.requestSize != cachedRequestSize || isReadFunction(request.header[0]) == false)
+		return false;
+
+	const auto now = distortos::TickClock::now();
+	for (auto& entry : cacheRange_)
+		if (entry.responseSize != 0 && entry.responseSize <= request.bufferSize && entry.unitId == request.unitId &&
+				now - entry.timestamp < cacheLifetime_ &&
+				memcmp(entry.request, request.header, sizeof(entry.request)) == 0)
+		{
+			memcpy(request.pdu, entry.response, entry.responseSize);
+			request.responseSize = entry.responseSize;
+			return true;
+		}
+
+	return false;
+}
+
+size_t ModbusGateway::readAsciiFrame(const distortos::TickClock::time_point responseDeadline)
+{
+	// characters are received after already decoded bytes and decoded in place, as each byte takes half of their space
+	size_t decoded {};
+	size_t pending {};
+	uint8_t sum {};
+	auto started = false;
+	while (1)
+	{
+		// frame which does not fit in the buffer is dropped
+		if (decoded + pending == sizeof(frameBuffer_))
+		{
+			decoded = {};
+			pending = {};
+			started = false;
+		}
+
+		const auto deadline = started == false ? responseDeadline : lastActivity_ + asciiCharacterTimeout;
+		const auto ret = serialPort_.tryReadUntil(deadline, &frameBuffer_[decoded + pending],
+				sizeof(frameBuffer_) - decoded - pending);
+		if (ret.second == 0)
+		{
+			if (started == false || distortos::TickClock::now() >= responseDeadline)
+				return {};
+
+			// incomplete frame is dropped, waiting for the next one continues until the response deadline
+			decoded = {};
+			pending = {};
+			started = false;
+			continue;
+		}
+
+		lastActivity_ = distortos::TickClock::now();
+		pending += ret.second;
+
+		while (pending != 0)
+		{
+			const auto characters = reinterpret_cast<char*>(&frameBuffer_[decoded]);
+			if (started == false)
+			{
+				// everything before start of the frame is ignored
+				const auto colon = static_cast<char*>(memchr(characters, ':', pending));
+				if (colon == nullptr)
+				{
+					pending = {};
+					break;
+				}
+
+				pending -= colon + 1 - characters;
+				memmove(characters, colon + 1, pending);
+				sum = {};
+				started = true;
+				continue;
+			}
+
+			size_t hexCharacters {};
+			while (hexCharacters < pending && characters[hexCharacters] != ':' && characters[hexCharacters] != '\r' &&
+					characters[hexCharacters] != '\n')
+				++hexCharacters;
+
+			const auto size = hexCharacters / 2;
+			const auto terminated = hexCharacters != pending;
+			if (modbusAsciiDecode(characters, size, &frameBuffer_[decoded], sum) != 0 ||
+					(terminated == true && hexCharacters % 2 != 0))
+			{
+				// frame with invalid characters is dropped together with everything received so far
+				decoded = {};
+				pending = {};
+				started = false;
+				break;
+			}
+
+			decoded += size;
+			pending -= size * 2;
+			memmove(&frameBuffer_[decoded], characters + size * 2, pending);
+			if (terminated == false)
+				break;
+
+			// CR or LF ends the frame, which is valid if it contains at least address, function code and correct LRC
+			if (frameBuffer_[decoded] != ':' && decoded >= 3 && sum == 0)
+				return decoded - 1;
+
+			// restarted, too short or corrupted frame is dropped, remaining characters are searched for next frame
+			memmove(frameBuffer_, &frameBuffer_[decoded], pending);
+			decoded = {};
+			started = false;
+		}
+	}
+}
+
+void ModbusGateway::updateCache(const Request& request)
+{
+	if (cacheRange_.size() == 0 || cacheLifetime_ <= decltype(cacheLifetime_)::zero())
+		return;
+
+	if (isReadFunction(request.header[0]) == false)
+	{
+		// any other function may modify data of the slave, so all cached responses of this slave are invalidated
+		for (auto& entry : cacheRange_)
+			if (request.unitId == 0 || entry.unitId == request.unitId)
+				entry.responseSize = {};
+
+		return;
+	}
+
+	if (request.requestSize != cachedRequestSize || request.responseSize == 0 ||
+			request.responseSize > sizeof(CacheEntry::response) || (request.pdu[0] & MB_FUNC_ERROR) != 0)
+		return;
+
+	// reuse entry with the same request, otherwise take empty or the oldest one
+	auto chosenEntry = cacheRange_.begin();
+	for (auto& entry : cacheRange_)
+	{
+		if (entry.responseSize != 0 && entry.unitId == request.unitId &&
+				memcmp(entry.request, request.header, sizeof(entry.request)) == 0)
+		{
+			chosenEntry = &entry;
+			break;
+		}
+
+		if (chosenEntry->responseSize != 0 && (entry.responseSize == 0 || entry.timestamp < chosenEntry->timestamp))
+			chosenEntry = &entry;
+	}
+
+	chosenEntry->timestamp = distortos::TickClock::now();
+	chosenEntry->responseSize = request.responseSize;
+	chosenEntry->unitId = request.unitId;
+	memcpy(chosenEntry->request, request.header, sizeof(chosenEntry->request));
+	memcpy(chosenEntry->response, request.pdu, request.responseSize);
+}
+
+int ModbusGateway::writeAsciiFrame(const size_t frameSize)
+{
+	// frame is encoded and sent in chunks, so no buffer for complete Modbus ASCII frame is needed
+	char chunk[asciiChunkSize];
+	size_t chunkSize {};
+	chunk[chunkSize++] = ':';
+	uint8_t sum {};
+	size_t encoded {};
+	while (1)
+	{
+		const auto size = std::min((sizeof(chunk) - chunkSize) / 2, frameSize - encoded);
+		sum = modbusAsciiEncode(&frameBuffer_[encoded], size, &chunk[chunkSize], sum);
+		encoded += size;
+		chunkSize += size * 2;
+		// LRC, CR and LF must fit in the last chunk
+		if (encoded == frameSize && sizeof(chunk) - chunkSize >= 4)
+			break;
+
+		const auto ret = serialPort_.write(chunk, chunkSize);
+		if (ret.first != 0)
+			return ret.first;
+
+		chunkSize = {};
+	}
+
+	const uint8_t lrc = -sum;
+	modbusAsciiEncode(&lrc, 1, &chunk[chunkSize]);
+	chunkSize += 2;
+	chunk[chunkSize++] = '\r';
+	chunk[chunkSize++] = '\n';
+	return serialPort_.write(chunk, chunkSize).first;
+}
+
+#endif	// MB_TCP_ENABLED == 1
@@ -0,0 +1,369 @@
+/**
+ * \file
+ * \brief ModbusTcpMaster class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "ModbusTcpMaster.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "freemodbusMbap.hpp"
+
+#include "lwip/sockets.h"
+
+#include "distortos/ThisThread.hpp"
+
+#include "estd/ScopeGuard.hpp"
+
+#include <algorithm>
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// index of high byte of protocol identifier in MBAP header
+constexpr size_t protocolIdentifierHigh {2};
+
+/// index of low byte of protocol identifier in MBAP header
+constexpr size_t protocolIdentifierLow {protocolIdentifierHigh + 1};
+
+/// index of high byte of transaction identifier in MBAP header
+constexpr size_t transactionIdentifierHigh {0};
+
+/// index of low byte of transaction identifier in MBAP header
+constexpr size_t transactionIdentifierLow {transactionIdentifierHigh + 1};
+
+/// index of unit identifier in MBAP header
+constexpr size_t unitIdentifier {frameLengthLow + 1};
+
+/// max size of PDU
+constexpr size_t maxPduSize {MB_SER_SIZE_MAX - 3};
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int ModbusTcpMaster::connect(const uint32_t address, const uint16_t port, const distortos::TickClock::duration timeout)
+{
+	if (state_ != State::disconnected)
+		return EISCONN;
+
+	const auto clientSocket = lwip_socket(AF_INET, SOCK_STREAM, IPPROTO_TCP);
+	if (clientSocket == -1)
+		return errno;
+
+	auto closeScopeGuard = estd::makeScopeGuard(
+			[clientSocket]()
+			{
+				lwip_close(clientSocket);
+			});
+
+	{
+		// requests are short and their latency matters, so they should not be delayed by Nagle's algorithm
+		const int optionValue = 1;
+		if (lwip_setsockopt(clientSocket, IPPROTO_TCP, TCP_NODELAY, &optionValue, sizeof(optionValue)) == -1)
+			return errno;
+	}
+	{
+		const auto flags = lwip_fcntl(clientSocket, F_GETFL, 0);
+		if (flags == -1 || lwip_fcntl(clientSocket, F_SETFL, flags | O_NONBLOCK) == -1)
+			return errno;
+	}
+	{
+		sockaddr_in serverAddress {};
+		serverAddress.sin_family = AF_INET;
+		serverAddress.sin_addr.s_addr = htonl(address);
+		serverAddress.sin_port = htons(port);
+		if (lwip_connect(clientSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) == -1 &&
+				errno != EINPROGRESS)
+			return errno;
+	}
+
+	closeScopeGuard.release();
+
+	connectDeadline_ = distortos::TickClock::now() + timeout;
+	bytesInBuffer_ = {};
+	bytesToSend_ = {};
+	socket_ = clientSocket;
+	state_ = State::connecting;
+	return 0;
+}
+
+void ModbusTcpMaster::disconnect()
+{
+	closeConnection(ECONNABORTED);
+}
+
+distortos::TickClock::time_point ModbusTcpMaster::getDeadline() const
+{
+	auto deadline = state_ == State::connecting ? connectDeadline_ : distortos::TickClock::time_point::max();
+	for (auto& transaction : transactionsRange_)
+		if (transaction.callback != nullptr)
+			deadline = std::min(deadline, transaction.deadline);
+
+	return deadline;
+}
+
+int ModbusTcpMaster::startTransaction(const uint8_t unitId, const uint8_t* const pdu, const size_t pduSize,
+		const distortos::TickClock::duration timeout, Callback& callback, void* const context)
+{
+	assert(pdu != nullptr);
+
+	if (state_ != State::connected)
+		return ENOTCONN;
+
+	if (pduSize == 0 || pduSize > maxPduSize)
+		return EINVAL;
+
+	const auto frameSize = FreemodbusTcpInstance::mbapHeaderSize + pduSize;
+	if (bytesToSend_ + frameSize > sizeof(txBuffer_))
+		return EAGAIN;
+
+	const auto freeTransaction = std::find_if(transactionsRange_.begin(), transactionsRange_.end(),
+			[](const Transaction& transaction) -> bool
+			{
+				return transaction.callback == nullptr;
+			});
+	if (freeTransaction == transactionsRange_.end())
+		return EAGAIN;
+
+	// skip identifiers which are still used by outstanding transactions
+	uint16_t transactionId;
+	do
+	{
+		transactionId = nextTransactionId_++;
+	} while (std::find_if(transactionsRange_.begin(), transactionsRange_.end(),
+			[transactionId](const Transaction& transaction) -> bool
+			{
+				return transaction.callback != nullptr && transaction.transactionId == transactionId;
+			}) != transactionsRange_.end());
+
+	// request is queued after unsent part of previous ones
+	const auto frame = &txBuffer_[bytesToSend_];
+	const auto length = pduSize + 1;
+	frame[transactionIdentifierHigh] = transactionId >> 8;
+	frame[transactionIdentifierLow] = transactionId;
+	frame[protocolIdentifierHigh] = {};
+	frame[protocolIdentifierLow] = {};
+	frame[frameLengthHigh] = length >> 8;
+	frame[frameLengthLow] = length;
+	frame[unitIdentifier] = unitId;
+	memcpy(&frame[FreemodbusTcpInstance::mbapHeaderSize], pdu, pduSize);
+	bytesToSend_ += frameSize;
+
+	const auto ret = sendQueued();
+	if (ret != 0)
+	{
+		closeConnection(ret);
+		return ret;
+	}
+
+	freeTransaction->deadline = distortos::TickClock::now() + timeout;
+	freeTransaction->callback = &callback;
+	freeTransaction->context = context;
+	freeTransaction->transactionId = transactionId;
+	return 0;
+}
+
+void ModbusTcpMaster::poll(const Range range, const distortos::TickClock::time_point deadline)
+{
+	fd_set readFdSet;
+	FD_ZERO(&readFdSet);
+	fd_set writeFdSet;
+	FD_ZERO(&writeFdSet);
+	int maxSocket {-1};
+	auto selectDeadline = deadline;
+	for (const auto master : range)
+	{
+		selectDeadline = std::min(selectDeadline, master->getDeadline());
+		if (master->socket_ == -1)
+			continue;
+
+		// establishing of connection is finished when the socket becomes writable, queued requests are sent when there
+		// is space in send buffer of the socket
+		if (master->state_ == State::connecting || master->bytesToSend_ != 0)
+			FD_SET(master->socket_, &writeFdSet);
+		if (master->state_ == State::connected)
+			FD_SET(master->socket_, &readFdSet);
+		maxSocket = std::max(maxSocket, master->socket_);
+	}
+
+	int ret {};
+	if (maxSocket == -1)
+		distortos::ThisThread::sleepUntil(selectDeadline);
+	else
+	{
+		const auto left = std::max(selectDeadline - distortos::TickClock::now(), distortos::TickClock::duration{});
+		const auto leftSeconds = std::chrono::duration_cast<std::chrono::seconds>(left);
+		const auto leftMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(left - leftSeconds);
+		timeval timeout {};
+		timeout.tv_sec = leftSeconds.count();
+		timeout.tv_usec = leftMicroseconds.count();
+		ret = lwip_select(maxSocket + 1, &readFdSet, &writeFdSet, nullptr, &timeout);
+	}
+
+	for (const auto master : range)
+	{
+		if (ret > 0 && master->socket_ != -1)
+		{
+			if (master->state_ == State::connecting && FD_ISSET(master->socket_, &writeFdSet) != 0)
+				master->handleConnected();
+			else if (master->state_ == State::connected)
+			{
+				if (FD_ISSET(master->socket_, &writeFdSet) != 0)
+					master->handleSend();
+				if (master->state_ == State::connected && FD_ISSET(master->socket_, &readFdSet) != 0)
+					master->handleReceive();
+			}
+		}
+
+		master->handleDeadlines();
+	}
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void ModbusTcpMaster::closeConnection(const int error)
+{
+	if (socket_ != -1)
+	{
+		lwip_close(socket_);
+		socket_ = -1;
+	}
+
+	bytesInBuffer_ = {};
+	bytesToSend_ = {};
+	state_ = State::disconnected;
+
+	for (auto& transaction : transactionsRange_)
+		if (transaction.callback != nullptr)
+		{
+			const auto callback = transaction.callback;
+			transaction.callback = {};
+			callback(transaction.context, error, nullptr, 0);
+		}
+}
+
+void ModbusTcpMaster::handleConnected()
+{
+	int error {};
+	socklen_t length = sizeof(error);
+	if (lwip_getsockopt(socket_, SOL_SOCKET, SO_ERROR, &error, &length) == -1)
+		error = errno;
+
+	if (error != 0)
+	{
+		closeConnection(error);
+		return;
+	}
+
+	state_ = State::connected;
+}
+
+void ModbusTcpMaster::handleDeadlines()
+{
+	const auto now = distortos::TickClock::now();
+	if (state_ == State::connecting && connectDeadline_ <= now)
+		closeConnection(ETIMEDOUT);
+
+	// late response to expired transaction will not match any outstanding transaction, so it will be ignored
+	for (auto& transaction : transactionsRange_)
+		if (transaction.callback != nullptr && transaction.deadline <= now)
+		{
+			const auto callback = transaction.callback;
+			transaction.callback = {};
+			callback(transaction.context, ETIMEDOUT, nullptr, 0);
+		}
+}
+
+void ModbusTcpMaster::handleReceive()
+{
+	// callback may close or reopen the connection
+	while (state_ == State::connected)
+	{
+		const auto totalSize = getMbapFrameSize(frameBuffer_, bytesInBuffer_);
+		// length field covers at least unit identifier and function code
+		if (totalSize > sizeof(frameBuffer_) || (bytesInBuffer_ >= FreemodbusTcpInstance::mbapHeaderSize - 1 &&
+				totalSize < FreemodbusTcpInstance::mbapHeaderSize + 1))
+		{
+			closeConnection(EPROTO);
+			return;
+		}
+
+		const auto ret = lwip_recv(socket_, &frameBuffer_[bytesInBuffer_], totalSize - bytesInBuffer_, MSG_DONTWAIT);
+		if (ret == -1 && (errno == EWOULDBLOCK || errno == EAGAIN))
+			return;
+		if (ret <= 0)
+		{
+			closeConnection(ret == 0 ? ECONNRESET : errno);
+			return;
+		}
+
+		bytesInBuffer_ += ret;
+		if (totalSize > FreemodbusTcpInstance::mbapHeaderSize && bytesInBuffer_ == totalSize)
+		{
+			bytesInBuffer_ = {};
+			handleResponse(totalSize);
+		}
+	}
+}
+
+void ModbusTcpMaster::handleResponse(const size_t frameSize)
+{
+	if (frameBuffer_[protocolIdentifierHigh] != 0 || frameBuffer_[protocolIdentifierLow] != 0)
+		return;
+
+	const uint16_t transactionId = (frameBuffer_[transactionIdentifierHigh] << 8) |
+			frameBuffer_[transactionIdentifierLow];
+	for (auto& transaction : transactionsRange_)
+		if (transaction.callback != nullptr && transaction.transactionId == transactionId)
+		{
+			const auto callback = transaction.callback;
+			transaction.callback = {};
+			callback(transaction.context, 0, &frameBuffer_[FreemodbusTcpInstance::mbapHeaderSize],
+					frameSize - FreemodbusTcpInstance::mbapHeaderSize);
+			return;
+		}
+}
+
+void ModbusTcpMaster::handleSend()
+{
+	const auto ret = sendQueued();
+	if (ret != 0)
+		closeConnection(ret);
+}
+
+int ModbusTcpMaster::sendQueued()
+{
+	while (bytesToSend_ != 0)
+	{
+		const auto ret = lwip_send(socket_, txBuffer_, bytesToSend_, MSG_DONTWAIT);
+		if (ret == -1 && (errno == EWOULDBLOCK || errno == EAGAIN))
+			return 0;
+		if (ret <= 0)
+			return ret == 0 ? EIO : errno;
+
+		bytesToSend_ -= ret;
+		memmove(txBuffer_, &txBuffer_[ret], bytesToSend_);
+	}
+
+	return 0;
+}
+
+#endif	// MB_TCP_ENABLED == 1
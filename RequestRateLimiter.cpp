@@ -0,0 +1,150 @@
+/**
+ * \file
+ * \brief RequestRateLimiter class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "RequestRateLimiter.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include <cerrno>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Calculates earliest time point at which token bucket admits next request.
+ *
+ * \param [in] theoreticalArrival is the theoretical arrival time of next request of the bucket
+ * \param [in] interval is the interval between requests at sustained rate
+ * \param [in] burst is the max number of requests which may be admitted back-to-back
+ * \param [in] now is the current time point
+ *
+ * \return earliest time point at which next request is admitted, not earlier than \a now
+ */
+
+RequestRateLimiter::TimePoint getEarliestAdmission(const RequestRateLimiter::TimePoint theoreticalArrival,
+		const std::chrono::nanoseconds interval, const uint16_t burst, const RequestRateLimiter::TimePoint now)
+{
+	return std::max(theoreticalArrival - interval * (std::max(burst, uint16_t{1}) - 1), now);
+}
+
+/**
+ * \param [in] rate is the sustained rate, requests per second, must not be 0
+ *
+ * \return interval between requests at sustained \a rate
+ */
+
+std::chrono::nanoseconds getInterval(const uint32_t rate)
+{
+	return std::chrono::nanoseconds{1000000000 / rate};
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int RequestRateLimiter::admit(const uint32_t address, const uint16_t port, const uint8_t unitId,
+		distortos::TickClock::time_point& admissionTime)
+{
+	const TimePoint now {distortos::TickClock::now()};
+	const std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+
+	const auto rule = std::find_if(rulesRange_.begin(), rulesRange_.end(),
+			[address, unitId](const Rule& checkedRule) -> bool
+			{
+				return ((address ^ checkedRule.address) & checkedRule.mask) == 0 &&
+						(checkedRule.unitId == anyUnitId || checkedRule.unitId == unitId);
+			});
+	const auto matched = rule != rulesRange_.end();
+	auto& counters = matched == true ? rule->counters : unmatchedCounters_;
+
+	Bucket* bucket {};
+	auto admission = now;
+	if (matched == true && rule->rate != 0)
+	{
+		const uint8_t ruleIndex = rule - rulesRange_.begin();
+		for (auto& checkedBucket : bucketsRange_)
+		{
+			if (checkedBucket.used == true && checkedBucket.address == address && checkedBucket.port == port &&
+					checkedBucket.rule == ruleIndex)
+			{
+				bucket = &checkedBucket;
+				break;
+			}
+
+			// bucket which is closest to being full is taken over, full bucket is the same as the new one
+			if (bucket == nullptr || checkedBucket.used == false ||
+					(bucket->used == true && checkedBucket.theoreticalArrival < bucket->theoreticalArrival))
+				bucket = &checkedBucket;
+		}
+
+		if (bucket != nullptr)
+		{
+			if (bucket->used == false || bucket->address != address || bucket->port != port ||
+					bucket->rule != ruleIndex)
+			{
+				bucket->theoreticalArrival = {};
+				bucket->address = address;
+				bucket->port = port;
+				bucket->rule = ruleIndex;
+				bucket->used = true;
+			}
+
+			admission = getEarliestAdmission(bucket->theoreticalArrival, getInterval(rule->rate), rule->burst, now);
+		}
+	}
+
+	if (capacity_ != 0)
+	{
+		const uint32_t reserved = (matched == true ? rule->priority : unmatchedPriority) * reservePerPriority_;
+		const uint16_t burst = reserved < capacityBurst_ ? capacityBurst_ - reserved : 1;
+		admission = std::max(admission, getEarliestAdmission(capacityTheoreticalArrival_, getInterval(capacity_),
+				burst, now));
+	}
+
+	if (admission > now && (matched == false || rule->action == Action::reject || admission - now > rule->maxDelay))
+	{
+		++counters.rejected;
+		return EBUSY;
+	}
+
+	if (bucket != nullptr)
+		bucket->theoreticalArrival = std::max(bucket->theoreticalArrival, admission) + getInterval(rule->rate);
+	if (capacity_ != 0)
+		capacityTheoreticalArrival_ = std::max(capacityTheoreticalArrival_, admission) + getInterval(capacity_);
+
+	if (admission > now)
+		++counters.delayed;
+	else
+		++counters.admitted;
+
+	const auto tick = std::chrono::time_point_cast<distortos::TickClock::duration>(admission);
+	admissionTime = tick < admission ? tick + distortos::TickClock::duration{1} : tick;
+	return 0;
+}
+
+RequestRateLimiter::Counters RequestRateLimiter::getCounters(const size_t rule) const
+{
+	const std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+	return rulesRange_[rule].counters;
+}
+
+RequestRateLimiter::Counters RequestRateLimiter::getUnmatchedCounters() const
+{
+	const std::lock_guard<distortos::Mutex> lockGuard {mutex_};
+	return unmatchedCounters_;
+}
@@ -0,0 +1,65 @@
+/**
+ * \file
+ * \brief WriteNotificationQueue class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "WriteNotificationQueue.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void WriteNotificationQueue::publish()
+{
+	const auto writePosition = writePosition_.load(std::memory_order_acquire);
+	auto publishedPosition = publishedPosition_.load(std::memory_order_relaxed);
+	do
+	{
+		// published position never goes back, even if concurrent publish() saw more notifications
+		if (writePosition - publishedPosition - 1 >= storageRange_.size())
+			return;
+	} while (publishedPosition_.compare_exchange_weak(publishedPosition, writePosition, std::memory_order_release,
+			std::memory_order_relaxed) == false);
+
+	semaphore_.post();	// EOVERFLOW is expected if the consumer was not woken since previous publish
+}
+
+bool WriteNotificationQueue::push(const Type type, const uint16_t address, const uint16_t count)
+{
+	const auto writePosition = writePosition_.load(std::memory_order_relaxed);
+	if (writePosition - readPosition_.load(std::memory_order_acquire) >= storageRange_.size())
+	{
+		overflowCount_.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	auto& notification = storageRange_[writePosition % storageRange_.size()];
+	notification.timestamp = distortos::TickClock::now();
+	notification.address = address;
+	notification.count = count;
+	notification.type = type;
+	writePosition_.store(writePosition + 1, std::memory_order_release);
+	return true;
+}
+
+bool WriteNotificationQueue::tryPop(Notification& notification)
+{
+	const auto readPosition = readPosition_.load(std::memory_order_relaxed);
+	if (readPosition == publishedPosition_.load(std::memory_order_acquire))
+		return false;
+
+	notification = storageRange_[readPosition % storageRange_.size()];
+	readPosition_.store(readPosition + 1, std::memory_order_release);
+	return true;
+}
+
+int WriteNotificationQueue::waitUntil(const distortos::TickClock::time_point deadline)
+{
+	return semaphore_.tryWaitUntil(deadline);
+}
@@ -0,0 +1,473 @@
+/**
+ * \file
+ * \brief FreemodbusBenchmark class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FreemodbusBenchmark.hpp"
+
+#include "freemodbusMbap.hpp"
+#include "freemodbusTimersPoll.hpp"
+#include "modbusAscii.hpp"
+
+#include "mbport.h"
+
+#include "distortos/chip/CMSIS-proxy.h"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include "estd/ScopeGuard.hpp"
+
+#include <algorithm>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+#if !defined(DWT_CTRL_CPIEVTENA_Msk)
+#error "FreemodbusBenchmark requires ARMv7-M core with DWT profiling counters"
+#endif	// !defined(DWT_CTRL_CPIEVTENA_Msk)
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// names of measured functions, used in report and baseline
+const char* const functionNames[]
+{
+		"eventPost",
+		"eventGet",
+		"timersPollDisabled",
+		"timersPollArmed",
+		"serialGetByte",
+		"serialPutByte",
+#if MB_TCP_ENABLED == 1
+		"mbapFrameSize",
+#endif	// MB_TCP_ENABLED == 1
+		"asciiDecodePerCharacter",
+		"asciiDecodeCodec",
+		"asciiEncodePerCharacter",
+		"asciiEncodeCodec",
+};
+
+static_assert(sizeof(functionNames) / sizeof(*functionNames) ==
+		static_cast<size_t>(FreemodbusBenchmark::Function::count), "Invalid size of functionNames!");
+
+/// binary data of Modbus ASCII frame, decoded from or encoded to the frame buffer
+uint8_t asciiBytes[128];
+
+/// sink for results of measured functions, so that the calls are not optimized out
+volatile size_t sink;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts value of nibble to hex character, the same way as FreeMODBUS does in prvucMBBIN2CHAR().
+ *
+ * \param [in] value is the value of nibble
+ *
+ * \return hex character of \a value, '0' if \a value is not a nibble
+ */
+
+uint8_t convertBinaryToCharacter(const uint8_t value)
+{
+	if (value <= 0x09)
+		return '0' + value;
+	if (value <= 0x0f)
+		return 'A' + value - 0x0a;
+	return '0';
+}
+
+/**
+ * \brief Converts hex character to value of nibble, the same way as FreeMODBUS does in prvucMBCHAR2BIN().
+ *
+ * \param [in] character is the hex character
+ *
+ * \return value of \a character, 0xff if \a character is not a hex digit
+ */
+
+uint8_t convertCharacterToBinary(const uint8_t character)
+{
+	if (character >= '0' && character <= '9')
+		return character - '0';
+	if (character >= 'A' && character <= 'F')
+		return character - 'A' + 0x0a;
+	return 0xff;
+}
+
+/**
+ * \brief Finds function with given name.
+ *
+ * \param [in] name is a pointer to name of function, not null-terminated
+ * \param [in] length is the length of \a name
+ *
+ * \return function with name \a name, FreemodbusBenchmark::Function::count if there is no such function
+ */
+
+FreemodbusBenchmark::Function findFunction(const char* const name, const size_t length)
+{
+	for (size_t index {}; index < static_cast<size_t>(FreemodbusBenchmark::Function::count); ++index)
+		if (strlen(functionNames[index]) == length && memcmp(functionNames[index], name, length) == 0)
+			return static_cast<FreemodbusBenchmark::Function>(index);
+
+	return FreemodbusBenchmark::Function::count;
+}
+
+/**
+ * \brief Calculates value per call.
+ *
+ * \param [in] total is the total value of all calls
+ * \param [in] calls is the number of calls
+ *
+ * \return \a total divided by \a calls, hundredths
+ */
+
+uint64_t getHundredthsPerCall(const uint64_t total, const uint32_t calls)
+{
+	return calls == 0 ? 0 : total * 100 / calls;
+}
+
+/**
+ * \brief Measures function.
+ *
+ * \tparam Prepare is the type of \a prepare, should be callable as void()
+ * \tparam Call is the type of \a call, should be callable as void()
+ *
+ * \param [in] calls is the number of calls
+ * \param [in] prepare is a functor which prepares state for next call, not measured
+ * \param [in] call is a functor with measured call
+ *
+ * \return result of measurement, including cost of reading the counters
+ */
+
+template<typename Prepare, typename Call>
+FreemodbusBenchmark::Result measure(const uint32_t calls, Prepare prepare, Call call)
+{
+	uint64_t cycles {};
+	int64_t instructions {};
+	for (uint32_t i {}; i < calls; ++i)
+	{
+		const distortos::InterruptMaskingLock interruptMaskingLock;
+
+		prepare();
+
+		const uint8_t cpiBefore = DWT->CPICNT;
+		const uint8_t exceptionBefore = DWT->EXCCNT;
+		const uint8_t sleepBefore = DWT->SLEEPCNT;
+		const uint8_t lsuBefore = DWT->LSUCNT;
+		const uint8_t foldBefore = DWT->FOLDCNT;
+		const uint32_t cyclesBefore = DWT->CYCCNT;
+		asm volatile ("" ::: "memory");
+
+		call();
+
+		asm volatile ("" ::: "memory");
+		const uint32_t cyclesAfter = DWT->CYCCNT;
+		const uint8_t cpi = DWT->CPICNT - cpiBefore;
+		const uint8_t exception = DWT->EXCCNT - exceptionBefore;
+		const uint8_t sleep = DWT->SLEEPCNT - sleepBefore;
+		const uint8_t lsu = DWT->LSUCNT - lsuBefore;
+		const uint8_t fold = DWT->FOLDCNT - foldBefore;
+
+		const uint32_t callCycles = cyclesAfter - cyclesBefore;
+		cycles += callCycles;
+		instructions += static_cast<int64_t>(callCycles) - cpi - exception - sleep - lsu + fold;
+	}
+
+	return {cycles, instructions > 0 ? static_cast<uint64_t>(instructions) : 0, calls};
+}
+
+/**
+ * \brief Parses decimal number with up to two fractional digits.
+ *
+ * \param [in] string is a pointer to beginning of number
+ * \param [in] end is a pointer to end of line with number
+ * \param [out] value is a reference to variable for parsed value, hundredths
+ *
+ * \return pointer to first character after number, nullptr if there is no number at \a string
+ */
+
+const char* parseHundredths(const char* string, const char* const end, uint64_t& value)
+{
+	const auto begin = string;
+	uint64_t integer {};
+	while (string != end && *string >= '0' && *string <= '9')
+		integer = integer * 10 + (*string++ - '0');
+
+	if (string == begin)
+		return nullptr;
+
+	uint64_t fraction {};
+	if (string != end && *string == '.')
+		for (uint64_t scale {10}; ++string != end && *string >= '0' && *string <= '9'; scale /= 10)
+			fraction += (*string - '0') * scale;
+
+	value = integer * 100 + fraction;
+	return string;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, size_t> FreemodbusBenchmark::compare(const char* baseline, const uint8_t tolerancePercent) const
+{
+	size_t compared {};
+	size_t regressions {};
+	while (*baseline != '\0')
+	{
+		const auto lineEnd = baseline + strcspn(baseline, "\n");
+		const auto nameEnd = baseline + strcspn(baseline, ",\n");
+		const auto function = findFunction(baseline, nameEnd - baseline);
+
+		// nanoseconds, cycles and instructions per call
+		uint64_t values[3] {};
+		auto position = nameEnd;
+		for (auto& value : values)
+			if (position != nullptr && position != lineEnd && *position == ',')
+				position = parseHundredths(position + 1, lineEnd, value);
+			else
+				position = nullptr;
+
+		if (function != Function::count && position != nullptr)
+		{
+			++compared;
+			const auto& result = getResult(function);
+			if (getHundredthsPerCall(result.cycles, result.calls) * 100 > values[1] * (100 + tolerancePercent) ||
+					getHundredthsPerCall(result.instructions, result.calls) * 100 >
+					values[2] * (100 + tolerancePercent))
+				++regressions;
+		}
+
+		baseline = *lineEnd == '\n' ? lineEnd + 1 : lineEnd;
+	}
+
+	if (compared == 0)
+		return {ENOENT, {}};
+
+	return {{}, regressions};
+}
+
+int FreemodbusBenchmark::run(FreemodbusSerialInstance& instance, const uint32_t calls)
+{
+	if (instance.frameBuffer == nullptr || instance.frameBufferSize < 2 || calls == 0)
+		return EINVAL;
+
+	CoreDebug->DEMCR = CoreDebug->DEMCR | CoreDebug_DEMCR_TRCENA_Msk;
+	DWT->CTRL = DWT->CTRL | DWT_CTRL_CYCCNTENA_Msk | DWT_CTRL_CPIEVTENA_Msk | DWT_CTRL_EXCEVTENA_Msk |
+			DWT_CTRL_SLEEPEVTENA_Msk | DWT_CTRL_LSUEVTENA_Msk | DWT_CTRL_FOLDEVTENA_Msk;
+
+	const auto pendingEvents = instance.pendingEvents;
+	const auto timerDeadline = instance.timerDeadline;
+	const auto bytesInBuffer = instance.bytesInBuffer;
+	const auto rxPosition = instance.rxPosition;
+	const auto txPosition = instance.txPosition;
+	const auto extensions = instance.extensions;
+	const auto restoreScopeGuard = estd::makeScopeGuard(
+			[&instance, pendingEvents, timerDeadline, bytesInBuffer, rxPosition, txPosition, extensions]()
+			{
+				instance.pendingEvents = pendingEvents;
+				instance.timerDeadline = timerDeadline;
+				instance.bytesInBuffer = bytesInBuffer;
+				instance.rxPosition = rxPosition;
+				instance.txPosition = txPosition;
+				instance.extensions = extensions;
+			});
+
+	// optional features, like publishing of writes, are not a part of the measured path
+	instance.extensions = {};
+	instance.bytesInBuffer = instance.frameBufferSize;
+	memset(instance.frameBuffer, 0x5a, instance.frameBufferSize);
+
+	const auto calibration = measure(calls, []()
+			{
+
+			},
+			[]()
+			{
+
+			});
+	auto rawInstance = &instance.rawInstance;
+	// Modbus ASCII frame must fit in the frame buffer, xMBPortSerialPutByte() does not use its last byte
+	const auto asciiSize = std::min((instance.frameBufferSize - 1) / 2, sizeof(asciiBytes));
+	Result results[]
+	{
+			// eventPost
+			measure(calls, [&instance]()
+					{
+						instance.pendingEvents = {};
+					},
+					[rawInstance]()
+					{
+						sink = xMBPortEventPost(rawInstance, EV_READY);
+					}),
+			// eventGet
+			measure(calls, [&instance]()
+					{
+						instance.pendingEvents = {};
+						instance.pendingEvents[EV_READY] = 1;
+					},
+					[rawInstance]()
+					{
+						eMBEventType event;
+						sink = xMBPortEventGet(rawInstance, &event);
+					}),
+			// timersPollDisabled
+			measure(calls, [&instance]()
+					{
+						instance.timerDeadline = distortos::TickClock::time_point::max();
+					},
+					[&instance]()
+					{
+						sink = freemodbusTimersPoll(instance).time_since_epoch().count();
+					}),
+			// timersPollArmed
+			measure(calls, [&instance]()
+					{
+						instance.timerDeadline = distortos::TickClock::now() + std::chrono::hours{1};
+					},
+					[&instance]()
+					{
+						sink = freemodbusTimersPoll(instance).time_since_epoch().count();
+					}),
+			// serialGetByte
+			measure(calls, [&instance]()
+					{
+						if (instance.rxPosition >= instance.bytesInBuffer)
+							instance.rxPosition = {};
+					},
+					[rawInstance]()
+					{
+						uint8_t byte;
+						sink = xMBPortSerialGetByte(rawInstance, &byte);
+					}),
+			// serialPutByte
+			measure(calls, [&instance]()
+					{
+						if (instance.txPosition >= instance.frameBufferSize - 1)
+							instance.txPosition = {};
+					},
+					[rawInstance]()
+					{
+						sink = xMBPortSerialPutByte(rawInstance, 0x5a);
+					}),
+#if MB_TCP_ENABLED == 1
+			// mbapFrameSize
+			measure(calls, []()
+					{
+
+					},
+					[&instance]()
+					{
+						sink = getMbapFrameSize(instance.frameBuffer, instance.bytesInBuffer);
+					}),
+#endif	// MB_TCP_ENABLED == 1
+			// asciiDecodePerCharacter
+			measure(calls, [&instance, asciiSize]()
+					{
+						memset(instance.frameBuffer, 'A', asciiSize * 2);
+						instance.rxPosition = {};
+					},
+					[rawInstance, asciiSize]()
+					{
+						for (size_t i {}; i < asciiSize; ++i)
+						{
+							uint8_t high;
+							uint8_t low;
+							xMBPortSerialGetByte(rawInstance, &high);
+							xMBPortSerialGetByte(rawInstance, &low);
+							asciiBytes[i] = convertCharacterToBinary(high) << 4 | convertCharacterToBinary(low);
+						}
+						uint8_t sum {};
+						for (size_t i {}; i < asciiSize; ++i)
+							sum += asciiBytes[i];
+						sink = sum;
+					}),
+			// asciiDecodeCodec
+			measure(calls, [&instance, asciiSize]()
+					{
+						memset(instance.frameBuffer, 'A', asciiSize * 2);
+					},
+					[&instance, asciiSize]()
+					{
+						uint8_t sum {};
+						sink = modbusAsciiDecode(reinterpret_cast<const char*>(instance.frameBuffer), asciiSize,
+								asciiBytes, sum) + sum;
+					}),
+			// asciiEncodePerCharacter
+			measure(calls, [&instance]()
+					{
+						instance.txPosition = {};
+					},
+					[rawInstance, asciiSize]()
+					{
+						uint8_t sum {};
+						for (size_t i {}; i < asciiSize; ++i)
+							sum += asciiBytes[i];
+						for (size_t i {}; i < asciiSize; ++i)
+						{
+							xMBPortSerialPutByte(rawInstance, convertBinaryToCharacter(asciiBytes[i] >> 4));
+							xMBPortSerialPutByte(rawInstance, convertBinaryToCharacter(asciiBytes[i] & 0x0f));
+						}
+						sink = sum;
+					}),
+			// asciiEncodeCodec
+			measure(calls, []()
+					{
+
+					},
+					[&instance, asciiSize]()
+					{
+						sink = modbusAsciiEncode(asciiBytes, asciiSize, reinterpret_cast<char*>(instance.frameBuffer));
+					}),
+	};
+
+	static_assert(sizeof(results) / sizeof(*results) == static_cast<size_t>(Function::count),
+			"Invalid number of measured functions!");
+
+	for (size_t index {}; index < static_cast<size_t>(Function::count); ++index)
+	{
+		auto& result = results[index];
+		result.cycles -= std::min(result.cycles, calibration.cycles);
+		result.instructions -= std::min(result.instructions, calibration.instructions);
+		results_[index] = result;
+	}
+
+	return {};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t FreemodbusBenchmark::formatLine(const size_t index, char (&line)[maxLineLength]) const
+{
+	int ret;
+	if (index == 0)
+		ret = snprintf(line, sizeof(line), "function,ns_per_call,cycles_per_call,instructions_per_call\n");
+	else
+	{
+		const auto& result = results_[index - 1];
+		const auto cycles = getHundredthsPerCall(result.cycles, result.calls);
+		const auto nanoseconds = coreFrequency_ == 0 ? 0 : cycles * 1000000000 / coreFrequency_;
+		const auto instructions = getHundredthsPerCall(result.instructions, result.calls);
+		ret = snprintf(line, sizeof(line), "%s,%" PRIu64 ".%02" PRIu64 ",%" PRIu64 ".%02" PRIu64 ",%" PRIu64 ".%02"
+				PRIu64 "\n", functionNames[index - 1], nanoseconds / 100, nanoseconds % 100, cycles / 100, cycles % 100,
+				instructions / 100, instructions % 100);
+	}
+
+	return ret < 0 ? 0 : std::min(static_cast<size_t>(ret), sizeof(line) - 1);
+}
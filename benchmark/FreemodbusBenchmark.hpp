@@ -0,0 +1,201 @@
+/**
+ * \file
+ * \brief FreemodbusBenchmark class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_FREEMODBUSBENCHMARK_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_FREEMODBUSBENCHMARK_HPP_
+
+#include "FreemodbusSerialInstance.hpp"
+
+#include <utility>
+
+/**
+ * FreemodbusBenchmark measures per-call cost of hot functions of the port layer.
+ *
+ * Each call is measured separately with DWT counters of ARMv7-M core, with interrupts masked. CYCCNT gives cycles,
+ * number of executed instructions is derived from it and the 8-bit profiling counters (CPICNT, EXCCNT, SLEEPCNT,
+ * LSUCNT and FOLDCNT), so it is exact only when each of these counters changes by less than 256 during one call - which
+ * holds for all measured functions. Cost of reading the counters is measured with an empty call and subtracted.
+ *
+ * Results are reported as CSV, which is also the format of baseline file (baseline.csv) - report() of a reference run
+ * is stored as baseline and compare() of later runs flags functions which became more expensive.
+ *
+ * \code
+ * FreemodbusBenchmark benchmark {SystemCoreClock};
+ * benchmark.run(instance, 10000);
+ * benchmark.report([](const void* const buffer, const size_t size)
+ *         {
+ *             return fwrite(buffer, 1, size, stdout) == size ? 0 : EIO;
+ *         });
+ * const auto [ret, regressions] = benchmark.compare(baseline, 5);
+ * \endcode
+ */
+
+class FreemodbusBenchmark
+{
+public:
+
+	/// Function is a measured function
+	enum class Function : uint8_t
+	{
+		/// xMBPortEventPost() of the lowest priority event
+		eventPost,
+		/// xMBPortEventGet() of the lowest priority event, with full reverse scan of pending events
+		eventGet,
+		/// freemodbusTimersPoll() with disabled timer
+		timersPollDisabled,
+		/// freemodbusTimersPoll() with armed timer which did not expire
+		timersPollArmed,
+		/// xMBPortSerialGetByte()
+		serialGetByte,
+		/// xMBPortSerialPutByte()
+		serialPutByte,
+
+#if MB_TCP_ENABLED == 1
+
+		/// calculation of size of Modbus TCP frame from its MBAP header, done by freemodbusTcpPoll()
+		mbapFrameSize,
+
+#endif	// MB_TCP_ENABLED == 1
+
+		/// decoding of Modbus ASCII frame the way FreeMODBUS does it - xMBPortSerialGetByte() and conversion of each
+		/// character, then separate pass for LRC
+		asciiDecodePerCharacter,
+		/// decoding of Modbus ASCII frame with modbusAsciiDecode(), LRC calculated in the same pass
+		asciiDecodeCodec,
+		/// encoding of Modbus ASCII frame the way FreeMODBUS does it - separate pass for LRC, then conversion of each
+		/// nibble and xMBPortSerialPutByte()
+		asciiEncodePerCharacter,
+		/// encoding of Modbus ASCII frame with modbusAsciiEncode(), LRC calculated in the same pass
+		asciiEncodeCodec,
+
+		/// number of measured functions
+		count
+	};
+
+	/// Result is a result of measurement of one function
+	struct Result
+	{
+		/// total number of cycles of all calls
+		uint64_t cycles;
+
+		/// total number of executed instructions of all calls
+		uint64_t instructions;
+
+		/// number of calls
+		uint32_t calls;
+	};
+
+	/// max length of one line of report, including terminating null character
+	constexpr static size_t maxLineLength {64};
+
+	/**
+	 * \brief FreemodbusBenchmark's constructor
+	 *
+	 * \param [in] coreFrequencyy is the frequency of the core, Hz
+	 */
+
+	constexpr explicit FreemodbusBenchmark(const uint32_t coreFrequencyy) :
+			results_{},
+			coreFrequency_{coreFrequencyy}
+	{
+
+	}
+
+	/**
+	 * \brief Compares results with baseline.
+	 *
+	 * Functions which are not present in baseline are not compared.
+	 *
+	 * \param [in] baseline is a pointer to null-terminated contents of baseline file, in the format of report()
+	 * \param [in] tolerancePercent is the allowed increase of cycles and instructions per call, percent
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of functions whose cycles or
+	 * instructions per call exceed baseline by more than \a tolerancePercent; error codes:
+	 * - ENOENT - \a baseline has no results of measured functions, so nothing was compared;
+	 */
+
+	std::pair<int, size_t> compare(const char* baseline, uint8_t tolerancePercent) const;
+
+	/**
+	 * \param [in] function is the measured function
+	 *
+	 * \return result of measurement of \a function
+	 */
+
+	const Result& getResult(const Function function) const
+	{
+		return results_[static_cast<size_t>(function)];
+	}
+
+	/**
+	 * \brief Writes results as CSV - header line followed by one line per function with its name, nanoseconds,
+	 * cycles and instructions per call.
+	 *
+	 * \tparam Writer is the type of \a writer, should be callable as int(const void* buffer, size_t size)
+	 *
+	 * \param [in] writer is a functor which writes the report, returns 0 on success, error code otherwise
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by \a writer;
+	 */
+
+	template<typename Writer>
+	int report(Writer writer) const
+	{
+		char line[maxLineLength];
+		for (size_t index {}; index <= static_cast<size_t>(Function::count); ++index)
+		{
+			const auto size = formatLine(index, line);
+			const auto ret = writer(line, size);
+			if (ret != 0)
+				return ret;
+		}
+
+		return {};
+	}
+
+	/**
+	 * \brief Measures all functions.
+	 *
+	 * \warning State of \a instance is saved and restored, but contents of its frame buffer are destroyed - the
+	 * instance must not be used by any other thread during measurement.
+	 *
+	 * \param [in] instance is a reference to instance of FreeMODBUS which is used for measurement, must have frame
+	 * buffer
+	 * \param [in] calls is the number of calls of each function
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a instance has no frame buffer or \a calls is 0;
+	 */
+
+	int run(FreemodbusSerialInstance& instance, uint32_t calls);
+
+private:
+
+	/**
+	 * \brief Formats one line of report.
+	 *
+	 * \param [in] index is the index of line, 0 - header, index of function incremented by 1 - line of this function
+	 * \param [out] line is the buffer for formatted line
+	 *
+	 * \return length of formatted line, bytes
+	 */
+
+	size_t formatLine(size_t index, char (&line)[maxLineLength]) const;
+
+	/// results of measurement of all functions
+	Result results_[static_cast<size_t>(Function::count)];
+
+	/// frequency of the core, Hz
+	uint32_t coreFrequency_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_FREEMODBUSBENCHMARK_HPP_
@@ -0,0 +1,1011 @@
+/**
+ * \file
+ * \brief SerialLineTest class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "SerialLineTest.hpp"
+
+#include "FreemodbusSerialInstance.hpp"
+#include "modbusCrc16.hpp"
+#include "SimulatedSerialLine.hpp"
+#include "VirtualClock.hpp"
+
+#include "mbport.h"
+
+#include "distortos/devices/communication/SerialPort.hpp"
+#include "distortos/devices/communication/UartBase.hpp"
+#include "distortos/DynamicSoftwareTimer.hpp"
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// baud rates of throughput cases, bps
+constexpr uint32_t throughputBaudRates[] {1200, 2400, 4800, 9600, 19200, 38400, 57600, 115200};
+
+static_assert(sizeof(throughputBaudRates) / sizeof(*throughputBaudRates) == SerialLineTest::throughputCases,
+		"Invalid size of throughputBaudRates!");
+
+/// baud rates of frame split cases, bps
+constexpr uint32_t frameSplitBaudRates[] {9600, 19200, 115200};
+
+/// number of frame split cases at each baud rate - two pauses shorter than T3.5 and two longer
+constexpr size_t frameSplitPauses {4};
+
+static_assert(sizeof(frameSplitBaudRates) / sizeof(*frameSplitBaudRates) * frameSplitPauses ==
+		SerialLineTest::frameSplitCases, "Invalid size of frameSplitBaudRates!");
+
+/// character length, bits
+constexpr uint8_t characterLength {8};
+
+/// parity
+constexpr auto parity = distortos::devices::UartParity::even;
+
+/// address of slave
+constexpr uint8_t slaveAddress {1};
+
+/// code of function used in transactions - Read Holding Registers
+constexpr uint8_t readHoldingRegisters {0x03};
+
+/// number of registers read in each transaction
+constexpr uint8_t registers {10};
+
+/// size of request - address, function, starting address, quantity and CRC - bytes
+constexpr size_t requestSize {8};
+
+/// size of response - address, function, byte count, registers and CRC - bytes
+constexpr size_t responseSize {5 + 2 * registers};
+
+/// position at which split request is divided
+constexpr size_t splitPosition {requestSize / 2};
+
+/// size of read and write buffers of serial port of slave, bytes
+constexpr size_t serialPortBufferSize {512};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Calculates duration of Modbus RTU T3.5 timer, the same way as FreeMODBUS does in eMBRTUInit().
+ *
+ * \param [in] baudRate is the baud rate, bps
+ *
+ * \return duration of T3.5 timer, 50 us units
+ */
+
+uint16_t getT35Timeout50us(const uint32_t baudRate)
+{
+	// fixed value of 1750 us is used above 19200 bps, so the timer does not depend on the time of single character
+	if (baudRate > 19200)
+		return 35;
+
+	return (7 * 220000) / (2 * baudRate);
+}
+
+/**
+ * \param [in] baudRate is the baud rate, bps
+ *
+ * \return duration of Modbus RTU T3.5 timer, the same as in FreeMODBUS
+ */
+
+std::chrono::nanoseconds getT35(const uint32_t baudRate)
+{
+	return std::chrono::microseconds{getT35Timeout50us(baudRate) * 50};
+}
+
+/**
+ * \param [in] baudRate is the baud rate, bps
+ * \param [in] size is the number of characters
+ *
+ * \return duration of transmission of \a size characters at \a baudRate
+ */
+
+std::chrono::nanoseconds getTransmissionDuration(const uint32_t baudRate, const size_t size)
+{
+	return SimulatedSerialLine::getTransmissionDuration(baudRate, characterLength, parity, false, 0, size);
+}
+
+/**
+ * \param [in] duration is the duration which will be converted
+ *
+ * \return \a duration converted to ticks, rounded up
+ */
+
+distortos::TickClock::duration toTicks(const std::chrono::nanoseconds duration)
+{
+	const auto ticks = std::chrono::duration_cast<distortos::TickClock::duration>(duration);
+	return ticks < duration ? ticks + distortos::TickClock::duration{1} : ticks;
+}
+
+/**
+ * \brief Converts duration to nanoseconds.
+ *
+ * \param [in] duration is the duration which will be converted
+ *
+ * \return \a duration in nanoseconds
+ */
+
+uint64_t toNanoseconds(const std::chrono::nanoseconds duration)
+{
+	return duration.count();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * RtuSlave is a Modbus RTU slave with minimal equivalent of Modbus RTU frame layer of FreeMODBUS (mbrtu.c) - the same
+ * states of receiver, the same use of the port layer - and with handler of Read Holding Registers.
+ */
+
+class RtuSlave : public FreemodbusSerialInstance
+{
+public:
+
+	/// State is a state of receiver
+	enum class State : uint8_t
+	{
+		/// waiting for T3.5 of silence after start
+		init,
+		/// waiting for first character of frame
+		idle,
+		/// receiving frame
+		receiving,
+		/// frame is too long, waiting for its end
+		error,
+	};
+
+	/**
+	 * \brief RtuSlave's constructor
+	 *
+	 * \param [in] serialPortt is a reference to serial port of the slave
+	 */
+
+	explicit RtuSlave(distortos::devices::SerialPort& serialPortt) :
+			FreemodbusSerialInstance{serialPortt, frameBufferStorage_, sizeof(frameBufferStorage_)},
+			frameBufferStorage_{},
+			frame_{},
+			response_{},
+			frameSize_{},
+			responsePosition_{},
+			responseSize_{},
+			state_{}
+	{
+		rawInstance.eMBCurrentMode = MB_RTU;
+		rawInstance.pxMBFrameCBByteReceived = byteReceived;
+		rawInstance.pxMBFrameCBTransmitterEmpty = transmitterEmpty;
+		rawInstance.pxMBPortCBTimerExpired = timerExpired;
+	}
+
+	/**
+	 * \return current state of receiver
+	 */
+
+	State getState() const
+	{
+		return state_;
+	}
+
+	/**
+	 * \brief Handles one event, just like eMBPoll().
+	 */
+
+	void poll()
+	{
+		eMBEventType event;
+		if (xMBPortEventGet(&rawInstance, &event) == true && event == EV_FRAME_RECEIVED)
+			handleFrame();
+	}
+
+	/**
+	 * \brief Starts the slave, just like eMBRTUInit() and eMBRTUStart().
+	 *
+	 * \param [in] baudRate is the baud rate, bps
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EIO - serial port could not be opened;
+	 */
+
+	int start(const uint32_t baudRate)
+	{
+		xMBPortEventInit(&rawInstance);
+		if (xMBPortSerialInit(&rawInstance, {}, baudRate, characterLength, MB_PAR_EVEN) == false)
+			return EIO;
+
+		xMBPortTimersInit(&rawInstance, getT35Timeout50us(baudRate));
+		state_ = State::init;
+		vMBPortSerialEnable(&rawInstance, true, false);
+		vMBPortTimersEnable(&rawInstance);
+		return {};
+	}
+
+	/**
+	 * \brief Stops the slave, waiting until transmission of response is complete.
+	 */
+
+	void stop()
+	{
+		xMBPortSerialClose(&rawInstance);
+	}
+
+private:
+
+	/**
+	 * \brief Handles received character, just like xMBRTUReceiveFSM().
+	 *
+	 * \param [in] instance is a pointer to raw instance of the slave
+	 *
+	 * \return false
+	 */
+
+	static bool byteReceived(xMBInstance* instance);
+
+	/**
+	 * \param [in] instance is a pointer to raw instance of the slave
+	 *
+	 * \return reference to RtuSlave which owns \a instance
+	 */
+
+	static RtuSlave& fromRawInstance(xMBInstance* const instance)
+	{
+		return static_cast<RtuSlave&>(*reinterpret_cast<FreemodbusSerialInstance*>(instance));
+	}
+
+	/**
+	 * \brief Handles received frame, just like eMBRTUReceive(), eMBFuncReadHoldingRegister() and eMBRTUSend().
+	 *
+	 * Frame which is too short, has invalid CRC or different address is rejected.
+	 */
+
+	void handleFrame();
+
+	/**
+	 * \brief Handles expiration of T3.5 timer, just like xMBRTUTimerT35Expired().
+	 *
+	 * \param [in] instance is a pointer to raw instance of the slave
+	 *
+	 * \return false
+	 */
+
+	static bool timerExpired(xMBInstance* instance);
+
+	/**
+	 * \brief Provides next character of response, just like xMBRTUTransmitFSM().
+	 *
+	 * \param [in] instance is a pointer to raw instance of the slave
+	 *
+	 * \return false
+	 */
+
+	static bool transmitterEmpty(xMBInstance* instance);
+
+	/// storage for frame buffer of the instance
+	uint8_t frameBufferStorage_[serialBufferSize];
+
+	/// received frame
+	uint8_t frame_[serialBufferSize];
+
+	/// response which is transmitted
+	uint8_t response_[responseSize];
+
+	/// number of bytes in frame_
+	size_t frameSize_;
+
+	/// number of already transmitted bytes of response_
+	size_t responsePosition_;
+
+	/// number of bytes in response_
+	size_t responseSize_;
+
+	/// current state of receiver
+	State state_;
+};
+
+/**
+ * Master is a Modbus RTU master, which sends requests reading holding registers of RtuSlave one after another, waiting
+ * for T3.5 after each response. It is driven only by the events of its endpoint and its timer.
+ */
+
+class Master : public distortos::devices::UartBase
+{
+public:
+
+	/**
+	 * \brief Master's constructor
+	 *
+	 * \param [in] endpointt is a reference to master endpoint of the line
+	 * \param [in] baudRatee is the baud rate, bps
+	 */
+
+	Master(SimulatedSerialLine::Endpoint& endpointt, const uint32_t baudRatee) :
+			timer_{&Master::timerExpired, this},
+			finishTime_{},
+			pause_{},
+			interFrameDelay_{toTicks(getT35(baudRatee))},
+			responseTimeout_{toTicks(2 * getTransmissionDuration(baudRatee, responseSize) + 10 * getT35(baudRatee))},
+			endpoint_{endpointt},
+			baudRate_{baudRatee},
+			answered_{},
+			failures_{},
+			transactionsLeft_{},
+			received_{},
+			request_{slaveAddress, readHoldingRegisters, 0, 0, 0, registers},
+			response_{},
+			character_{},
+			state_{State::idle},
+			firstAnswered_{},
+			lastAnswered_{},
+			split_{}
+	{
+		const auto crc = modbusCrc16(request_, requestSize - 2);
+		request_[requestSize - 2] = crc;
+		request_[requestSize - 1] = crc >> 8;
+	}
+
+	/**
+	 * \brief Starts sending requests.
+	 *
+	 * \param [in] transactions is the number of transactions
+	 * \param [in] split selects whether the first request is split in two parts (true) or not (false)
+	 * \param [in] pause is the pause between parts of split request
+	 */
+
+	void begin(const uint32_t transactions, const bool split, const distortos::TickClock::duration pause)
+	{
+		transactionsLeft_ = transactions;
+		split_ = split;
+		pause_ = pause;
+		sendRequest();
+	}
+
+	/**
+	 * \return number of answered transactions
+	 */
+
+	uint32_t getAnswered() const
+	{
+		return answered_;
+	}
+
+	/**
+	 * \return number of transactions which timed out or got invalid response
+	 */
+
+	uint32_t getFailures() const
+	{
+		return failures_;
+	}
+
+	/**
+	 * \return time point at which the next request could be sent after the last transaction
+	 */
+
+	distortos::TickClock::time_point getFinishTime() const
+	{
+		return finishTime_;
+	}
+
+	/**
+	 * \return true if the first transaction was answered, false otherwise
+	 */
+
+	bool isFirstAnswered() const
+	{
+		return firstAnswered_;
+	}
+
+	/**
+	 * \return true if all transactions are finished, false otherwise
+	 */
+
+	bool isIdle() const
+	{
+		return state_ == State::idle;
+	}
+
+	/**
+	 * \return true if the last transaction was answered, false otherwise
+	 */
+
+	bool isLastAnswered() const
+	{
+		return lastAnswered_;
+	}
+
+	/**
+	 * \brief Starts endpoint of the master.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by SimulatedSerialLine::Endpoint::start();
+	 * - error codes returned by SimulatedSerialLine::Endpoint::startRead();
+	 */
+
+	int start()
+	{
+		const auto ret = endpoint_.start(*this, baudRate_, characterLength, parity, false);
+		if (ret.first != 0)
+			return ret.first;
+
+		return endpoint_.startRead(&character_, sizeof(character_));
+	}
+
+	/**
+	 * \brief Stops endpoint of the master.
+	 */
+
+	void stop()
+	{
+		endpoint_.stopRead();
+		endpoint_.stop();
+	}
+
+private:
+
+	/// State is a state of the master
+	enum class State : uint8_t
+	{
+		/// all transactions are finished
+		idle,
+		/// first part of split request is transmitted
+		writingFirstPart,
+		/// pause between parts of split request
+		pausing,
+		/// request (or its second part) is transmitted
+		writing,
+		/// waiting for response
+		waiting,
+		/// waiting for T3.5 before next request
+		interFrame,
+	};
+
+	/**
+	 * \return true if response is valid, false otherwise
+	 */
+
+	bool checkResponse() const;
+
+	/**
+	 * \brief Finishes current transaction and schedules the next one.
+	 *
+	 * \param [in] answered selects whether the transaction was answered with valid response (true) or not (false)
+	 */
+
+	void finishTransaction(bool answered);
+
+	/**
+	 * \brief "Read complete" event
+	 *
+	 * \param [in] bytesRead is the number of read bytes, always 1
+	 */
+
+	void readCompleteEvent(size_t bytesRead) override;
+
+	/**
+	 * \brief "Receive error" event
+	 *
+	 * Errors are not expected, response with missing characters times out.
+	 */
+
+	void receiveErrorEvent(ErrorSet) override
+	{
+
+	}
+
+	/**
+	 * \brief Sends request, first part of it if it is split.
+	 */
+
+	void sendRequest();
+
+	/**
+	 * \brief Handles expiration of timer of the master.
+	 */
+
+	void timerExpired();
+
+	/**
+	 * \brief "Transmit complete" event
+	 */
+
+	void transmitCompleteEvent() override
+	{
+
+	}
+
+	/**
+	 * \brief "Transmit start" event
+	 */
+
+	void transmitStartEvent() override
+	{
+
+	}
+
+	/**
+	 * \brief "Write complete" event
+	 *
+	 * \param [in] bytesWritten is the number of written bytes
+	 */
+
+	void writeCompleteEvent(size_t bytesWritten) override;
+
+	/// timer of pause, response timeout and T3.5 before next request
+	distortos::DynamicSoftwareTimer timer_;
+
+	/// time point at which the next request could be sent after the last finished transaction
+	distortos::TickClock::time_point finishTime_;
+
+	/// pause between parts of split request
+	distortos::TickClock::duration pause_;
+
+	/// delay between end of response and next request - T3.5
+	distortos::TickClock::duration interFrameDelay_;
+
+	/// timeout of response, counted from end of request
+	distortos::TickClock::duration responseTimeout_;
+
+	/// reference to master endpoint of the line
+	SimulatedSerialLine::Endpoint& endpoint_;
+
+	/// baud rate, bps
+	uint32_t baudRate_;
+
+	/// number of answered transactions
+	uint32_t answered_;
+
+	/// number of transactions which timed out or got invalid response
+	uint32_t failures_;
+
+	/// number of transactions which are not finished yet
+	uint32_t transactionsLeft_;
+
+	/// number of bytes in response_
+	size_t received_;
+
+	/// request
+	uint8_t request_[requestSize];
+
+	/// received response
+	uint8_t response_[responseSize];
+
+	/// character received by endpoint
+	uint8_t character_;
+
+	/// current state of the master
+	State state_;
+
+	/// true if the first transaction was answered, false otherwise
+	bool firstAnswered_;
+
+	/// true if the last transaction was answered, false otherwise
+	bool lastAnswered_;
+
+	/// true if the next request is split in two parts, false otherwise
+	bool split_;
+};
+
+/**
+ * Environment is a slave and a master connected with SimulatedSerialLine
+ */
+
+class Environment
+{
+public:
+
+	/**
+	 * \brief Environment's constructor
+	 *
+	 * \param [in] baudRate is the baud rate, bps
+	 */
+
+	explicit Environment(const uint32_t baudRate) :
+			line_{{}, 0},
+			readBuffer_{},
+			writeBuffer_{},
+			serialPort_{line_.getSlave(), readBuffer_, sizeof(readBuffer_), writeBuffer_, sizeof(writeBuffer_)},
+			slave_{serialPort_},
+			master_{line_.getMaster(), baudRate},
+			baudRate_{baudRate}
+	{
+
+	}
+
+	/**
+	 * \brief Runs transactions until all of them are finished.
+	 *
+	 * Slave is started and polled until it is ready to receive requests, then the master starts sending them.
+	 *
+	 * \param [in] transactions is the number of transactions
+	 * \param [in] split selects whether the first request is split in two parts (true) or not (false)
+	 * \param [in] pause is the pause between parts of split request
+	 * \param [out] startTime is a reference to variable for time point at which the first request was sent
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by Master::start();
+	 * - error codes returned by RtuSlave::start();
+	 */
+
+	int run(const uint32_t transactions, const bool split, const distortos::TickClock::duration pause,
+			distortos::TickClock::time_point& startTime)
+	{
+		{
+			const auto ret = slave_.start(baudRate_);
+			if (ret != 0)
+				return ret;
+		}
+		{
+			const auto ret = master_.start();
+			if (ret != 0)
+			{
+				slave_.stop();
+				return ret;
+			}
+		}
+
+		while (slave_.getState() != RtuSlave::State::idle)
+			slave_.poll();
+
+		startTime = VirtualClock::now();
+		master_.begin(transactions, split, pause);
+		while (master_.isIdle() == false)
+			slave_.poll();
+
+		slave_.stop();
+		master_.stop();
+		return {};
+	}
+
+	/**
+	 * \return reference to the master
+	 */
+
+	const Master& getMaster() const
+	{
+		return master_;
+	}
+
+private:
+
+	/// line which connects the slave and the master
+	SimulatedSerialLine line_;
+
+	/// read buffer of serial port of the slave
+	uint8_t readBuffer_[serialPortBufferSize];
+
+	/// write buffer of serial port of the slave
+	uint8_t writeBuffer_[serialPortBufferSize];
+
+	/// serial port of the slave
+	distortos::devices::SerialPort serialPort_;
+
+	/// slave
+	RtuSlave slave_;
+
+	/// master
+	Master master_;
+
+	/// baud rate, bps
+	uint32_t baudRate_;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| RtuSlave's private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool RtuSlave::byteReceived(xMBInstance* const instance)
+{
+	auto& slave = fromRawInstance(instance);
+	uint8_t byte;
+	xMBPortSerialGetByte(instance, &byte);
+	if (slave.state_ == State::idle)
+	{
+		slave.frameSize_ = {};
+		slave.state_ = State::receiving;
+	}
+	if (slave.state_ == State::receiving)
+	{
+		if (slave.frameSize_ < sizeof(slave.frame_))
+			slave.frame_[slave.frameSize_++] = byte;
+		else
+			slave.state_ = State::error;
+	}
+
+	vMBPortTimersEnable(instance);
+	return false;
+}
+
+void RtuSlave::handleFrame()
+{
+	if (frameSize_ < 4 || modbusCrc16(frame_, frameSize_) != 0 || frame_[0] != slaveAddress ||
+			state_ != State::idle)
+		return;
+
+	if (frameSize_ != requestSize || frame_[1] != readHoldingRegisters || frame_[4] != 0 || frame_[5] > registers)
+		return;
+
+	const auto quantity = frame_[5];
+	response_[0] = slaveAddress;
+	response_[1] = readHoldingRegisters;
+	response_[2] = quantity * 2;
+	// value of each register is its address
+	const auto startingAddress = frame_[2] << 8 | frame_[3];
+	for (uint8_t i {}; i < quantity; ++i)
+	{
+		response_[3 + i * 2] = (startingAddress + i) >> 8;
+		response_[3 + i * 2 + 1] = startingAddress + i;
+	}
+	const auto crc = modbusCrc16(response_, 3 + quantity * 2);
+	response_[3 + quantity * 2] = crc;
+	response_[3 + quantity * 2 + 1] = crc >> 8;
+	responseSize_ = 5 + quantity * 2;
+	responsePosition_ = {};
+	vMBPortSerialEnable(&rawInstance, false, true);
+}
+
+bool RtuSlave::timerExpired(xMBInstance* const instance)
+{
+	auto& slave = fromRawInstance(instance);
+	if (slave.state_ == State::init)
+		xMBPortEventPost(instance, EV_READY);
+	else if (slave.state_ == State::receiving)
+		xMBPortEventPost(instance, EV_FRAME_RECEIVED);
+
+	vMBPortTimersDisable(instance);
+	slave.state_ = State::idle;
+	return false;
+}
+
+bool RtuSlave::transmitterEmpty(xMBInstance* const instance)
+{
+	auto& slave = fromRawInstance(instance);
+	if (slave.responsePosition_ < slave.responseSize_)
+	{
+		xMBPortSerialPutByte(instance, slave.response_[slave.responsePosition_++]);
+		return false;
+	}
+
+	xMBPortEventPost(instance, EV_FRAME_SENT);
+	vMBPortSerialEnable(instance, true, false);
+	return false;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| Master's private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool Master::checkResponse() const
+{
+	if (modbusCrc16(response_, responseSize) != 0 || response_[0] != slaveAddress ||
+			response_[1] != readHoldingRegisters || response_[2] != registers * 2)
+		return false;
+
+	for (uint8_t i {}; i < registers; ++i)
+		if (response_[3 + i * 2] != 0 || response_[3 + i * 2 + 1] != i)
+			return false;
+
+	return true;
+}
+
+void Master::finishTransaction(const bool answered)
+{
+	if (answered == true)
+		++answered_;
+	else
+		++failures_;
+	if (answered_ + failures_ == 1)
+		firstAnswered_ = answered;
+	lastAnswered_ = answered;
+
+	finishTime_ = distortos::TickClock::now() + interFrameDelay_;
+	if (--transactionsLeft_ == 0)
+	{
+		state_ = State::idle;
+		return;
+	}
+
+	state_ = State::interFrame;
+	timer_.start(finishTime_);
+}
+
+void Master::readCompleteEvent(size_t)
+{
+	if (state_ == State::waiting && received_ < sizeof(response_))
+	{
+		response_[received_++] = character_;
+		if (received_ == sizeof(response_))
+		{
+			timer_.stop();
+			finishTransaction(checkResponse());
+		}
+	}
+
+	endpoint_.startRead(&character_, sizeof(character_));
+}
+
+void Master::sendRequest()
+{
+	received_ = {};
+	if (split_ == true)
+	{
+		split_ = false;
+		state_ = State::writingFirstPart;
+		endpoint_.startWrite(request_, splitPosition);
+		return;
+	}
+
+	state_ = State::writing;
+	endpoint_.startWrite(request_, requestSize);
+}
+
+void Master::timerExpired()
+{
+	if (state_ == State::pausing)
+	{
+		state_ = State::writing;
+		endpoint_.startWrite(request_ + splitPosition, requestSize - splitPosition);
+	}
+	else if (state_ == State::waiting)
+		finishTransaction(false);
+	else if (state_ == State::interFrame)
+		sendRequest();
+}
+
+void Master::writeCompleteEvent(size_t)
+{
+	if (state_ == State::writingFirstPart)
+	{
+		if (pause_ != distortos::TickClock::duration{})
+		{
+			state_ = State::pausing;
+			timer_.start(distortos::TickClock::now() + pause_);
+			return;
+		}
+
+		// started from this callback, so the second part follows the first one without a gap
+		state_ = State::writing;
+		endpoint_.startWrite(request_ + splitPosition, requestSize - splitPosition);
+		return;
+	}
+
+	if (state_ == State::writing)
+	{
+		state_ = State::waiting;
+		timer_.start(distortos::TickClock::now() + responseTimeout_);
+	}
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t SerialLineTest::getFailures() const
+{
+	size_t failures {};
+	for (const auto& throughput : throughputs_)
+		if (throughput.failures != 0 || throughput.transactions == 0 ||
+				throughput.nanoseconds < throughput.transactions * throughput.lineLimitNanoseconds)
+			++failures;
+
+	for (const auto& frameSplit : frameSplits_)
+		if (frameSplit.answered != frameSplit.expectedAnswered || frameSplit.recovered == false)
+			++failures;
+
+	return failures;
+}
+
+int SerialLineTest::run(const uint32_t transactions)
+{
+	if (transactions == 0)
+		return EINVAL;
+
+	for (size_t index {}; index < throughputCases; ++index)
+	{
+		const auto baudRate = throughputBaudRates[index];
+		VirtualClock::reset();
+		Environment environment {baudRate};
+		distortos::TickClock::time_point startTime;
+		const auto ret = environment.run(transactions, false, {}, startTime);
+		if (ret != 0)
+			return ret;
+
+		const auto& master = environment.getMaster();
+		auto& throughput = throughputs_[index];
+		throughput.nanoseconds = toNanoseconds(master.getFinishTime() - startTime);
+		throughput.lineLimitNanoseconds = toNanoseconds(getTransmissionDuration(baudRate, requestSize) +
+				getTransmissionDuration(baudRate, responseSize) + 2 * getT35(baudRate));
+		throughput.baudRate = baudRate;
+		throughput.transactions = master.getAnswered();
+		throughput.failures = master.getFailures();
+	}
+
+	for (size_t index {}; index < frameSplitCases; ++index)
+	{
+		const auto baudRate = frameSplitBaudRates[index / frameSplitPauses];
+		// slave detects end of frame when no character arrives for its T3.5 timer, which runs in whole ticks and is
+		// restarted by each character, so the pause is compared with the timer reduced by duration of one character
+		const auto t35 = toTicks(getT35(baudRate));
+		const auto character = toTicks(getTransmissionDuration(baudRate, 1));
+		const auto shortPause = t35 > character + distortos::TickClock::duration{1} ?
+				t35 - character - distortos::TickClock::duration{1} : distortos::TickClock::duration{};
+		const distortos::TickClock::duration pauses[frameSplitPauses]
+		{
+				{},
+				shortPause,
+				t35 + distortos::TickClock::duration{1},
+				10 * t35,
+		};
+		const auto pause = pauses[index % frameSplitPauses];
+
+		VirtualClock::reset();
+		Environment environment {baudRate};
+		distortos::TickClock::time_point startTime;
+		const auto ret = environment.run(2, true, pause, startTime);
+		if (ret != 0)
+			return ret;
+
+		const auto& master = environment.getMaster();
+		auto& frameSplit = frameSplits_[index];
+		frameSplit.pauseNanoseconds = toNanoseconds(pause);
+		frameSplit.t35Nanoseconds = toNanoseconds(t35);
+		frameSplit.baudRate = baudRate;
+		frameSplit.expectedAnswered = pause <= shortPause;
+		frameSplit.answered = master.isFirstAnswered();
+		frameSplit.recovered = master.isLastAnswered();
+	}
+
+	return {};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t SerialLineTest::formatLine(const size_t index, char (&line)[maxLineLength]) const
+{
+	int ret;
+	if (index == 0)
+		ret = snprintf(line, sizeof(line),
+				"baud_rate,transactions_per_second,line_limit_per_second,efficiency_percent,failures\n");
+	else if (index <= throughputCases)
+	{
+		const auto& throughput = throughputs_[index - 1];
+		// hundredths
+		const auto perSecond = throughput.nanoseconds == 0 ? 0 :
+				uint64_t{throughput.transactions} * 100000000000 / throughput.nanoseconds;
+		const auto limitPerSecond = throughput.lineLimitNanoseconds == 0 ? 0 :
+				100000000000 / throughput.lineLimitNanoseconds;
+		const auto efficiency = limitPerSecond == 0 ? 0 : perSecond * 10000 / limitPerSecond;
+		ret = snprintf(line, sizeof(line), "%" PRIu32 ",%" PRIu64 ".%02" PRIu64 ",%" PRIu64 ".%02" PRIu64 ",%" PRIu64
+				".%02" PRIu64 ",%" PRIu32 "\n", throughput.baudRate, perSecond / 100, perSecond % 100,
+				limitPerSecond / 100, limitPerSecond % 100, efficiency / 100, efficiency % 100, throughput.failures);
+	}
+	else if (index == throughputCases + 1)
+		ret = snprintf(line, sizeof(line), "\nbaud_rate,pause_us,t35_us,expected,observed,recovered\n");
+	else
+	{
+		const auto& frameSplit = frameSplits_[index - throughputCases - 2];
+		ret = snprintf(line, sizeof(line), "%" PRIu32 ",%" PRIu64 ",%" PRIu64 ",%s,%s,%s\n", frameSplit.baudRate,
+				frameSplit.pauseNanoseconds / 1000, frameSplit.t35Nanoseconds / 1000,
+				frameSplit.expectedAnswered == true ? "answered" : "rejected",
+				frameSplit.answered == true ? "answered" : "rejected", frameSplit.recovered == true ? "yes" : "no");
+	}
+
+	return ret < 0 ? 0 : std::min(static_cast<size_t>(ret), sizeof(line) - 1);
+}
@@ -0,0 +1,194 @@
+/**
+ * \file
+ * \brief SerialLineTest class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_SERIALLINETEST_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_SERIALLINETEST_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * SerialLineTest is a deterministic test of Modbus RTU slave on SimulatedSerialLine, run with VirtualClock on host.
+ *
+ * The slave is a FreemodbusSerialInstance polled with xMBPortEventGet() - freemodbusSerialPoll() and
+ * freemodbusTimersPoll() are the real ones, so the test covers the deadlines of serial port reads and handling of T3.5
+ * timer. Only the Modbus RTU frame layer and handling of requests are replaced by a minimal equivalent of the one of
+ * FreeMODBUS, so the test does not need FreeMODBUS sources. The master is driven directly by the events of master
+ * endpoint of the line. All transmissions use 8E1 format.
+ *
+ * Two measurements are done:
+ * - throughput - maximum number of transactions (reading of 10 holding registers) per second at each baud rate, with
+ * master waiting T3.5 after each response, compared with the limit of the line with ideal slave;
+ * - frame split - request is written in two parts with a pause between them, which is either shorter or longer than
+ * T3.5 timer of the slave; request split by shorter pause must be answered, request split by longer pause must be
+ * rejected (both parts have invalid CRC) and the next request must be answered.
+ *
+ * Results are reported as CSV, with separate tables for both measurements.
+ */
+
+class SerialLineTest
+{
+public:
+
+	/// Throughput is a result of measurement of throughput at one baud rate
+	struct Throughput
+	{
+		/// total duration of all transactions, including wait of master after the last one, nanoseconds
+		uint64_t nanoseconds;
+
+		/// duration of one transaction on line with ideal slave - request, T3.5, response and T3.5 - nanoseconds
+		uint64_t lineLimitNanoseconds;
+
+		/// baud rate, bps
+		uint32_t baudRate;
+
+		/// number of completed transactions
+		uint32_t transactions;
+
+		/// number of transactions which timed out or got invalid response
+		uint32_t failures;
+	};
+
+	/// FrameSplit is a result of one case of request split in two parts
+	struct FrameSplit
+	{
+		/// pause between parts of request, nanoseconds
+		uint64_t pauseNanoseconds;
+
+		/// duration of T3.5 timer of the slave, nanoseconds
+		uint64_t t35Nanoseconds;
+
+		/// baud rate, bps
+		uint32_t baudRate;
+
+		/// true if the request should be answered, false if it should be rejected
+		bool expectedAnswered;
+
+		/// true if the request was answered, false otherwise
+		bool answered;
+
+		/// true if the request which follows split one was answered, false otherwise
+		bool recovered;
+	};
+
+	/// number of baud rates at which throughput is measured
+	constexpr static size_t throughputCases {8};
+
+	/// number of cases of split requests
+	constexpr static size_t frameSplitCases {12};
+
+	/// max length of one line of report, including terminating null character
+	constexpr static size_t maxLineLength {96};
+
+	/**
+	 * \brief SerialLineTest's constructor
+	 */
+
+	constexpr SerialLineTest() :
+			throughputs_{},
+			frameSplits_{}
+	{
+
+	}
+
+	/**
+	 * \return number of failed checks - throughput cases with failed transactions or with throughput above the limit
+	 * of the line, frame split cases with unexpected result or without recovery
+	 */
+
+	size_t getFailures() const;
+
+	/**
+	 * \param [in] index is the index of frame split case, [0; frameSplitCases)
+	 *
+	 * \return result of frame split case with \a index
+	 */
+
+	const FrameSplit& getFrameSplit(const size_t index) const
+	{
+		return frameSplits_[index];
+	}
+
+	/**
+	 * \param [in] index is the index of throughput case, [0; throughputCases)
+	 *
+	 * \return result of throughput case with \a index
+	 */
+
+	const Throughput& getThroughput(const size_t index) const
+	{
+		return throughputs_[index];
+	}
+
+	/**
+	 * \brief Writes results as CSV - table of throughput followed by table of frame split cases, each with header
+	 * line.
+	 *
+	 * \tparam Writer is the type of \a writer, should be callable as int(const void* buffer, size_t size)
+	 *
+	 * \param [in] writer is a functor which writes the report, returns 0 on success, error code otherwise
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by \a writer;
+	 */
+
+	template<typename Writer>
+	int report(Writer writer) const
+	{
+		char line[maxLineLength];
+		for (size_t index {}; index < throughputCases + frameSplitCases + 2; ++index)
+		{
+			const auto size = formatLine(index, line);
+			const auto ret = writer(line, size);
+			if (ret != 0)
+				return ret;
+		}
+
+		return {};
+	}
+
+	/**
+	 * \brief Runs all cases.
+	 *
+	 * Each case starts with VirtualClock reset to its epoch, so results do not depend on previous runs.
+	 *
+	 * \param [in] transactions is the number of transactions of each throughput case
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a transactions is 0;
+	 * - EIO - serial port of slave could not be opened;
+	 * - error codes returned by SimulatedSerialLine::Endpoint::start();
+	 */
+
+	int run(uint32_t transactions);
+
+private:
+
+	/**
+	 * \brief Formats one line of report.
+	 *
+	 * \param [in] index is the index of line, 0 - header of throughput table, [1; throughputCases] - lines of
+	 * throughput cases, throughputCases + 1 - header of frame split table, following - lines of frame split cases
+	 * \param [out] line is the buffer for formatted line
+	 *
+	 * \return length of formatted line, bytes
+	 */
+
+	size_t formatLine(size_t index, char (&line)[maxLineLength]) const;
+
+	/// results of throughput cases
+	Throughput throughputs_[throughputCases];
+
+	/// results of frame split cases
+	FrameSplit frameSplits_[frameSplitCases];
+};
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_SERIALLINETEST_HPP_
@@ -0,0 +1,270 @@
+/**
+ * \file
+ * \brief SimulatedSerialLine class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "SimulatedSerialLine.hpp"
+
+#include "distortos/devices/communication/UartBase.hpp"
+
+#include "distortos/InterruptMaskingLock.hpp"
+
+#include <algorithm>
+
+#include <cerrno>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| SimulatedSerialLine::Endpoint's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+std::pair<int, uint32_t> SimulatedSerialLine::Endpoint::start(distortos::devices::UartBase& uartBase,
+		const uint32_t baudRate, const uint8_t characterLength, const distortos::devices::UartParity parity,
+		const bool _2StopBits)
+{
+	if (uartBase_ != nullptr)
+		return {EBADF, {}};
+
+	if (baudRate == 0 || characterLength < 5 || characterLength > 8)
+		return {EINVAL, {}};
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	baudRate_ = baudRate;
+	characterLength_ = characterLength;
+	parity_ = parity;
+	_2StopBits_ = _2StopBits;
+	uartBase_ = &uartBase;
+	return {{}, baudRate};
+}
+
+int SimulatedSerialLine::Endpoint::startRead(void* const buffer, const size_t size)
+{
+	if (buffer == nullptr || size == 0)
+		return EINVAL;
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	if (uartBase_ == nullptr)
+		return EBADF;
+
+	if (readBuffer_ != nullptr)
+		return EBUSY;
+
+	readBuffer_ = static_cast<uint8_t*>(buffer);
+	readPosition_ = {};
+	readSize_ = size;
+	return {};
+}
+
+int SimulatedSerialLine::Endpoint::startWrite(const void* const buffer, const size_t size)
+{
+	if (buffer == nullptr || size == 0)
+		return EINVAL;
+
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	if (uartBase_ == nullptr)
+		return EBADF;
+
+	if (writeBuffer_ != nullptr)
+		return EBUSY;
+
+	const TimePoint now {distortos::TickClock::now()};
+	if (line_.lastTransmitter_ == this)
+		writeStart_ = now < line_.lineFreeAt_ + distortos::TickClock::duration{1} ? line_.lineFreeAt_ : now;
+	else if (line_.lastTransmitter_ != nullptr)
+		writeStart_ = std::max(now, TimePoint{line_.lineFreeAt_ + line_.turnaroundDelay_});
+	else
+		writeStart_ = now;
+
+	writeBuffer_ = static_cast<const uint8_t*>(buffer);
+	writePosition_ = {};
+	writeSize_ = size;
+	line_.lineFreeAt_ = writeStart_ + getTransmissionDuration(baudRate_, characterLength_, parity_, _2StopBits_,
+			line_.gapBits_, size);
+	line_.lastTransmitter_ = this;
+
+	uartBase_->transmitStartEvent();
+	line_.schedule();
+	return {};
+}
+
+int SimulatedSerialLine::Endpoint::stop()
+{
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	if (uartBase_ == nullptr)
+		return EBADF;
+
+	if (readBuffer_ != nullptr || writeBuffer_ != nullptr)
+		return EBUSY;
+
+	uartBase_ = {};
+	return {};
+}
+
+size_t SimulatedSerialLine::Endpoint::stopRead()
+{
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	const auto bytesRead = readPosition_;
+	readBuffer_ = {};
+	readPosition_ = {};
+	readSize_ = {};
+	return bytesRead;
+}
+
+size_t SimulatedSerialLine::Endpoint::stopWrite()
+{
+	const distortos::InterruptMaskingLock interruptMaskingLock;
+
+	if (writeBuffer_ == nullptr)
+		return {};
+
+	const auto bytesWritten = writePosition_;
+	// line becomes idle right after last character which was delivered
+	if (line_.lastTransmitter_ == this)
+		line_.lineFreeAt_ = writeStart_ + getTransmissionDuration(baudRate_, characterLength_, parity_, _2StopBits_,
+				line_.gapBits_, bytesWritten);
+	writeBuffer_ = {};
+	writePosition_ = {};
+	writeSize_ = {};
+	line_.schedule();
+	return bytesWritten;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| SimulatedSerialLine::Endpoint's private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+distortos::TickClock::time_point SimulatedSerialLine::Endpoint::getArrivalTime(const size_t index) const
+{
+	const auto arrival = writeStart_ + getTransmissionDuration(baudRate_, characterLength_, parity_, _2StopBits_,
+			line_.gapBits_, index + 1);
+	const auto tick = std::chrono::time_point_cast<distortos::TickClock::duration>(arrival);
+	return tick < arrival ? tick + distortos::TickClock::duration{1} : tick;
+}
+
+SimulatedSerialLine::Endpoint& SimulatedSerialLine::Endpoint::getPeer() const
+{
+	return &line_.master_ == this ? line_.slave_ : line_.master_;
+}
+
+void SimulatedSerialLine::Endpoint::receive(const Endpoint& transmitter, const uint8_t character)
+{
+	if (uartBase_ == nullptr)
+		return;
+
+	if (transmitter.baudRate_ != baudRate_ || transmitter.characterLength_ != characterLength_ ||
+			transmitter.parity_ != parity_ || transmitter._2StopBits_ != _2StopBits_)
+	{
+		distortos::devices::UartBase::ErrorSet errorSet;
+		errorSet.set(distortos::devices::UartBase::framingError);
+		uartBase_->receiveErrorEvent(errorSet);
+		return;
+	}
+
+	if (readBuffer_ == nullptr)
+	{
+		distortos::devices::UartBase::ErrorSet errorSet;
+		errorSet.set(distortos::devices::UartBase::overrunError);
+		uartBase_->receiveErrorEvent(errorSet);
+		return;
+	}
+
+	readBuffer_[readPosition_++] = character & ((1u << characterLength_) - 1);
+	if (readPosition_ != readSize_)
+		return;
+
+	const auto bytesRead = readPosition_;
+	readBuffer_ = {};
+	readPosition_ = {};
+	readSize_ = {};
+	// SerialPort starts next read from this callback
+	uartBase_->readCompleteEvent(bytesRead);
+}
+
+void SimulatedSerialLine::Endpoint::transmit(const distortos::TickClock::time_point now)
+{
+	while (writeBuffer_ != nullptr && writePosition_ < writeSize_ && getArrivalTime(writePosition_) <= now)
+	{
+		const auto character = writeBuffer_[writePosition_];
+		++writePosition_;
+		getPeer().receive(*this, character);
+	}
+
+	if (writeBuffer_ == nullptr || writePosition_ != writeSize_)
+		return;
+
+	const auto bytesWritten = writeSize_;
+	writeBuffer_ = {};
+	writePosition_ = {};
+	writeSize_ = {};
+	// SerialPort starts next write from this callback
+	uartBase_->writeCompleteEvent(bytesWritten);
+	if (writeBuffer_ == nullptr)
+		uartBase_->transmitCompleteEvent();
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+SimulatedSerialLine::SimulatedSerialLine(const distortos::TickClock::duration turnaroundDelay, const uint8_t gapBits) :
+		timer_{&SimulatedSerialLine::deliver, this},
+		lineFreeAt_{},
+		turnaroundDelay_{turnaroundDelay},
+		master_{*this},
+		slave_{*this},
+		lastTransmitter_{},
+		gapBits_{gapBits}
+{
+
+}
+
+std::chrono::nanoseconds SimulatedSerialLine::getTransmissionDuration(const uint32_t baudRate,
+		const uint8_t characterLength, const distortos::devices::UartParity parity, const bool _2StopBits,
+		const uint8_t gapBits, const size_t size)
+{
+	if (baudRate == 0 || size == 0)
+		return {};
+
+	// start bit, data bits, optional parity bit and stop bits
+	const uint64_t characterBits = 1 + characterLength + (parity != distortos::devices::UartParity::none) +
+			(_2StopBits == true ? 2 : 1);
+	const uint64_t bits = size * characterBits + (size - 1) * gapBits;
+	// rounded up, so that no character arrives before its last bit
+	return std::chrono::nanoseconds{(bits * 1000000000 + baudRate - 1) / baudRate};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SimulatedSerialLine::deliver()
+{
+	const auto now = distortos::TickClock::now();
+	master_.transmit(now);
+	slave_.transmit(now);
+	schedule();
+}
+
+void SimulatedSerialLine::schedule()
+{
+	auto next = distortos::TickClock::time_point::max();
+	if (master_.writeBuffer_ != nullptr)
+		next = std::min(next, master_.getArrivalTime(master_.writePosition_));
+	if (slave_.writeBuffer_ != nullptr)
+		next = std::min(next, slave_.getArrivalTime(slave_.writePosition_));
+
+	if (next == distortos::TickClock::time_point::max())
+		timer_.stop();
+	else
+		timer_.start(next);
+}
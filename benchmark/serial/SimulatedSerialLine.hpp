@@ -0,0 +1,319 @@
+/**
+ * \file
+ * \brief SimulatedSerialLine class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_SIMULATEDSERIALLINE_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_SIMULATEDSERIALLINE_HPP_
+
+#include "distortos/devices/communication/UartLowLevel.hpp"
+
+#include "distortos/DynamicSoftwareTimer.hpp"
+
+/**
+ * SimulatedSerialLine is a half-duplex serial line with two UART endpoints, which delivers characters with timing of
+ * real line.
+ *
+ * Each endpoint implements distortos::devices::UartLowLevel, so it is used as low-level driver of regular
+ * distortos::devices::SerialPort - the instance and its poll functions work unchanged. Character written by one
+ * endpoint is received by the other one when its last bit would arrive - character duration follows from baud rate,
+ * character length, parity and stop bits of transmitter. Additionally the line models:
+ * - idle gap between consecutive characters of one transmission (in bit times), which allows checking T1.5 handling;
+ * - bus turnaround - minimal delay between end of transmission of one endpoint and start of transmission of the other
+ * one, like with RS-485 driver enable;
+ * - transmissions never overlap - transmission started while the line is busy is delayed until the line is idle;
+ * - character received by endpoint with different configuration is dropped with framing error, character received by
+ * endpoint which has no read in progress is dropped with overrun error.
+ *
+ * All timing is expressed in TickClock time points and no wall clock is involved, so results depend only on the
+ * sequence of operations - on a simulated target they are fully repeatable. Characters are delivered from software
+ * timer with tick resolution, so all characters which arrived during one tick are received in the same tick, just like
+ * with DMA-driven UART polled by freemodbusSerialPoll(). The line is a part of the test suite in benchmark/serial and
+ * is not built into FreeMODBUS-integration library - it runs there on VirtualClock and the suite measures throughput
+ * and handling of split frames.
+ *
+ * \code
+ * SimulatedSerialLine line {std::chrono::milliseconds{1}, 0};
+ * distortos::devices::SerialPort masterPort {line.getMaster(), ...};
+ * distortos::devices::SerialPort slavePort {line.getSlave(), ...};
+ * // one transaction of reading 10 holding registers at 19200 baud, 8E1
+ * const auto duration = SimulatedSerialLine::getTransmissionDuration(19200, 8, UartParity::even, false, 0, 8) +
+ *         SimulatedSerialLine::getTransmissionDuration(19200, 8, UartParity::even, false, 0, 25);
+ * \endcode
+ */
+
+class SimulatedSerialLine
+{
+public:
+
+	/// Endpoint is one side of the line, usable as low-level driver of distortos::devices::SerialPort
+	class Endpoint : public distortos::devices::UartLowLevel
+	{
+	public:
+
+		/**
+		 * \brief Endpoint's constructor
+		 *
+		 * \param [in] linee is a reference to SimulatedSerialLine which owns this endpoint
+		 */
+
+		constexpr explicit Endpoint(SimulatedSerialLine& linee) :
+				writeStart_{},
+				line_{linee},
+				uartBase_{},
+				readBuffer_{},
+				readPosition_{},
+				readSize_{},
+				writeBuffer_{},
+				writePosition_{},
+				writeSize_{},
+				baudRate_{},
+				characterLength_{},
+				parity_{},
+				_2StopBits_{}
+		{
+
+		}
+
+		/**
+		 * \brief Starts endpoint.
+		 *
+		 * \param [in] uartBase is a reference to UartBase object which will be notified about completed transfers
+		 * \param [in] baudRate is the desired baud rate, bps
+		 * \param [in] characterLength selects character length, bits, [5; 8]
+		 * \param [in] parity selects parity
+		 * \param [in] _2StopBits selects whether 1 (false) or 2 (true) stop bits are used
+		 *
+		 * \return pair with return code (0 on success, error code otherwise) and real baud rate (always equal to
+		 * \a baudRate); error codes:
+		 * - EBADF - endpoint is already started;
+		 * - EINVAL - selected baud rate and/or format are invalid;
+		 */
+
+		std::pair<int, uint32_t> start(distortos::devices::UartBase& uartBase, uint32_t baudRate,
+				uint8_t characterLength, distortos::devices::UartParity parity, bool _2StopBits) override;
+
+		/**
+		 * \brief Starts asynchronous read operation.
+		 *
+		 * \param [out] buffer is the buffer to which the data will be written
+		 * \param [in] size is the size of \a buffer, bytes
+		 *
+		 * \return 0 on success, error code otherwise:
+		 * - EBADF - endpoint is not started;
+		 * - EBUSY - read is in progress;
+		 * - EINVAL - \a buffer and/or \a size are invalid;
+		 */
+
+		int startRead(void* buffer, size_t size) override;
+
+		/**
+		 * \brief Starts asynchronous write operation.
+		 *
+		 * Write started in the same tick in which previous write of this endpoint ended continues its transmission
+		 * without any gap, so writes split by SerialPort are seen by the other endpoint as one frame.
+		 *
+		 * \param [in] buffer is the buffer with data that will be transmitted
+		 * \param [in] size is the size of \a buffer, bytes
+		 *
+		 * \return 0 on success, error code otherwise:
+		 * - EBADF - endpoint is not started;
+		 * - EBUSY - write is in progress;
+		 * - EINVAL - \a buffer and/or \a size are invalid;
+		 */
+
+		int startWrite(const void* buffer, size_t size) override;
+
+		/**
+		 * \brief Stops endpoint.
+		 *
+		 * \return 0 on success, error code otherwise:
+		 * - EBADF - endpoint is not started;
+		 * - EBUSY - read and/or write are in progress;
+		 */
+
+		int stop() override;
+
+		/**
+		 * \brief Stops asynchronous read operation.
+		 *
+		 * \return number of bytes already read by endpoint in last read operation
+		 */
+
+		size_t stopRead() override;
+
+		/**
+		 * \brief Stops asynchronous write operation.
+		 *
+		 * \return number of bytes already written by endpoint in last write operation
+		 */
+
+		size_t stopWrite() override;
+
+	private:
+
+		friend class SimulatedSerialLine;
+
+		/// time point with resolution finer than tick, used for exact character timing
+		using TimePoint = std::chrono::time_point<distortos::TickClock, std::chrono::nanoseconds>;
+
+		/**
+		 * \param [in] index is the index of character in current write
+		 *
+		 * \return first tick in which character with \a index is completely received by the other endpoint
+		 */
+
+		distortos::TickClock::time_point getArrivalTime(size_t index) const;
+
+		/**
+		 * \return reference to the other endpoint of the line
+		 */
+
+		Endpoint& getPeer() const;
+
+		/**
+		 * \brief Receives one character transmitted by the other endpoint.
+		 *
+		 * \param [in] transmitter is a reference to the other endpoint
+		 * \param [in] character is the received character
+		 */
+
+		void receive(const Endpoint& transmitter, uint8_t character);
+
+		/**
+		 * \brief Delivers all characters of current write which arrived until given time point.
+		 *
+		 * \param [in] now is the current time point
+		 */
+
+		void transmit(distortos::TickClock::time_point now);
+
+		/// time point at which first character of current write starts
+		TimePoint writeStart_;
+
+		/// reference to SimulatedSerialLine which owns this endpoint
+		SimulatedSerialLine& line_;
+
+		/// pointer to UartBase object associated with this endpoint, nullptr if endpoint is not started
+		distortos::devices::UartBase* uartBase_;
+
+		/// buffer of current read, nullptr if no read is in progress
+		uint8_t* readBuffer_;
+
+		/// number of bytes already read in current read
+		size_t readPosition_;
+
+		/// size of readBuffer_, bytes
+		size_t readSize_;
+
+		/// buffer of current write, nullptr if no write is in progress
+		const uint8_t* writeBuffer_;
+
+		/// number of bytes already delivered to the other endpoint in current write
+		size_t writePosition_;
+
+		/// size of writeBuffer_, bytes
+		size_t writeSize_;
+
+		/// baud rate, bps
+		uint32_t baudRate_;
+
+		/// character length, bits
+		uint8_t characterLength_;
+
+		/// parity
+		distortos::devices::UartParity parity_;
+
+		/// selects whether 1 (false) or 2 (true) stop bits are used
+		bool _2StopBits_;
+	};
+
+	/**
+	 * \brief SimulatedSerialLine's constructor
+	 *
+	 * \param [in] turnaroundDelay is the minimal delay between end of transmission of one endpoint and start of
+	 * transmission of the other one
+	 * \param [in] gapBits is the duration of idle gap between consecutive characters of one transmission, bit times
+	 */
+
+	SimulatedSerialLine(distortos::TickClock::duration turnaroundDelay, uint8_t gapBits);
+
+	/**
+	 * \return reference to master endpoint of the line
+	 */
+
+	Endpoint& getMaster()
+	{
+		return master_;
+	}
+
+	/**
+	 * \return reference to slave endpoint of the line
+	 */
+
+	Endpoint& getSlave()
+	{
+		return slave_;
+	}
+
+	/**
+	 * \brief Calculates duration of transmission of characters on serial line.
+	 *
+	 * \param [in] baudRate is the baud rate, bps
+	 * \param [in] characterLength is the character length, bits
+	 * \param [in] parity is the parity
+	 * \param [in] _2StopBits selects whether 1 (false) or 2 (true) stop bits are used
+	 * \param [in] gapBits is the duration of idle gap between consecutive characters, bit times
+	 * \param [in] size is the number of characters
+	 *
+	 * \return duration from start bit of first character to the end of last stop bit of last character
+	 */
+
+	static std::chrono::nanoseconds getTransmissionDuration(uint32_t baudRate, uint8_t characterLength,
+			distortos::devices::UartParity parity, bool _2StopBits, uint8_t gapBits, size_t size);
+
+private:
+
+	/**
+	 * \brief Delivers characters which arrived and schedules the next delivery.
+	 *
+	 * Called from software timer.
+	 */
+
+	void deliver();
+
+	/**
+	 * \brief Starts software timer for arrival of the next character or stops it if no write is in progress.
+	 */
+
+	void schedule();
+
+	/// software timer which delivers characters
+	distortos::DynamicSoftwareTimer timer_;
+
+	/// time point at which last started transmission ends
+	Endpoint::TimePoint lineFreeAt_;
+
+	/// minimal delay between end of transmission of one endpoint and start of transmission of the other one
+	distortos::TickClock::duration turnaroundDelay_;
+
+	/// master endpoint
+	Endpoint master_;
+
+	/// slave endpoint
+	Endpoint slave_;
+
+	/// endpoint which started last transmission, nullptr if none
+	const Endpoint* lastTransmitter_;
+
+	/// duration of idle gap between consecutive characters of one transmission, bit times
+	uint8_t gapBits_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_SIMULATEDSERIALLINE_HPP_
@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \brief VirtualClock class implementation, distortos::TickClock and distortos::ThisThread of host test suite
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "VirtualClock.hpp"
+
+#include "distortos/ThisThread.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| VirtualClock::Timer's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void VirtualClock::Timer::start(const distortos::TickClock::time_point expirationTime)
+{
+	stop();
+
+	expirationTime_ = expirationTime;
+	running_ = true;
+	// appended, so timers with the same expiration time are run in the order of starting
+	auto link = &timers_;
+	while (*link != nullptr)
+		link = &(*link)->next_;
+	*link = this;
+}
+
+void VirtualClock::Timer::stop()
+{
+	if (running_ == false)
+		return;
+
+	auto link = &timers_;
+	while (*link != this)
+		link = &(*link)->next_;
+	*link = next_;
+	next_ = {};
+	running_ = false;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public static functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void VirtualClock::reset()
+{
+	assert(timers_ == nullptr);
+
+	now_ = {};
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private static functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool VirtualClock::runNextTimer(const distortos::TickClock::time_point deadline)
+{
+	Timer* earliest {};
+	for (auto timer = timers_; timer != nullptr; timer = timer->next_)
+		if (timer->expirationTime_ <= deadline &&
+				(earliest == nullptr || timer->expirationTime_ < earliest->expirationTime_))
+			earliest = timer;
+
+	if (earliest == nullptr)
+		return false;
+
+	now_ = std::max(now_, earliest->expirationTime_);
+	earliest->stop();
+	// the function may restart the timer
+	earliest->function_();
+	return true;
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private static objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+distortos::TickClock::time_point VirtualClock::now_;
+
+VirtualClock::Timer* VirtualClock::timers_;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+namespace distortos
+{
+
+TickClock::time_point TickClock::now()
+{
+	return VirtualClock::now();
+}
+
+namespace ThisThread
+{
+
+int sleepFor(const TickClock::duration duration)
+{
+	// just like distortos - one tick is added, so the sleep is never shorter than requested
+	return sleepUntil(TickClock::now() + duration + TickClock::duration{1});
+}
+
+int sleepUntil(const TickClock::time_point timePoint)
+{
+	VirtualClock::advanceUntil(timePoint,
+			[]()
+			{
+				return false;
+			});
+	return 0;
+}
+
+}	// namespace ThisThread
+
+}	// namespace distortos
@@ -0,0 +1,177 @@
+/**
+ * \file
+ * \brief VirtualClock class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUALCLOCK_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUALCLOCK_HPP_
+
+#include "distortos/TickClock.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include <cassert>
+
+/**
+ * VirtualClock is the simulated time of host test suite of serial line.
+ *
+ * distortos::TickClock, distortos::ThisThread, distortos::DynamicSoftwareTimer and distortos::devices::SerialPort of
+ * the suite (headers in virtual/) are implemented with this clock, so the poll functions of the port layer and
+ * SimulatedSerialLine are compiled and run unchanged. The suite has only one thread and time passes only when this
+ * thread would block - blocking call advances the clock to the expiration time of the earliest software timer and runs
+ * its function, until the condition of the call is satisfied or its deadline is reached. Results depend only on the
+ * sequence of operations, never on the speed of the host.
+ */
+
+class VirtualClock
+{
+public:
+
+	/// Timer is a software timer run by the clock
+	class Timer
+	{
+	public:
+
+		/**
+		 * \brief Timer's constructor
+		 *
+		 * \param [in] functionn is the function which is run when the timer expires
+		 */
+
+		explicit Timer(std::function<void()> functionn) :
+				function_{std::move(functionn)},
+				expirationTime_{},
+				next_{},
+				running_{}
+		{
+
+		}
+
+		/**
+		 * \brief Timer's destructor
+		 *
+		 * Stops the timer.
+		 */
+
+		~Timer()
+		{
+			stop();
+		}
+
+		/**
+		 * \return true if the timer is running, false otherwise
+		 */
+
+		bool isRunning() const
+		{
+			return running_;
+		}
+
+		/**
+		 * \brief Starts the timer, restarts it if it is already running.
+		 *
+		 * \param [in] expirationTime is the time point at which the timer expires, time point in the past makes it
+		 * expire with the next advance of the clock
+		 */
+
+		void start(distortos::TickClock::time_point expirationTime);
+
+		/**
+		 * \brief Stops the timer.
+		 */
+
+		void stop();
+
+	private:
+
+		friend class VirtualClock;
+
+		/// function which is run when the timer expires
+		std::function<void()> function_;
+
+		/// time point at which the timer expires
+		distortos::TickClock::time_point expirationTime_;
+
+		/// next running timer, nullptr if this is the last one
+		Timer* next_;
+
+		/// true if the timer is running, false otherwise
+		bool running_;
+	};
+
+	VirtualClock() = delete;
+
+	/**
+	 * \brief Advances the clock until condition is satisfied or deadline is reached.
+	 *
+	 * Expired timers are run one by one, in the order of their expiration times, and the condition is checked after
+	 * each of them. If no timer expires until \a deadline, the clock is advanced to \a deadline.
+	 *
+	 * \tparam Condition is the type of \a condition, should be callable as bool()
+	 *
+	 * \param [in] deadline is the deadline of advance, must not be distortos::TickClock::time_point::max() unless
+	 * \a condition is eventually satisfied by a timer
+	 * \param [in] condition is a functor which returns true when advance should stop
+	 *
+	 * \return value of \a condition at the end of advance
+	 */
+
+	template<typename Condition>
+	static bool advanceUntil(const distortos::TickClock::time_point deadline, Condition condition)
+	{
+		while (condition() == false)
+			if (runNextTimer(deadline) == false)
+			{
+				assert(deadline != distortos::TickClock::time_point::max() && "Simulation deadlocked!");
+				now_ = std::max(now_, deadline);
+				return condition();
+			}
+
+		return true;
+	}
+
+	/**
+	 * \return current time point of the clock
+	 */
+
+	static distortos::TickClock::time_point now()
+	{
+		return now_;
+	}
+
+	/**
+	 * \brief Resets the clock to its epoch.
+	 *
+	 * Must be called only when no timer is running.
+	 */
+
+	static void reset();
+
+private:
+
+	/**
+	 * \brief Runs the earliest timer which expires until deadline, advancing the clock to its expiration time.
+	 *
+	 * \param [in] deadline is the deadline of advance
+	 *
+	 * \return true if a timer was run, false otherwise
+	 */
+
+	static bool runNextTimer(distortos::TickClock::time_point deadline);
+
+	/// current time point of the clock
+	static distortos::TickClock::time_point now_;
+
+	/// list of running timers, in the order of starting
+	static Timer* timers_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUALCLOCK_HPP_
@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \brief Main code block of host test suite of serial line
+ *
+ * Usage: FreeMODBUS-integration-serial-line-test [transactions]
+ *
+ * All cases are run twice and both reports must be identical, so any dependency on the host (real time, scheduling,
+ * uninitialized memory) is detected as a failure.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "SerialLineTest.hpp"
+
+#include <string>
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// default number of transactions of each throughput case
+constexpr uint32_t defaultTransactions {100};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Runs all cases and writes the report to string.
+ *
+ * \param [in] transactions is the number of transactions of each throughput case
+ * \param [out] report is a reference to string to which the report will be appended
+ * \param [out] failures is a reference to variable for number of failed checks
+ *
+ * \return 0 on success, error code otherwise:
+ * - error codes returned by SerialLineTest::report();
+ * - error codes returned by SerialLineTest::run();
+ */
+
+int runTest(const uint32_t transactions, std::string& report, size_t& failures)
+{
+	SerialLineTest test;
+	const auto ret = test.run(transactions);
+	if (ret != 0)
+		return ret;
+
+	failures = test.getFailures();
+	return test.report([&report](const void* const buffer, const size_t size)
+			{
+				report.append(static_cast<const char*>(buffer), size);
+				return 0;
+			});
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Main code block of host test suite of serial line
+ *
+ * \param [in] argc is the number of arguments
+ * \param [in] argv is an array with arguments, optional first one is the number of transactions of each throughput
+ * case
+ *
+ * \return EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+
+int main(const int argc, char* const argv[])
+{
+	const auto transactions = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : defaultTransactions;
+
+	std::string report;
+	size_t failures {};
+	auto ret = runTest(transactions, report, failures);
+	if (ret != 0)
+	{
+		fprintf(stderr, "SerialLineTest failed: %d\n", ret);
+		return EXIT_FAILURE;
+	}
+
+	if (fwrite(report.data(), 1, report.size(), stdout) != report.size())
+		return EXIT_FAILURE;
+
+	std::string repeatedReport;
+	size_t repeatedFailures {};
+	ret = runTest(transactions, repeatedReport, repeatedFailures);
+	if (ret != 0)
+	{
+		fprintf(stderr, "Repeated SerialLineTest failed: %d\n", ret);
+		return EXIT_FAILURE;
+	}
+
+	if (repeatedReport != report)
+	{
+		fprintf(stderr, "Results of repeated run differ, the test is not deterministic\n");
+		return EXIT_FAILURE;
+	}
+
+	if (failures != 0)
+	{
+		fprintf(stderr, "%zu check(s) failed\n", failures);
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
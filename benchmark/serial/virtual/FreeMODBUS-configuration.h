@@ -0,0 +1,23 @@
+/**
+ * \file
+ * \brief FreeMODBUS configuration of host test suite of serial line
+ *
+ * Only Modbus RTU is enabled, the suite does not need lwIP.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_FREEMODBUS_CONFIGURATION_H_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_FREEMODBUS_CONFIGURATION_H_
+
+#define MB_ASCII_ENABLED	0
+#define MB_RTU_ENABLED		1
+#define MB_TCP_ENABLED		0
+
+#define MB_SER_SIZE_MAX		256
+
+#endif	/* FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_FREEMODBUS_CONFIGURATION_H_ */
@@ -0,0 +1,173 @@
+/**
+ * \file
+ * \brief SerialPort class implementation of host test suite of serial line
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "distortos/devices/communication/SerialPort.hpp"
+
+#include "VirtualClock.hpp"
+
+#include <algorithm>
+
+#include <cerrno>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int SerialPort::close()
+{
+	if (open_ == false)
+		return EBADF;
+
+	VirtualClock::advanceUntil(TickClock::time_point::max(),
+			[this]()
+			{
+				return writeCount_ == 0 && transmitting_ == false;
+			});
+
+	uart_.stopRead();
+	uart_.stop();
+	readBegin_ = {};
+	readCount_ = {};
+	open_ = false;
+	return 0;
+}
+
+int SerialPort::open(const uint32_t baudRate, const uint8_t characterLength, const UartParity parity,
+		const bool _2StopBits)
+{
+	if (open_ == true)
+		return EBADF;
+
+	const auto ret = uart_.start(*this, baudRate, characterLength, parity, _2StopBits);
+	if (ret.first != 0)
+		return ret.first;
+
+	open_ = true;
+	return uart_.startRead(&readCharacter_, sizeof(readCharacter_));
+}
+
+std::pair<int, size_t> SerialPort::tryReadUntil(const TickClock::time_point timePoint, void* const buffer,
+		const size_t size, const size_t minSize)
+{
+	if (open_ == false)
+		return {EBADF, {}};
+
+	const auto required = std::min(size, minSize);
+	VirtualClock::advanceUntil(timePoint,
+			[this, required]()
+			{
+				return readCount_ >= required;
+			});
+
+	const auto bytesRead = std::min(size, readCount_);
+	for (size_t i {}; i < bytesRead; ++i)
+		static_cast<uint8_t*>(buffer)[i] = readBuffer_[(readBegin_ + i) % readBufferSize_];
+	readBegin_ = (readBegin_ + bytesRead) % readBufferSize_;
+	readCount_ -= bytesRead;
+	return {bytesRead >= required ? 0 : ETIMEDOUT, bytesRead};
+}
+
+std::pair<int, size_t> SerialPort::tryWriteUntil(const TickClock::time_point timePoint, const void* const buffer,
+		const size_t size, const size_t minSize)
+{
+	if (open_ == false)
+		return {EBADF, {}};
+
+	const auto required = std::min(size, minSize);
+	size_t bytesWritten {};
+	while (1)
+	{
+		while (bytesWritten < size && writeCount_ < writeBufferSize_)
+		{
+			writeBuffer_[(writeBegin_ + writeCount_) % writeBufferSize_] =
+					static_cast<const uint8_t*>(buffer)[bytesWritten++];
+			++writeCount_;
+		}
+
+		startWrite();
+
+		if (bytesWritten >= required)
+			return {{}, bytesWritten};
+		if (TickClock::now() >= timePoint)
+			return {ETIMEDOUT, bytesWritten};
+
+		VirtualClock::advanceUntil(timePoint,
+				[this]()
+				{
+					return writeCount_ < writeBufferSize_;
+				});
+	}
+}
+
+std::pair<int, size_t> SerialPort::write(const void* const buffer, const size_t size)
+{
+	return tryWriteUntil(TickClock::time_point::max(), buffer, size);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+void SerialPort::readCompleteEvent(const size_t bytesRead)
+{
+	if (bytesRead != 0)
+	{
+		if (readCount_ == readBufferSize_)
+			++receiveErrors_;
+		else
+			readBuffer_[(readBegin_ + readCount_++) % readBufferSize_] = readCharacter_;
+	}
+
+	uart_.startRead(&readCharacter_, sizeof(readCharacter_));
+}
+
+void SerialPort::receiveErrorEvent(ErrorSet)
+{
+	++receiveErrors_;
+}
+
+void SerialPort::startWrite()
+{
+	if (writeInProgress_ != 0 || writeCount_ == 0)
+		return;
+
+	writeInProgress_ = std::min(writeCount_, writeBufferSize_ - writeBegin_);
+	uart_.startWrite(&writeBuffer_[writeBegin_], writeInProgress_);
+}
+
+void SerialPort::transmitCompleteEvent()
+{
+	transmitting_ = false;
+}
+
+void SerialPort::transmitStartEvent()
+{
+	transmitting_ = true;
+}
+
+void SerialPort::writeCompleteEvent(const size_t bytesWritten)
+{
+	writeBegin_ = (writeBegin_ + bytesWritten) % writeBufferSize_;
+	writeCount_ -= bytesWritten;
+	writeInProgress_ = {};
+	// started from this callback, so the transmission continues without a gap
+	startWrite();
+}
+
+}	// namespace devices
+
+}	// namespace distortos
@@ -0,0 +1,101 @@
+/**
+ * \file
+ * \brief DynamicSoftwareTimer class header of host test suite of serial line
+ *
+ * Replacement of distortos::DynamicSoftwareTimer which is run by VirtualClock.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DYNAMICSOFTWARETIMER_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DYNAMICSOFTWARETIMER_HPP_
+
+#include "VirtualClock.hpp"
+
+namespace distortos
+{
+
+/// DynamicSoftwareTimer is a one-shot software timer run by VirtualClock
+class DynamicSoftwareTimer
+{
+public:
+
+	/**
+	 * \brief DynamicSoftwareTimer's constructor
+	 *
+	 * \tparam Function is the function that will be executed from the timer
+	 * \tparam Args are the arguments for \a Function
+	 *
+	 * \param [in] function is a function that will be executed from the timer
+	 * \param [in] args are arguments for \a function
+	 */
+
+	template<typename Function, typename... Args>
+	explicit DynamicSoftwareTimer(Function&& function, Args&&... args) :
+			timer_{std::bind(std::forward<Function>(function), std::forward<Args>(args)...)}
+	{
+
+	}
+
+	/**
+	 * \return true if the timer is running, false otherwise
+	 */
+
+	bool isRunning() const
+	{
+		return timer_.isRunning();
+	}
+
+	/**
+	 * \brief Starts the timer.
+	 *
+	 * \param [in] timePoint is the time point at which the function will be executed
+	 *
+	 * \return 0 on success
+	 */
+
+	int start(const TickClock::time_point timePoint)
+	{
+		timer_.start(timePoint);
+		return 0;
+	}
+
+	/**
+	 * \brief Starts the timer.
+	 *
+	 * \param [in] duration is the duration after which the function will be executed
+	 *
+	 * \return 0 on success
+	 */
+
+	int start(const TickClock::duration duration)
+	{
+		// just like distortos - one tick is added, so the delay is never shorter than requested
+		return start(TickClock::now() + duration + TickClock::duration{1});
+	}
+
+	/**
+	 * \brief Stops the timer.
+	 *
+	 * \return 0 on success
+	 */
+
+	int stop()
+	{
+		timer_.stop();
+		return 0;
+	}
+
+private:
+
+	/// timer of VirtualClock
+	VirtualClock::Timer timer_;
+};
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DYNAMICSOFTWARETIMER_HPP_
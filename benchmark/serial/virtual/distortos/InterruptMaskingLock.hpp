@@ -0,0 +1,51 @@
+/**
+ * \file
+ * \brief InterruptMaskingLock class header of host test suite of serial line
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_INTERRUPTMASKINGLOCK_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_INTERRUPTMASKINGLOCK_HPP_
+
+namespace distortos
+{
+
+/// InterruptMaskingLock does nothing - "interrupts" of the suite are timers of VirtualClock, run by its only thread
+class InterruptMaskingLock
+{
+public:
+
+	/**
+	 * \brief InterruptMaskingLock's constructor
+	 *
+	 * User-provided, so the lock is not reported as unused variable, just like the one of distortos.
+	 */
+
+	InterruptMaskingLock()
+	{
+
+	}
+
+	/**
+	 * \brief InterruptMaskingLock's destructor
+	 */
+
+	~InterruptMaskingLock()
+	{
+
+	}
+
+	InterruptMaskingLock(const InterruptMaskingLock&) = delete;
+	InterruptMaskingLock(InterruptMaskingLock&&) = delete;
+	const InterruptMaskingLock& operator=(const InterruptMaskingLock&) = delete;
+	InterruptMaskingLock& operator=(InterruptMaskingLock&&) = delete;
+};
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_INTERRUPTMASKINGLOCK_HPP_
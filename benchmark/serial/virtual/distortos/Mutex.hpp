@@ -0,0 +1,81 @@
+/**
+ * \file
+ * \brief Mutex class header of host test suite of serial line
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_MUTEX_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_MUTEX_HPP_
+
+#include <cstdint>
+
+namespace distortos
+{
+
+/// Mutex is never contended - the suite has only one thread
+class Mutex
+{
+public:
+
+	/// type of mutex
+	enum class Type : uint8_t
+	{
+		/// normal mutex
+		normal,
+		/// mutex with additional error checking
+		errorChecking,
+		/// recursive mutex
+		recursive,
+	};
+
+	/// priority protocol of mutex
+	enum class Protocol : uint8_t
+	{
+		/// no priority protocol
+		none,
+		/// priority inheritance protocol
+		priorityInheritance,
+		/// priority protection protocol
+		priorityProtect,
+	};
+
+	/**
+	 * \brief Mutex's constructor
+	 */
+
+	constexpr explicit Mutex(Type = Type::normal, Protocol = Protocol::none, uint8_t = {})
+	{
+
+	}
+
+	/**
+	 * \brief Locks the mutex.
+	 *
+	 * \return 0 on success
+	 */
+
+	int lock()
+	{
+		return 0;
+	}
+
+	/**
+	 * \brief Unlocks the mutex.
+	 *
+	 * \return 0 on success
+	 */
+
+	int unlock()
+	{
+		return 0;
+	}
+};
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_MUTEX_HPP_
@@ -0,0 +1,118 @@
+/**
+ * \file
+ * \brief Semaphore class header of host test suite of serial line
+ *
+ * Replacement of distortos::Semaphore, waiting advances VirtualClock.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_SEMAPHORE_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_SEMAPHORE_HPP_
+
+#include "VirtualClock.hpp"
+
+#include <climits>
+#include <cerrno>
+
+namespace distortos
+{
+
+/// Semaphore is a counting semaphore, which may be posted only from timers of VirtualClock or by the waiting thread
+class Semaphore
+{
+public:
+
+	/// type used for semaphore's "value"
+	using Value = unsigned int;
+
+	/**
+	 * \brief Semaphore's constructor
+	 *
+	 * \param [in] value is the initial value of the semaphore
+	 * \param [in] maxValue is the max value of the semaphore
+	 */
+
+	constexpr explicit Semaphore(const Value value, const Value maxValue = UINT_MAX) :
+			value_{value < maxValue ? value : maxValue},
+			maxValue_{maxValue}
+	{
+
+	}
+
+	/**
+	 * \return current value of semaphore
+	 */
+
+	Value getValue() const
+	{
+		return value_;
+	}
+
+	/**
+	 * \brief Unlocks the semaphore.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EOVERFLOW - the max value of semaphore would be exceeded;
+	 */
+
+	int post()
+	{
+		if (value_ == maxValue_)
+			return EOVERFLOW;
+
+		++value_;
+		return 0;
+	}
+
+	/**
+	 * \brief Tries to lock the semaphore.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EAGAIN - semaphore is already locked;
+	 */
+
+	int tryWait()
+	{
+		if (value_ == 0)
+			return EAGAIN;
+
+		--value_;
+		return 0;
+	}
+
+	/**
+	 * \brief Tries to lock the semaphore until given time point, advancing VirtualClock.
+	 *
+	 * \param [in] timePoint is the time point at which the call will be terminated without locking the semaphore
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ETIMEDOUT - no timer unlocked the semaphore before the specified time point;
+	 */
+
+	int tryWaitUntil(const TickClock::time_point timePoint)
+	{
+		VirtualClock::advanceUntil(timePoint,
+				[this]()
+				{
+					return value_ != 0;
+				});
+		return tryWait() == 0 ? 0 : ETIMEDOUT;
+	}
+
+private:
+
+	/// current value of the semaphore
+	Value value_;
+
+	/// max value of the semaphore
+	Value maxValue_;
+};
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_SEMAPHORE_HPP_
@@ -0,0 +1,50 @@
+/**
+ * \file
+ * \brief ThisThread namespace header of host test suite of serial line
+ *
+ * Replacement of distortos::ThisThread, sleeping advances VirtualClock.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_THISTHREAD_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_THISTHREAD_HPP_
+
+#include "distortos/TickClock.hpp"
+
+namespace distortos
+{
+
+namespace ThisThread
+{
+
+/**
+ * \brief Makes the calling thread sleep for at least given duration.
+ *
+ * \param [in] duration is the duration after which the thread will be woken
+ *
+ * \return 0 on success
+ */
+
+int sleepFor(TickClock::duration duration);
+
+/**
+ * \brief Makes the calling thread sleep until some time point - VirtualClock is advanced to \a timePoint, running all
+ * timers which expire until then.
+ *
+ * \param [in] timePoint is the time point at which the thread will be woken
+ *
+ * \return 0 on success
+ */
+
+int sleepUntil(TickClock::time_point timePoint);
+
+}	// namespace ThisThread
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_THISTHREAD_HPP_
@@ -0,0 +1,57 @@
+/**
+ * \file
+ * \brief TickClock class header of host test suite of serial line
+ *
+ * Replacement of distortos::TickClock which follows VirtualClock.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_TICKCLOCK_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_TICKCLOCK_HPP_
+
+#include <chrono>
+
+#include <cstdint>
+
+#ifndef CONFIG_TICK_FREQUENCY
+#error "CONFIG_TICK_FREQUENCY must be defined"
+#endif	// !def CONFIG_TICK_FREQUENCY
+
+namespace distortos
+{
+
+/// TickClock is a std::chrono clock with tick resolution, which follows VirtualClock
+class TickClock
+{
+public:
+
+	/// type of tick counter
+	using rep = uint64_t;
+
+	/// std::ratio type representing the tick period of the clock, seconds
+	using period = std::ratio<1, CONFIG_TICK_FREQUENCY>;
+
+	/// basic duration type of clock
+	using duration = std::chrono::duration<rep, period>;
+
+	/// basic time_point type of clock
+	using time_point = std::chrono::time_point<TickClock>;
+
+	/**
+	 * \return current time point of VirtualClock
+	 */
+
+	static time_point now();
+
+	/// this is a steady clock - it cannot be adjusted
+	constexpr static bool is_steady {true};
+};
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_TICKCLOCK_HPP_
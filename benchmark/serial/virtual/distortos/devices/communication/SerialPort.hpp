@@ -0,0 +1,242 @@
+/**
+ * \file
+ * \brief SerialPort class header of host test suite of serial line
+ *
+ * Replacement of distortos::devices::SerialPort with the subset of its interface used by the port layer, waiting
+ * advances VirtualClock.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_SERIALPORT_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_SERIALPORT_HPP_
+
+#include "distortos/devices/communication/UartBase.hpp"
+#include "distortos/devices/communication/UartLowLevel.hpp"
+
+#include "distortos/TickClock.hpp"
+
+#include <cstdint>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/**
+ * SerialPort is a buffered serial port on top of low-level UART driver.
+ *
+ * Received characters are stored in read buffer as soon as they arrive, write copies data to write buffer and returns
+ * when all of it is copied, while transmission continues in the background - just like with distortos.
+ */
+
+class SerialPort : private UartBase
+{
+public:
+
+	/**
+	 * \brief SerialPort's constructor
+	 *
+	 * \param [in] uart is a reference to low-level implementation of UartLowLevel interface
+	 * \param [in] readBuffer is a buffer for read operations
+	 * \param [in] readBufferSize is the size of \a readBuffer, bytes, should be at least 2
+	 * \param [in] writeBuffer is a buffer for write operations
+	 * \param [in] writeBufferSize is the size of \a writeBuffer, bytes, should be at least 2
+	 */
+
+	constexpr SerialPort(UartLowLevel& uart, void* const readBuffer, const size_t readBufferSize,
+			void* const writeBuffer, const size_t writeBufferSize) :
+					readBuffer_{static_cast<uint8_t*>(readBuffer)},
+					readBufferSize_{readBufferSize},
+					readBegin_{},
+					readCount_{},
+					writeBuffer_{static_cast<uint8_t*>(writeBuffer)},
+					writeBufferSize_{writeBufferSize},
+					writeBegin_{},
+					writeCount_{},
+					writeInProgress_{},
+					uart_{uart},
+					receiveErrors_{},
+					readCharacter_{},
+					open_{},
+					transmitting_{}
+	{
+
+	}
+
+	/**
+	 * \brief Closes serial port, waiting until transmission of all written data is complete.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the port is not opened;
+	 */
+
+	int close();
+
+	/**
+	 * \return number of receive errors (characters dropped by low-level driver or read buffer overruns) since
+	 * construction
+	 */
+
+	size_t getReceiveErrors() const
+	{
+		return receiveErrors_;
+	}
+
+	/**
+	 * \brief Opens serial port.
+	 *
+	 * \param [in] baudRate is the desired baud rate, bps
+	 * \param [in] characterLength selects character length, bits
+	 * \param [in] parity selects parity
+	 * \param [in] _2StopBits selects whether 1 (false) or 2 (true) stop bits are used
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the port is already opened;
+	 * - error codes returned by UartLowLevel::start();
+	 */
+
+	int open(uint32_t baudRate, uint8_t characterLength, UartParity parity, bool _2StopBits);
+
+	/**
+	 * \brief Reads data from serial port, waiting for at least \a minSize bytes until given time point.
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 * \param [out] buffer is the buffer to which the data will be written
+	 * \param [in] size is the size of \a buffer, bytes
+	 * \param [in] minSize is the minimal number of bytes that should be read, default - 1
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of read bytes; error codes:
+	 * - EBADF - the port is not opened;
+	 * - ETIMEDOUT - fewer than \a minSize bytes arrived before \a timePoint;
+	 */
+
+	std::pair<int, size_t> tryReadUntil(TickClock::time_point timePoint, void* buffer, size_t size,
+			size_t minSize = 1);
+
+	/**
+	 * \brief Writes data to serial port, waiting for at least \a minSize bytes to be copied to write buffer until given
+	 * time point.
+	 *
+	 * \param [in] timePoint is the time point at which the wait will be terminated
+	 * \param [in] buffer is the buffer with data that will be transmitted
+	 * \param [in] size is the size of \a buffer, bytes
+	 * \param [in] minSize is the minimal number of bytes that should be written, default - all of them
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of written bytes; error codes:
+	 * - EBADF - the port is not opened;
+	 * - ETIMEDOUT - fewer than \a minSize bytes were copied to write buffer before \a timePoint;
+	 */
+
+	std::pair<int, size_t> tryWriteUntil(TickClock::time_point timePoint, const void* buffer, size_t size,
+			size_t minSize = SIZE_MAX);
+
+	/**
+	 * \brief Writes data to serial port, waiting until all of it is copied to write buffer.
+	 *
+	 * \param [in] buffer is the buffer with data that will be transmitted
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and number of written bytes; error codes:
+	 * - EBADF - the port is not opened;
+	 */
+
+	std::pair<int, size_t> write(const void* buffer, size_t size);
+
+private:
+
+	/**
+	 * \brief "Read complete" event
+	 *
+	 * \param [in] bytesRead is the number of bytes read by low-level UART driver, always 1
+	 */
+
+	void readCompleteEvent(size_t bytesRead) override;
+
+	/**
+	 * \brief "Receive error" event
+	 *
+	 * \param [in] errorSet is the set of error bits
+	 */
+
+	void receiveErrorEvent(ErrorSet errorSet) override;
+
+	/**
+	 * \brief Starts write of contiguous data from write buffer, if the previous one is complete.
+	 */
+
+	void startWrite();
+
+	/**
+	 * \brief "Transmit complete" event
+	 */
+
+	void transmitCompleteEvent() override;
+
+	/**
+	 * \brief "Transmit start" event
+	 */
+
+	void transmitStartEvent() override;
+
+	/**
+	 * \brief "Write complete" event
+	 *
+	 * \param [in] bytesWritten is the number of bytes written by low-level UART driver
+	 */
+
+	void writeCompleteEvent(size_t bytesWritten) override;
+
+	/// circular buffer for received data
+	uint8_t* readBuffer_;
+
+	/// size of readBuffer_, bytes
+	size_t readBufferSize_;
+
+	/// position of first received byte in readBuffer_
+	size_t readBegin_;
+
+	/// number of received bytes in readBuffer_
+	size_t readCount_;
+
+	/// circular buffer for written data
+	uint8_t* writeBuffer_;
+
+	/// size of writeBuffer_, bytes
+	size_t writeBufferSize_;
+
+	/// position of first byte in writeBuffer_ which was not transmitted yet
+	size_t writeBegin_;
+
+	/// number of bytes in writeBuffer_ which were not transmitted yet
+	size_t writeCount_;
+
+	/// number of bytes of write started in low-level driver, 0 if no write is in progress
+	size_t writeInProgress_;
+
+	/// reference to low-level implementation of UartLowLevel interface
+	UartLowLevel& uart_;
+
+	/// number of receive errors
+	size_t receiveErrors_;
+
+	/// character received by low-level driver
+	uint8_t readCharacter_;
+
+	/// true if the port is opened, false otherwise
+	bool open_;
+
+	/// true if transmission is in progress, false otherwise
+	bool transmitting_;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_SERIALPORT_HPP_
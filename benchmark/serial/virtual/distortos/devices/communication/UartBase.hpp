@@ -0,0 +1,98 @@
+/**
+ * \file
+ * \brief UartBase class header of host test suite of serial line
+ *
+ * Same interface as distortos::devices::UartBase.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTBASE_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTBASE_HPP_
+
+#include <bitset>
+
+#include <cstddef>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/// UartBase is an interface for UART which receives notifications from its low-level driver
+class UartBase
+{
+public:
+
+	/// indexes of error bits in ErrorSet
+	enum ErrorBits
+	{
+		/// framing error
+		framingError,
+		/// noise error
+		noiseError,
+		/// overrun error
+		overrunError,
+		/// parity error
+		parityError,
+
+		/// number of supported error bits - must be last!
+		errorBitsMax
+	};
+
+	/// set of error bits
+	using ErrorSet = std::bitset<errorBitsMax>;
+
+	/**
+	 * \brief UartBase's destructor
+	 */
+
+	virtual ~UartBase() = default;
+
+	/**
+	 * \brief "Read complete" event
+	 *
+	 * \param [in] bytesRead is the number of bytes read by low-level UART driver (and written to read buffer)
+	 */
+
+	virtual void readCompleteEvent(size_t bytesRead) = 0;
+
+	/**
+	 * \brief "Receive error" event
+	 *
+	 * \param [in] errorSet is the set of error bits
+	 */
+
+	virtual void receiveErrorEvent(ErrorSet errorSet) = 0;
+
+	/**
+	 * \brief "Transmit complete" event
+	 */
+
+	virtual void transmitCompleteEvent() = 0;
+
+	/**
+	 * \brief "Transmit start" event
+	 */
+
+	virtual void transmitStartEvent() = 0;
+
+	/**
+	 * \brief "Write complete" event
+	 *
+	 * \param [in] bytesWritten is the number of bytes written by low-level UART driver (and read from write buffer)
+	 */
+
+	virtual void writeCompleteEvent(size_t bytesWritten) = 0;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTBASE_HPP_
@@ -0,0 +1,109 @@
+/**
+ * \file
+ * \brief UartLowLevel class header of host test suite of serial line
+ *
+ * Same interface as distortos::devices::UartLowLevel.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTLOWLEVEL_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTLOWLEVEL_HPP_
+
+#include "distortos/devices/communication/UartParity.hpp"
+
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+class UartBase;
+
+/// UartLowLevel is an interface for low-level UART driver
+class UartLowLevel
+{
+public:
+
+	/**
+	 * \brief UartLowLevel's destructor
+	 */
+
+	virtual ~UartLowLevel() = default;
+
+	/**
+	 * \brief Starts low-level UART driver.
+	 *
+	 * \param [in] uartBase is a reference to UartBase object that will be associated with this one
+	 * \param [in] baudRate is the desired baud rate, bps
+	 * \param [in] characterLength selects character length, bits
+	 * \param [in] parity selects parity
+	 * \param [in] _2StopBits selects whether 1 (false) or 2 (true) stop bits are used
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and real baud rate
+	 */
+
+	virtual std::pair<int, uint32_t> start(UartBase& uartBase, uint32_t baudRate, uint8_t characterLength,
+			UartParity parity, bool _2StopBits) = 0;
+
+	/**
+	 * \brief Starts asynchronous read operation.
+	 *
+	 * \param [out] buffer is the buffer to which the data will be written
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return 0 on success, error code otherwise
+	 */
+
+	virtual int startRead(void* buffer, size_t size) = 0;
+
+	/**
+	 * \brief Starts asynchronous write operation.
+	 *
+	 * \param [in] buffer is the buffer with data that will be transmitted
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return 0 on success, error code otherwise
+	 */
+
+	virtual int startWrite(const void* buffer, size_t size) = 0;
+
+	/**
+	 * \brief Stops low-level UART driver.
+	 *
+	 * \return 0 on success, error code otherwise
+	 */
+
+	virtual int stop() = 0;
+
+	/**
+	 * \brief Stops asynchronous read operation.
+	 *
+	 * \return number of bytes already read by low-level UART driver
+	 */
+
+	virtual size_t stopRead() = 0;
+
+	/**
+	 * \brief Stops asynchronous write operation.
+	 *
+	 * \return number of bytes already written by low-level UART driver
+	 */
+
+	virtual size_t stopWrite() = 0;
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTLOWLEVEL_HPP_
@@ -0,0 +1,38 @@
+/**
+ * \file
+ * \brief UartParity enum class header of host test suite of serial line
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTPARITY_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTPARITY_HPP_
+
+#include <cstdint>
+
+namespace distortos
+{
+
+namespace devices
+{
+
+/// parity of UART
+enum class UartParity : uint8_t
+{
+	/// no parity
+	none,
+	/// odd parity
+	odd,
+	/// even parity
+	even,
+};
+
+}	// namespace devices
+
+}	// namespace distortos
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_SERIAL_VIRTUAL_DISTORTOS_DEVICES_COMMUNICATION_UARTPARITY_HPP_
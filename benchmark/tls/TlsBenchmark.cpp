@@ -0,0 +1,452 @@
+/**
+ * \file
+ * \brief TlsBenchmark class implementation
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "TlsBenchmark.hpp"
+
+#include <algorithm>
+#include <chrono>
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// size of one direction of in-memory connection, bytes - enough for the largest flight of handshake
+constexpr size_t pipeSize {32768};
+
+/// max number of steps of both sides of handshake, protects against configurations which never complete
+constexpr size_t maxHandshakeSteps {64};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// names of measured operations, used in report
+const char* const operationNames[]
+{
+		"handshakeFull",
+		"handshakeResumed",
+		"frameExchange",
+};
+
+static_assert(sizeof(operationNames) / sizeof(*operationNames) ==
+		static_cast<size_t>(TlsBenchmark::Operation::count), "Invalid size of operationNames!");
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local types
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// Pipe is one direction of in-memory connection
+struct Pipe
+{
+	/// buffer for data which was sent and not received yet
+	unsigned char buffer[pipeSize];
+
+	/// position of first byte which was not received yet
+	size_t readPosition;
+
+	/// position of first free byte
+	size_t writePosition;
+};
+
+/// Endpoint is one side of in-memory connection
+struct Endpoint
+{
+	/**
+	 * \brief Endpoint's constructor
+	 *
+	 * \param [in] inputt is a reference to pipe from which data is received
+	 * \param [in] outputt is a reference to pipe to which data is sent
+	 */
+
+	Endpoint(Pipe& inputt, Pipe& outputt) :
+			context{},
+			input{inputt},
+			output{outputt}
+	{
+		mbedtls_ssl_init(&context);
+	}
+
+	/**
+	 * \brief Endpoint's destructor
+	 */
+
+	~Endpoint()
+	{
+		mbedtls_ssl_free(&context);
+	}
+
+	Endpoint(const Endpoint&) = delete;
+	Endpoint& operator=(const Endpoint&) = delete;
+
+	/// context of TLS session
+	mbedtls_ssl_context context;
+
+	/// reference to pipe from which data is received
+	Pipe& input;
+
+	/// reference to pipe to which data is sent
+	Pipe& output;
+};
+
+/// Connection is an in-memory connection of server and client
+struct Connection
+{
+	/**
+	 * \brief Connection's constructor
+	 */
+
+	Connection() :
+			serverToClient{},
+			clientToServer{},
+			server{clientToServer, serverToClient},
+			client{serverToClient, clientToServer},
+			session{}
+	{
+		mbedtls_ssl_session_init(&session);
+	}
+
+	/**
+	 * \brief Connection's destructor
+	 */
+
+	~Connection()
+	{
+		mbedtls_ssl_session_free(&session);
+	}
+
+	Connection(const Connection&) = delete;
+	Connection& operator=(const Connection&) = delete;
+
+	/// data sent by server to client
+	Pipe serverToClient;
+
+	/// data sent by client to server
+	Pipe clientToServer;
+
+	/// server side, used just like context of MbedtlsTransport
+	Endpoint server;
+
+	/// client side
+	Endpoint client;
+
+	/// session of client, used for resumed handshakes
+	mbedtls_ssl_session session;
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Calculates value per operation.
+ *
+ * \param [in] total is the total value of all operations
+ * \param [in] operations is the number of operations
+ *
+ * \return \a total divided by \a operations, hundredths
+ */
+
+uint64_t getHundredthsPerOperation(const uint64_t total, const uint32_t operations)
+{
+	return operations == 0 ? 0 : total * 100 / operations;
+}
+
+/**
+ * \brief Performs handshake of both sides of connection, which must be reset.
+ *
+ * \param [in] connection is a reference to connection
+ *
+ * \return 0 on success, error code otherwise:
+ * - ECONNABORTED - handshake failed;
+ */
+
+int handshake(Connection& connection)
+{
+	// each step of one side consumes everything that was sent by the other side in its previous step
+	for (size_t step {}; step < maxHandshakeSteps; ++step)
+	{
+		const auto serverRet = mbedtls_ssl_handshake(&connection.server.context);
+		const auto clientRet = mbedtls_ssl_handshake(&connection.client.context);
+		if (serverRet == 0 && clientRet == 0)
+			return 0;
+
+		for (const auto ret : {serverRet, clientRet})
+			if (ret != 0 && ret != MBEDTLS_ERR_SSL_WANT_READ && ret != MBEDTLS_ERR_SSL_WANT_WRITE)
+				return ECONNABORTED;
+	}
+
+	return ECONNABORTED;
+}
+
+/**
+ * \brief Measures operation.
+ *
+ * \tparam Prepare is the type of \a prepare, should be callable as int()
+ * \tparam Operation is the type of \a operation, should be callable as int()
+ *
+ * \param [in] operations is the number of operations
+ * \param [in] bytes is the number of bytes of payload transferred by one operation
+ * \param [in] prepare is a functor which prepares state for next operation, not measured, returns 0 on success, error
+ * code otherwise
+ * \param [in] operation is a functor with measured operation, returns 0 on success, error code otherwise
+ * \param [out] result is a reference to variable for result of measurement
+ *
+ * \return 0 on success, error code otherwise:
+ * - error codes returned by \a prepare;
+ * - error codes returned by \a operation;
+ */
+
+template<typename Prepare, typename Operation>
+int measure(const uint32_t operations, const size_t bytes, Prepare prepare, Operation operation,
+		TlsBenchmark::Result& result)
+{
+	result = {};
+	for (uint32_t i {}; i < operations; ++i)
+	{
+		auto ret = prepare();
+		if (ret != 0)
+			return ret;
+
+		const auto before = std::chrono::steady_clock::now();
+		ret = operation();
+		const auto after = std::chrono::steady_clock::now();
+		if (ret != 0)
+			return ret;
+
+		result.nanoseconds += std::chrono::duration_cast<std::chrono::nanoseconds>(after - before).count();
+		result.bytes += bytes;
+		++result.operations;
+	}
+
+	return 0;
+}
+
+/**
+ * \brief Receives data from in-memory connection - receive callback of mbedTLS.
+ *
+ * \param [in] context is a pointer to Endpoint
+ * \param [out] buffer is a pointer to buffer for received data
+ * \param [in] size is the size of \a buffer, bytes
+ *
+ * \return number of received bytes, MBEDTLS_ERR_SSL_WANT_READ if no data was sent by the other side
+ */
+
+int receiveCallback(void* const context, unsigned char* const buffer, const size_t size)
+{
+	auto& pipe = static_cast<Endpoint*>(context)->input;
+	const auto received = std::min(size, pipe.writePosition - pipe.readPosition);
+	if (received == 0)
+		return MBEDTLS_ERR_SSL_WANT_READ;
+
+	memcpy(buffer, pipe.buffer + pipe.readPosition, received);
+	pipe.readPosition += received;
+	if (pipe.readPosition == pipe.writePosition)
+		pipe.readPosition = pipe.writePosition = {};
+	return received;
+}
+
+/**
+ * \brief Receives whole payload.
+ *
+ * \param [in] endpoint is a reference to receiving endpoint
+ * \param [out] buffer is a pointer to buffer for received payload
+ * \param [in] size is the size of payload, bytes
+ *
+ * \return 0 on success, error code otherwise:
+ * - EIO - payload could not be received;
+ */
+
+int receiveAll(Endpoint& endpoint, unsigned char* buffer, size_t size)
+{
+	while (size != 0)
+	{
+		const auto ret = mbedtls_ssl_read(&endpoint.context, buffer, size);
+		if (ret <= 0)
+			return EIO;
+
+		buffer += ret;
+		size -= ret;
+	}
+
+	return 0;
+}
+
+/**
+ * \brief Resets both sides of connection.
+ *
+ * \param [in] connection is a reference to connection
+ * \param [in] resume selects whether client resumes its session (true) or not (false)
+ *
+ * \return 0 on success, error code otherwise:
+ * - ENOMEM - mbedTLS context could not be reset;
+ */
+
+int reset(Connection& connection, const bool resume)
+{
+	connection.serverToClient.readPosition = connection.serverToClient.writePosition = {};
+	connection.clientToServer.readPosition = connection.clientToServer.writePosition = {};
+	if (mbedtls_ssl_session_reset(&connection.server.context) != 0 ||
+			mbedtls_ssl_session_reset(&connection.client.context) != 0)
+		return ENOMEM;
+
+	if (resume == true && mbedtls_ssl_set_session(&connection.client.context, &connection.session) != 0)
+		return ENOMEM;
+
+	return 0;
+}
+
+/**
+ * \brief Sends data to in-memory connection - send callback of mbedTLS.
+ *
+ * \param [in] context is a pointer to Endpoint
+ * \param [in] buffer is a pointer to data which will be sent
+ * \param [in] size is the size of \a buffer, bytes
+ *
+ * \return number of sent bytes, MBEDTLS_ERR_SSL_WANT_WRITE if pipe is full
+ */
+
+int sendCallback(void* const context, const unsigned char* const buffer, const size_t size)
+{
+	auto& pipe = static_cast<Endpoint*>(context)->output;
+	const auto sent = std::min(size, sizeof(pipe.buffer) - pipe.writePosition);
+	if (sent == 0)
+		return MBEDTLS_ERR_SSL_WANT_WRITE;
+
+	memcpy(pipe.buffer + pipe.writePosition, buffer, sent);
+	pipe.writePosition += sent;
+	return sent;
+}
+
+/**
+ * \brief Sends whole payload.
+ *
+ * \param [in] endpoint is a reference to sending endpoint
+ * \param [in] buffer is a pointer to payload
+ * \param [in] size is the size of payload, bytes
+ *
+ * \return 0 on success, error code otherwise:
+ * - EIO - payload could not be sent;
+ */
+
+int sendAll(Endpoint& endpoint, const unsigned char* buffer, size_t size)
+{
+	while (size != 0)
+	{
+		const auto ret = mbedtls_ssl_write(&endpoint.context, buffer, size);
+		if (ret <= 0)
+			return EIO;
+
+		buffer += ret;
+		size -= ret;
+	}
+
+	return 0;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int TlsBenchmark::run(const mbedtls_ssl_config& serverConfiguration, const mbedtls_ssl_config& clientConfiguration,
+		const uint32_t operations)
+{
+	if (operations == 0)
+		return EINVAL;
+
+	Connection connection;
+
+	if (mbedtls_ssl_setup(&connection.server.context, &serverConfiguration) != 0 ||
+			mbedtls_ssl_setup(&connection.client.context, &clientConfiguration) != 0)
+		return ENOMEM;
+
+	mbedtls_ssl_set_bio(&connection.server.context, &connection.server, sendCallback, receiveCallback, nullptr);
+	mbedtls_ssl_set_bio(&connection.client.context, &connection.client, sendCallback, receiveCallback, nullptr);
+
+	auto ret = measure(operations, {},
+			[&connection]()
+			{
+				return reset(connection, false);
+			},
+			[&connection]()
+			{
+				return handshake(connection);
+			},
+			results_[static_cast<size_t>(Operation::handshakeFull)]);
+	if (ret != 0)
+		return ret;
+
+	if (mbedtls_ssl_get_session(&connection.client.context, &connection.session) != 0)
+		return ENOMEM;
+
+	ret = measure(operations, {},
+			[&connection]()
+			{
+				return reset(connection, true);
+			},
+			[&connection]()
+			{
+				return handshake(connection);
+			},
+			results_[static_cast<size_t>(Operation::handshakeResumed)]);
+	if (ret != 0)
+		return ret;
+
+	// request and response are decrypted straight into frame buffer, just like with MbedtlsTransport
+	unsigned char frameBuffer[frameSize] {};
+	return measure(operations, 2 * frameSize,
+			[]()
+			{
+				return 0;
+			},
+			[&connection, &frameBuffer]()
+			{
+				auto ret = sendAll(connection.client, frameBuffer, sizeof(frameBuffer));
+				if (ret == 0)
+					ret = receiveAll(connection.server, frameBuffer, sizeof(frameBuffer));
+				if (ret == 0)
+					ret = sendAll(connection.server, frameBuffer, sizeof(frameBuffer));
+				if (ret == 0)
+					ret = receiveAll(connection.client, frameBuffer, sizeof(frameBuffer));
+				return ret;
+			},
+			results_[static_cast<size_t>(Operation::frameExchange)]);
+}
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| private functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+size_t TlsBenchmark::formatLine(const size_t index, char (&line)[maxLineLength]) const
+{
+	int ret;
+	if (index == 0)
+		ret = snprintf(line, sizeof(line), "operation,ns_per_operation,bytes_per_second\n");
+	else
+	{
+		const auto& result = results_[index - 1];
+		const auto nanoseconds = getHundredthsPerOperation(result.nanoseconds, result.operations);
+		const auto bytesPerSecond = result.nanoseconds == 0 ? 0 : result.bytes * 1000000000 / result.nanoseconds;
+		ret = snprintf(line, sizeof(line), "%s,%" PRIu64 ".%02" PRIu64 ",%" PRIu64 "\n", operationNames[index - 1],
+				nanoseconds / 100, nanoseconds % 100, bytesPerSecond);
+	}
+
+	return ret < 0 ? 0 : std::min(static_cast<size_t>(ret), sizeof(line) - 1);
+}
@@ -0,0 +1,163 @@
+/**
+ * \file
+ * \brief TlsBenchmark class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_BENCHMARK_TLS_TLSBENCHMARK_HPP_
+#define FREEMODBUS_INTEGRATION_BENCHMARK_TLS_TLSBENCHMARK_HPP_
+
+#include "mbedtls/ssl.h"
+
+#include <cstdint>
+
+/**
+ * TlsBenchmark measures cost of TLS work done by MbedtlsTransport - full handshake, handshake resumed from session
+ * cache and exchange of Modbus TCP frames - on host.
+ *
+ * Server and client contexts are connected with in-memory pipes, so results include only the work of mbedTLS, without
+ * network stack and without waiting. Server context is used just like in MbedtlsTransport - it is set up once with the
+ * shared configuration and reset before each handshake, received records are decrypted straight into buffer of the
+ * size of frame buffer of Modbus TCP instance.
+ *
+ * Results are reported as CSV, with one line per operation with its name, nanoseconds per operation and bytes of
+ * payload per second.
+ *
+ * \code
+ * TlsBenchmark benchmark;
+ * benchmark.run(serverConfiguration, clientConfiguration, 100);
+ * benchmark.report([](const void* const buffer, const size_t size)
+ *         {
+ *             return fwrite(buffer, 1, size, stdout) == size ? 0 : EIO;
+ *         });
+ * \endcode
+ */
+
+class TlsBenchmark
+{
+public:
+
+	/// Operation is a measured operation
+	enum class Operation : uint8_t
+	{
+		/// full handshake
+		handshakeFull,
+		/// handshake resumed with session from session cache of server
+		handshakeResumed,
+		/// exchange of request and response of max size of Modbus TCP frame
+		frameExchange,
+
+		/// number of measured operations
+		count
+	};
+
+	/// Result is a result of measurement of one operation
+	struct Result
+	{
+		/// total duration of all operations, nanoseconds
+		uint64_t nanoseconds;
+
+		/// total number of bytes of payload transferred by all operations
+		uint64_t bytes;
+
+		/// number of operations
+		uint32_t operations;
+	};
+
+	/// max length of one line of report, including terminating null character
+	constexpr static size_t maxLineLength {64};
+
+	/// max size of Modbus TCP frame, bytes - request and response of frameExchange have this size
+	constexpr static size_t frameSize {260};
+
+	/**
+	 * \brief TlsBenchmark's constructor
+	 */
+
+	constexpr TlsBenchmark() :
+			results_{}
+	{
+
+	}
+
+	/**
+	 * \param [in] operation is the measured operation
+	 *
+	 * \return result of measurement of \a operation
+	 */
+
+	const Result& getResult(const Operation operation) const
+	{
+		return results_[static_cast<size_t>(operation)];
+	}
+
+	/**
+	 * \brief Writes results as CSV - header line followed by one line per operation with its name, nanoseconds per
+	 * operation and bytes of payload per second.
+	 *
+	 * \tparam Writer is the type of \a writer, should be callable as int(const void* buffer, size_t size)
+	 *
+	 * \param [in] writer is a functor which writes the report, returns 0 on success, error code otherwise
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by \a writer;
+	 */
+
+	template<typename Writer>
+	int report(Writer writer) const
+	{
+		char line[maxLineLength];
+		for (size_t index {}; index <= static_cast<size_t>(Operation::count); ++index)
+		{
+			const auto size = formatLine(index, line);
+			const auto ret = writer(line, size);
+			if (ret != 0)
+				return ret;
+		}
+
+		return {};
+	}
+
+	/**
+	 * \brief Measures all operations.
+	 *
+	 * \param [in] serverConfiguration is a reference to configuration of mbedTLS server, should have session cache
+	 * enabled with MbedtlsTransport::enableSessionCache() (or with mbedtls_ssl_conf_session_cache()), otherwise resumed
+	 * handshake is a full one
+	 * \param [in] clientConfiguration is a reference to configuration of mbedTLS client, compatible with
+	 * \a serverConfiguration
+	 * \param [in] operations is the number of repetitions of each operation
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ECONNABORTED - handshake failed;
+	 * - EINVAL - \a operations is 0;
+	 * - EIO - exchange of frames failed;
+	 * - ENOMEM - mbedTLS context could not be set up;
+	 */
+
+	int run(const mbedtls_ssl_config& serverConfiguration, const mbedtls_ssl_config& clientConfiguration,
+			uint32_t operations);
+
+private:
+
+	/**
+	 * \brief Formats one line of report.
+	 *
+	 * \param [in] index is the index of line, 0 - header, index of operation incremented by 1 - line of this operation
+	 * \param [out] line is the buffer for formatted line
+	 *
+	 * \return length of formatted line, bytes
+	 */
+
+	size_t formatLine(size_t index, char (&line)[maxLineLength]) const;
+
+	/// results of measurement of all operations
+	Result results_[static_cast<size_t>(Operation::count)];
+};
+
+#endif	// FREEMODBUS_INTEGRATION_BENCHMARK_TLS_TLSBENCHMARK_HPP_
@@ -0,0 +1,152 @@
+/**
+ * \file
+ * \brief Main code block of host benchmark of TLS handshake and throughput
+ *
+ * Usage: FreeMODBUS-integration-tls-benchmark [operations]
+ *
+ * Server is configured like for MbedtlsTransport with session cache. Both sides use TLS 1.2 with pre-shared key, so
+ * no certificates are needed - handshake with certificates is more expensive by the cost of their verification and
+ * signatures.
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "TlsBenchmark.hpp"
+
+#include "mbedtls/ctr_drbg.h"
+#include "mbedtls/entropy.h"
+#include "mbedtls/ssl_cache.h"
+#include "mbedtls/version.h"
+
+#if defined(MBEDTLS_USE_PSA_CRYPTO) || defined(MBEDTLS_SSL_PROTO_TLS1_3)
+#include "psa/crypto.h"
+#endif	// defined(MBEDTLS_USE_PSA_CRYPTO) || defined(MBEDTLS_SSL_PROTO_TLS1_3)
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local constants
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// default number of repetitions of each operation
+constexpr uint32_t defaultOperations {100};
+
+/// ciphersuites offered by client, the first one uses ephemeral ECDH, just like ciphersuites with certificates do
+const int ciphersuites[]
+{
+		MBEDTLS_TLS_ECDHE_PSK_WITH_AES_128_CBC_SHA256,
+		MBEDTLS_TLS_PSK_WITH_AES_128_GCM_SHA256,
+		0,
+};
+
+/// identity of pre-shared key
+const unsigned char pskIdentity[] {'m', 'o', 'd', 'b', 'u', 's'};
+
+/// pre-shared key
+const unsigned char psk[16] {0x4d, 0x6f, 0x64, 0x62, 0x75, 0x73, 0x2f, 0x54, 0x43, 0x50, 0x20, 0x53, 0x65, 0x63, 0x75,
+		0x72};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Prepares configuration of one side of connection.
+ *
+ * \param [out] configuration is a reference to initialized configuration
+ * \param [in] endpoint is the side of connection, MBEDTLS_SSL_IS_SERVER or MBEDTLS_SSL_IS_CLIENT
+ * \param [in] ctrDrbg is a reference to seeded random number generator
+ *
+ * \return 0 on success, error code of mbedTLS otherwise
+ */
+
+int configure(mbedtls_ssl_config& configuration, const int endpoint, mbedtls_ctr_drbg_context& ctrDrbg)
+{
+	auto ret = mbedtls_ssl_config_defaults(&configuration, endpoint, MBEDTLS_SSL_TRANSPORT_STREAM,
+			MBEDTLS_SSL_PRESET_DEFAULT);
+	if (ret != 0)
+		return ret;
+
+	mbedtls_ssl_conf_rng(&configuration, mbedtls_ctr_drbg_random, &ctrDrbg);
+	mbedtls_ssl_conf_ciphersuites(&configuration, ciphersuites);
+	// session resumption with session cache is defined for TLS 1.2
+#if MBEDTLS_VERSION_NUMBER >= 0x03020000
+	mbedtls_ssl_conf_max_tls_version(&configuration, MBEDTLS_SSL_VERSION_TLS1_2);
+#else	// MBEDTLS_VERSION_NUMBER < 0x03020000
+	mbedtls_ssl_conf_max_version(&configuration, MBEDTLS_SSL_MAJOR_VERSION_3, MBEDTLS_SSL_MINOR_VERSION_3);
+#endif	// MBEDTLS_VERSION_NUMBER < 0x03020000
+	return mbedtls_ssl_conf_psk(&configuration, psk, sizeof(psk), pskIdentity, sizeof(pskIdentity));
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Main code block of host benchmark of TLS handshake and throughput
+ *
+ * \param [in] argc is the number of arguments
+ * \param [in] argv is an array with arguments, optional first one is the number of repetitions of each operation
+ *
+ * \return EXIT_SUCCESS on success, EXIT_FAILURE otherwise
+ */
+
+int main(const int argc, char* const argv[])
+{
+	const auto operations = argc > 1 ? static_cast<uint32_t>(strtoul(argv[1], nullptr, 10)) : defaultOperations;
+
+#if defined(MBEDTLS_USE_PSA_CRYPTO) || defined(MBEDTLS_SSL_PROTO_TLS1_3)
+	if (psa_crypto_init() != PSA_SUCCESS)
+		return EXIT_FAILURE;
+#endif	// defined(MBEDTLS_USE_PSA_CRYPTO) || defined(MBEDTLS_SSL_PROTO_TLS1_3)
+
+	mbedtls_entropy_context entropy;
+	mbedtls_entropy_init(&entropy);
+	mbedtls_ctr_drbg_context ctrDrbg;
+	mbedtls_ctr_drbg_init(&ctrDrbg);
+	mbedtls_ssl_cache_context cache;
+	mbedtls_ssl_cache_init(&cache);
+	mbedtls_ssl_config serverConfiguration;
+	mbedtls_ssl_config_init(&serverConfiguration);
+	mbedtls_ssl_config clientConfiguration;
+	mbedtls_ssl_config_init(&clientConfiguration);
+
+	int ret;
+	TlsBenchmark benchmark;
+	if (mbedtls_ctr_drbg_seed(&ctrDrbg, mbedtls_entropy_func, &entropy, nullptr, 0) != 0 ||
+			configure(serverConfiguration, MBEDTLS_SSL_IS_SERVER, ctrDrbg) != 0 ||
+			configure(clientConfiguration, MBEDTLS_SSL_IS_CLIENT, ctrDrbg) != 0)
+		ret = ENOMEM;
+	else
+	{
+		// same as MbedtlsTransport::enableSessionCache(), which needs distortos and lwIP
+		mbedtls_ssl_conf_session_cache(&serverConfiguration, &cache, mbedtls_ssl_cache_get, mbedtls_ssl_cache_set);
+		ret = benchmark.run(serverConfiguration, clientConfiguration, operations);
+	}
+
+	if (ret == 0)
+		ret = benchmark.report([](const void* const buffer, const size_t size)
+				{
+					return fwrite(buffer, 1, size, stdout) == size ? 0 : EIO;
+				});
+	else
+		fprintf(stderr, "TlsBenchmark failed: %d\n", ret);
+
+	mbedtls_ssl_config_free(&clientConfiguration);
+	mbedtls_ssl_config_free(&serverConfiguration);
+	mbedtls_ssl_cache_free(&cache);
+	mbedtls_ctr_drbg_free(&ctrDrbg);
+	mbedtls_entropy_free(&entropy);
+	return ret == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,41 @@
+/**
+ * \file
+ * \brief freemodbusCapture() definition
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_FREEMODBUSCAPTURE_HPP_
+#define FREEMODBUS_INTEGRATION_FREEMODBUSCAPTURE_HPP_
+
+#include "CaptureRing.hpp"
+#include "FreemodbusExtensions.hpp"
+#include "FreemodbusInstance.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Copies frame to the capture ring of the instance, if it has one.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS which received or sent the frame
+ * \param [in] direction is the direction of the frame
+ * \param [in] protocol is the protocol of the frame
+ * \param [in] frame is a pointer to the frame
+ * \param [in] size is the size of \a frame, bytes
+ */
+
+inline void freemodbusCapture(const FreemodbusInstance& instance, const CaptureRing::Direction direction,
+		const CaptureRing::Protocol protocol, const uint8_t* const frame, const size_t size)
+{
+	const auto extensions = instance.extensions;
+	if (extensions != nullptr && extensions->captureRing != nullptr)
+		extensions->captureRing->push(extensions->captureChannel, direction, protocol, frame, size);
+}
+
+#endif	// FREEMODBUS_INTEGRATION_FREEMODBUSCAPTURE_HPP_
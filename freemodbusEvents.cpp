@@ -2,22 +2,33 @@
  * \file
  * \brief Definitions of events-related functions for FreeMODBUS
  *
- * \author Copyright (C) 2019-2022 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2019-2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
  * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 
-#include "FreemodbusInstance.hpp"
+#include "freemodbusEvents.hpp"
+
+#include "freemodbusCapture.hpp"
+#include "FreemodbusExtensions.hpp"
+#include "FreemodbusSerialInstance.hpp"
+#include "FreemodbusTcpInstance.hpp"
 #include "freemodbusSerialPoll.hpp"
 #include "freemodbusTcpPoll.hpp"
 #include "freemodbusTimersPoll.hpp"
+#include "HotRangeCache.hpp"
+#include "WriteNotificationQueue.hpp"
 
 #include "mbport.h"
 
+#include "distortos/devices/communication/SerialPort.hpp"
+
 #include "estd/ReverseAdaptor.hpp"
 
+#include <algorithm>
+
 #include <cassert>
 
 namespace
@@ -27,6 +38,49 @@ namespace
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * \brief Captures complete Modbus RTU request frame and answers it from the hot range cache.
+ *
+ * FreeMODBUS builds Modbus RTU responses internally, so the request is intercepted when end of frame is signaled. The
+ * request is available only if it is still held in the frame buffer and all of its bytes were already consumed by
+ * FreeMODBUS. Buffer taken from the pool is kept by freemodbusSerialPoll() until the timer of receiver stops, so this
+ * is also true for instances which use FrameBufferPool, unless the pool was empty when the frame started.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS which received the request
+ *
+ * \return true if the request was answered, false if it must be handled by FreeMODBUS
+ */
+
+bool handleReceivedRtuFrame(FreemodbusSerialInstance& instance)
+{
+	if (instance.frameBuffer == nullptr || instance.rxPosition != instance.bytesInBuffer)
+		return false;
+
+	size_t frameSize {instance.bytesInBuffer};
+	freemodbusCapture(instance, CaptureRing::Direction::received, CaptureRing::Protocol::rtu, instance.frameBuffer,
+			frameSize);
+	// the next frame is stored from the beginning of the buffer
+	instance.bytesInBuffer = {};
+	instance.rxPosition = {};
+	const auto hotRangeCache = instance.extensions != nullptr ? instance.extensions->hotRangeCache : nullptr;
+	if (hotRangeCache == nullptr ||
+			hotRangeCache->answerRtuFrame(instance.frameBuffer, frameSize, instance.frameBufferSize) == false)
+		return false;
+
+	freemodbusCapture(instance, CaptureRing::Direction::sent, CaptureRing::Protocol::rtu, instance.frameBuffer,
+			frameSize);
+	if (instance.nonBlockingSend == true)
+	{
+		instance.bytesToSend = frameSize;
+		freemodbusSerialFlush(instance);
+		return true;
+	}
+
+	assert(instance.serialPort != nullptr);
+	instance.serialPort->write(instance.frameBuffer, frameSize);
+	return true;
+}
+
 /**
  * \brief Tries to get a FreeMODBUS event, internal version
  *
@@ -56,31 +110,64 @@ bool getEventInternal(FreemodbusInstance& instance, eMBEventType& event)
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+bool freemodbusHasPendingEvents(const FreemodbusInstance& instance)
+{
+	return std::any_of(instance.pendingEvents.begin(), instance.pendingEvents.end(),
+			[](const uint8_t pendingEvent) -> bool
+			{
+				return pendingEvent != 0;
+			});
+}
+
 extern "C" bool xMBPortEventGet(xMBInstance* const instance, eMBEventType* const event)
 {
 	assert(instance != nullptr);
 	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
 
+	// all writes done by previously handled request are complete, so they can be published to the application
+	if (freemodbusInstance.extensions != nullptr && freemodbusInstance.extensions->writeNotificationQueue != nullptr)
+		freemodbusInstance.extensions->writeNotificationQueue->publish();
+
 	if (getEventInternal(freemodbusInstance, *event) == true)
 		return true;
 
-	if (instance->eMBCurrentMode == MB_RTU || instance->eMBCurrentMode == MB_ASCII)
+	if (freemodbusInstance.nonBlocking == true)
 	{
-		const auto deadline = freemodbusTimersPoll(freemodbusInstance);
+		// only data which is already available is handled, serial port is read before timers are checked, as bytes
+		// waiting in serial port belong to the frame which is currently received
+		if (instance->eMBCurrentMode == MB_RTU || instance->eMBCurrentMode == MB_ASCII)
+		{
+			auto& serialInstance = static_cast<FreemodbusSerialInstance&>(freemodbusInstance);
+			freemodbusSerialPoll(serialInstance, distortos::TickClock::now());
+			if (getEventInternal(freemodbusInstance, *event) == true)
+				return true;
+
+			freemodbusTimersPoll(serialInstance);
+		}
+#if MB_TCP_ENABLED == 1
+		else if (instance->eMBCurrentMode == MB_TCP)
+			freemodbusTcpPoll(static_cast<FreemodbusTcpInstance&>(freemodbusInstance), distortos::TickClock::now());
+#endif	// MB_TCP_ENABLED == 1
+	}
+	else if (instance->eMBCurrentMode == MB_RTU || instance->eMBCurrentMode == MB_ASCII)
+	{
+		auto& serialInstance = static_cast<FreemodbusSerialInstance&>(freemodbusInstance);
+		const auto deadline = freemodbusTimersPoll(serialInstance);
 		if (getEventInternal(freemodbusInstance, *event) == true)
 			return true;
 
-		assert(freemodbusInstance.timerDuration != decltype(freemodbusInstance.timerDuration)::zero());
-		freemodbusSerialPoll(freemodbusInstance,
-				std::min(deadline, distortos::TickClock::now() + freemodbusInstance.timerDuration));
+		assert(serialInstance.timerDuration != decltype(serialInstance.timerDuration)::zero());
+		freemodbusSerialPoll(serialInstance,
+				std::min(deadline, distortos::TickClock::now() + serialInstance.timerDuration));
 		if (getEventInternal(freemodbusInstance, *event) == true)
 			return true;
 
-		freemodbusTimersPoll(freemodbusInstance);
+		freemodbusTimersPoll(serialInstance);
 	}
 #if MB_TCP_ENABLED == 1
 	else if (instance->eMBCurrentMode == MB_TCP)
-		freemodbusTcpPoll(freemodbusInstance, distortos::TickClock::now() + std::chrono::milliseconds{100});
+		freemodbusTcpPoll(static_cast<FreemodbusTcpInstance&>(freemodbusInstance),
+				distortos::TickClock::now() + std::chrono::milliseconds{100});
 #endif	// MB_TCP_ENABLED == 1
 
 	return getEventInternal(freemodbusInstance, *event);
@@ -102,6 +189,10 @@ extern "C" bool xMBPortEventPost(xMBInstance* const instance, const eMBEventType
 	assert(instance != nullptr);
 	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
 
+	if (event == EV_FRAME_RECEIVED && instance->eMBCurrentMode == MB_RTU &&
+			handleReceivedRtuFrame(static_cast<FreemodbusSerialInstance&>(freemodbusInstance)) == true)
+		return true;
+
 	if (freemodbusInstance.pendingEvents[event] ==
 			std::numeric_limits<std::decay<decltype(freemodbusInstance.pendingEvents[event])>::type>::max())
 		return false;	// overflow
@@ -0,0 +1,31 @@
+/**
+ * \file
+ * \brief freemodbusHasPendingEvents() declaration
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_FREEMODBUSEVENTS_HPP_
+#define FREEMODBUS_INTEGRATION_FREEMODBUSEVENTS_HPP_
+
+struct FreemodbusInstance;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Checks whether instance has pending events.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS
+ *
+ * \return true if instance has pending events, false otherwise
+ */
+
+bool freemodbusHasPendingEvents(const FreemodbusInstance& instance);
+
+#endif	// FREEMODBUS_INTEGRATION_FREEMODBUSEVENTS_HPP_
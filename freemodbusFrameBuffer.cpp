@@ -0,0 +1,46 @@
+/**
+ * \file
+ * \brief acquireFrameBuffer() and releaseFrameBuffer() definitions
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "freemodbusFrameBuffer.hpp"
+
+#include "FrameBufferPool.hpp"
+#include "FreemodbusInstance.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+bool acquireFrameBuffer(FreemodbusInstance& instance)
+{
+	if (instance.frameBuffer != nullptr)
+		return true;
+
+	if (instance.frameBufferPool == nullptr)
+		return false;
+
+	const auto frameBuffer = instance.frameBufferPool->tryAllocate();
+	if (frameBuffer == nullptr)
+		return false;
+
+	instance.frameBuffer = frameBuffer;
+	instance.frameBufferSize = instance.frameBufferPool->getBlockSize();
+	return true;
+}
+
+void releaseFrameBuffer(FreemodbusInstance& instance)
+{
+	if (instance.frameBufferPool == nullptr || instance.frameBuffer == nullptr)
+		return;
+
+	instance.frameBufferPool->deallocate(instance.frameBuffer);
+	instance.frameBuffer = {};
+	instance.frameBufferSize = {};
+}
@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \brief acquireFrameBuffer() and releaseFrameBuffer() declarations
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_FREEMODBUSFRAMEBUFFER_HPP_
+#define FREEMODBUS_INTEGRATION_FREEMODBUSFRAMEBUFFER_HPP_
+
+struct FreemodbusInstance;
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Makes sure that instance has a frame buffer.
+ *
+ * If the instance uses a pool and currently has no buffer, the buffer is taken from the pool.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS
+ *
+ * \return true if the instance has a frame buffer, false if the pool is empty
+ */
+
+bool acquireFrameBuffer(FreemodbusInstance& instance);
+
+/**
+ * \brief Returns frame buffer of instance to the pool.
+ *
+ * Does nothing if the instance has dedicated frame buffer or currently has no buffer.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS
+ */
+
+void releaseFrameBuffer(FreemodbusInstance& instance);
+
+#endif	// FREEMODBUS_INTEGRATION_FREEMODBUSFRAMEBUFFER_HPP_
@@ -0,0 +1,56 @@
+/**
+ * \file
+ * \brief Header with functions for listen sockets of Modbus TCP instances
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_FREEMODBUSLISTENSOCKETS_HPP_
+#define FREEMODBUS_INTEGRATION_FREEMODBUSLISTENSOCKETS_HPP_
+
+#include "FreemodbusTcpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "ListenSocket.hpp"
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Calls functor for each listen socket to which the instance is bound.
+ *
+ * Instance bound to listen socket with fixed port is bound to all listen sockets from its range which have the same
+ * fixed port.
+ *
+ * \tparam Functor is the type of functor, should be callable as void(ListenSocket&)
+ *
+ * \param [in] instance is a reference to Modbus TCP instance of FreeMODBUS
+ * \param [in] functor is the functor called for each listen socket
+ */
+
+template<typename Functor>
+void forEachListenSocket(const FreemodbusTcpInstance& instance, Functor functor)
+{
+	if (instance.listenSocket == nullptr)
+		return;
+
+	if (instance.listenSocket->getFixedPort() == 0)
+	{
+		functor(*instance.listenSocket);
+		return;
+	}
+
+	for (auto& listenSocket : instance.listenSocketsRange)
+		if (listenSocket.getFixedPort() == instance.listenSocket->getFixedPort())
+			functor(listenSocket);
+}
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_FREEMODBUSLISTENSOCKETS_HPP_
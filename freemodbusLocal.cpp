@@ -0,0 +1,197 @@
+/**
+ * \file
+ * \brief Definitions of port of co-located client for FreeMODBUS
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FreemodbusLocalInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "freemodbusCapture.hpp"
+#include "freemodbusTcpHooks.hpp"
+#include "LocalRing.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts reference to FreemodbusTcpInstance to reference to FreemodbusLocalInstance.
+ *
+ * \param [in] instance is a reference to FreemodbusTcpInstance, which must be FreemodbusLocalInstance
+ *
+ * \return reference to \a instance as FreemodbusLocalInstance
+ */
+
+FreemodbusLocalInstance& getLocalInstance(FreemodbusTcpInstance& instance)
+{
+	return static_cast<FreemodbusLocalInstance&>(instance);
+}
+
+/**
+ * \brief Completes request of local client which is currently handled and detaches its slot from
+ * FreemodbusLocalInstance.
+ *
+ * Does nothing if no request is handled.
+ *
+ * \param [in] instance is a reference to FreemodbusLocalInstance
+ * \param [in] size is the size of response frame stored in the slot, bytes, 0 if the request was dropped
+ */
+
+void completeLocalRequest(FreemodbusLocalInstance& instance, const size_t size)
+{
+	if (instance.frameBuffer == nullptr)
+		return;
+
+	instance.localRing.complete(size);
+	instance.frameBuffer = {};
+	instance.frameBufferSize = {};
+	instance.bytesInBuffer = {};
+	if (instance.tcpExtensions != nullptr)
+		instance.tcpExtensions->admissionTime = {};
+}
+
+/**
+ * \brief Closes FreemodbusLocalInstance.
+ *
+ * Nothing is opened for local client, so this does nothing.
+ */
+
+void closeLocal(FreemodbusTcpInstance&)
+{
+
+}
+
+/**
+ * \brief Drops request of local client which is currently handled.
+ *
+ * \param [in] instance is a reference to FreemodbusLocalInstance which request will be dropped
+ */
+
+void disableLocal(FreemodbusTcpInstance& instance)
+{
+	completeLocalRequest(getLocalInstance(instance), {});
+}
+
+/**
+ * \brief Opens FreemodbusLocalInstance.
+ *
+ * Nothing is opened for local client and port is ignored.
+ *
+ * \return always true
+ */
+
+bool initLocal(FreemodbusTcpInstance&, uint16_t)
+{
+	return true;
+}
+
+/**
+ * \brief Polls local ring for requests of co-located client.
+ *
+ * \param [in] instance is a reference to FreemodbusLocalInstance which will be polled
+ * \param [in] deadline is the deadline of polling operation
+ */
+
+void pollLocal(FreemodbusTcpInstance& instance, const distortos::TickClock::time_point deadline)
+{
+	auto& localInstance = getLocalInstance(instance);
+
+	// request which was passed to FreeMODBUS in previous poll and was not answered is dropped
+	if (freemodbusTcpIsDeferred(localInstance) == false)
+		completeLocalRequest(localInstance, {});
+
+	while (deadline - distortos::TickClock::now() >= distortos::TickClock::duration{})
+	{
+		if (freemodbusTcpIsDeferred(localInstance) == true)
+		{
+			if (freemodbusTcpWaitForAdmission(localInstance, deadline) == false)
+				return;
+		}
+		else
+		{
+			if (localInstance.localRing.waitRequest(deadline) != 0)
+				return;
+
+			// request is handled in place, the slot is the frame buffer until the request is completed
+			auto& slot = localInstance.localRing.getRequest();
+			localInstance.frameBuffer = slot.frame;
+			localInstance.frameBufferSize = sizeof(slot.frame);
+			localInstance.bytesInBuffer = slot.size;
+			if (localInstance.tcpExtensions != nullptr)
+				localInstance.tcpExtensions->masterAddress = htonl(INADDR_LOOPBACK);
+			freemodbusCapture(localInstance, CaptureRing::Direction::received, CaptureRing::Protocol::tcp,
+					localInstance.frameBuffer, localInstance.bytesInBuffer);
+		}
+
+		if (freemodbusTcpHandleRequest(localInstance) == true)
+			return;
+
+		if (freemodbusTcpIsDeferred(localInstance) == false)
+			completeLocalRequest(localInstance, {});
+	}
+}
+
+/**
+ * \brief Applies pending change of port of FreemodbusLocalInstance.
+ *
+ * Local client does not use ports, so this does nothing.
+ */
+
+void reconfigureLocalPort(FreemodbusTcpInstance&, uint16_t)
+{
+
+}
+
+/**
+ * \brief Passes response to local client and completes its request.
+ *
+ * \param [in] instance is a reference to FreemodbusLocalInstance which handles the request
+ * \param [in] frame is a pointer to response frame
+ * \param [in] length is the length of \a frame, bytes
+ *
+ * \return always true
+ */
+
+bool sendLocalResponse(FreemodbusTcpInstance& instance, const uint8_t* const frame, const uint16_t length)
+{
+	auto& localInstance = getLocalInstance(instance);
+	freemodbusCapture(localInstance, CaptureRing::Direction::sent, CaptureRing::Protocol::tcp, frame, length);
+
+	assert(localInstance.frameBuffer != nullptr && length <= localInstance.frameBufferSize);
+	// response is normally built in place, in the slot of the request
+	if (frame != localInstance.frameBuffer)
+		memmove(localInstance.frameBuffer, frame, length);
+	completeLocalRequest(localInstance, length);
+	return true;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| FreemodbusLocalInstance's private static objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const FreemodbusTcpHooks FreemodbusLocalInstance::localHooks
+{
+		initLocal,
+		reconfigureLocalPort,
+		pollLocal,
+		sendLocalResponse,
+		disableLocal,
+		closeLocal,
+};
+
+#endif	// MB_TCP_ENABLED == 1
@@ -0,0 +1,52 @@
+/**
+ * \file
+ * \brief Header with functions for MBAP header of Modbus TCP frames
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_FREEMODBUSMBAP_HPP_
+#define FREEMODBUS_INTEGRATION_FREEMODBUSMBAP_HPP_
+
+#include "FreemodbusTcpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+/// index of high byte of frame length in MBAP header
+constexpr size_t frameLengthHigh {4};
+
+/// index of low byte of frame length in MBAP header
+constexpr size_t frameLengthLow {frameLengthHigh + 1};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Calculates size of Modbus TCP frame from length field of its MBAP header.
+ *
+ * \param [in] frame is a pointer to beginning of the frame
+ * \param [in] size is the number of bytes of the frame which are already available
+ *
+ * \return size of complete frame, bytes; if length field is not available yet, size of MBAP header without unit
+ * identifier
+ */
+
+inline size_t getMbapFrameSize(const uint8_t* const frame, const size_t size)
+{
+	const uint16_t length = size < FreemodbusTcpInstance::mbapHeaderSize - 1 ? 0 :
+			((frame[frameLengthHigh] << 8) | frame[frameLengthLow]);
+	return FreemodbusTcpInstance::mbapHeaderSize - 1 + length;
+}
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_FREEMODBUSMBAP_HPP_
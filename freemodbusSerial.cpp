@@ -2,7 +2,7 @@
  * \file
  * \brief Definitions of FreeMODBUS functions related to serial port
  *
- * \author Copyright (C) 2019-2022 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2019-2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -11,41 +11,331 @@
 
 #include "freemodbusSerialPoll.hpp"
 
-#include "FreemodbusInstance.hpp"
+#include "freemodbusCapture.hpp"
+#include "freemodbusEvents.hpp"
+#include "FreemodbusExtensions.hpp"
+#include "freemodbusFrameBuffer.hpp"
+#include "FreemodbusSerialInstance.hpp"
+#include "modbusAscii.hpp"
 
 #include "mbport.h"
 
 #include "distortos/devices/communication/SerialPort.hpp"
+#include "distortos/ThisThread.hpp"
 
 #include <cassert>
+#include <cerrno>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Drops received characters of Modbus ASCII frames addressed to other slaves.
+ *
+ * Received characters which were not passed to FreeMODBUS yet are stored in the frame buffer after rxPosition. Address
+ * of new frame is decoded as soon as its first three characters are received, until then they are held in the buffer.
+ * Frame addressed to other slave is dropped up to its terminating LF with a single scan, FreeMODBUS is not called for
+ * any of its characters. Frames with broadcast or invalid address and characters outside of frames are passed to
+ * FreeMODBUS.
+ *
+ * Does nothing if the instance is not in Modbus ASCII mode or FreemodbusExtensions::asciiAddress is not set.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS which received the characters
+ *
+ * \return number of received characters which should be passed to FreeMODBUS
+ */
+
+size_t filterAsciiCharacters(FreemodbusSerialInstance& instance)
+{
+	const auto extensions = instance.extensions;
+	// characters of frame which was already accepted are passed to FreeMODBUS without checking
+	if (instance.rawInstance.eMBCurrentMode != MB_ASCII || extensions == nullptr || extensions->asciiAddress == 0 ||
+			instance.rxPosition != 0)
+		return instance.bytesInBuffer - instance.rxPosition;
+
+	const auto characters = reinterpret_cast<const char*>(instance.frameBuffer);
+	while (1)
+	{
+		if (extensions->asciiFrameDropped == true)
+		{
+			const auto end = static_cast<const char*>(memchr(characters, '\n', instance.bytesInBuffer));
+			if (end == nullptr)
+			{
+				instance.bytesInBuffer = {};
+				return 0;
+			}
+
+			// characters following the end of dropped frame belong to the next frame
+			const size_t dropped = end - characters + 1;
+			memmove(instance.frameBuffer, instance.frameBuffer + dropped, instance.bytesInBuffer - dropped);
+			instance.bytesInBuffer -= dropped;
+			extensions->asciiFrameDropped = false;
+		}
+
+		if (instance.bytesInBuffer == 0 || characters[0] != ':')
+			return instance.bytesInBuffer;
+
+		// start of frame and first character of its address are held until the address is complete
+		if (instance.bytesInBuffer < 3)
+			return 0;
+
+		uint8_t address;
+		uint8_t sum {};
+		if (modbusAsciiDecode(characters + 1, sizeof(address), &address, sum) != 0 || address == 0 ||
+				address == extensions->asciiAddress)
+			return instance.bytesInBuffer;
+
+		extensions->asciiFrameDropped = true;
+	}
+}
+
+/**
+ * \brief Calculates duration of Modbus RTU T3.5 timer, the same way as FreeMODBUS does in eMBRTUInit().
+ *
+ * \param [in] baudRate is the baud rate, bps
+ *
+ * \return duration of T3.5 timer, 50 us units
+ */
+
+uint16_t getT35Timeout50us(const uint32_t baudRate)
+{
+	// fixed value of 1750 us is used above 19200 bps, so the timer does not depend on the time of single character
+	if (baudRate > 19200)
+		return 35;
+
+	return (7 * 220000) / (2 * baudRate);
+}
+
+/**
+ * \brief Opens serial port of instance with given parameters.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS which serial port will be opened
+ * \param [in] configuration is a reference to parameters of serial port
+ *
+ * \return 0 on success, error code otherwise:
+ * - error codes returned by distortos::devices::SerialPort::open();
+ */
+
+int openSerialPort(FreemodbusSerialInstance& instance, const FreemodbusExtensions::SerialConfiguration& configuration)
+{
+	assert(instance.serialPort != nullptr);
+	return instance.serialPort->open(configuration.baudRate, configuration.characterLength, configuration.parity,
+			false);
+}
+
+/**
+ * \brief Applies pending change of parameters of serial port.
+ *
+ * Serial port which could be opened neither with new nor with previous parameters stays closed, the next call retries
+ * to open it with previous parameters.
+ *
+ * Must be called only at frame boundary.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS which serial port will be reconfigured
+ *
+ * \return true if serial port is opened, false otherwise
+ */
+
+bool applySerialReconfiguration(FreemodbusSerialInstance& instance)
+{
+	const auto extensions = instance.extensions;
+	if (extensions == nullptr)
+		return true;
+
+	if (extensions->serialReconfigurationPending.load(std::memory_order_acquire) == false)
+	{
+		if (extensions->serialPortClosed.load(std::memory_order_relaxed) == false)
+			return true;
+
+		if (openSerialPort(instance, extensions->serialConfiguration) != 0)
+			return false;
+
+		extensions->serialPortClosed.store(false, std::memory_order_relaxed);
+		return true;
+	}
+
+	const auto configuration = extensions->pendingSerialConfiguration;
+
+	// close() waits until transmission of previous response is complete, port which could not be reopened by previous
+	// change is already closed
+	instance.serialPort->close();
+	const auto ret = openSerialPort(instance, configuration);
+	if (ret == 0)
+	{
+		extensions->serialConfiguration = configuration;
+		if (instance.rawInstance.eMBCurrentMode == MB_RTU)
+			xMBPortTimersInit(&instance.rawInstance, getT35Timeout50us(configuration.baudRate));
+	}
+
+	const auto opened = ret == 0 || openSerialPort(instance, extensions->serialConfiguration) == 0;
+	extensions->serialPortClosed.store(opened == false, std::memory_order_relaxed);
+	extensions->serialReconfigurationResult.store(ret, std::memory_order_relaxed);
+	extensions->serialReconfigurationPending.store(false, std::memory_order_release);
+	return opened;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| FreemodbusSerialInstance's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int FreemodbusSerialInstance::getSerialReconfigurationResult() const
+{
+	if (extensions == nullptr)
+		return ENOTSUP;
+
+	if (extensions->serialReconfigurationPending.load(std::memory_order_acquire) == true)
+		return EINPROGRESS;
+
+	if (extensions->serialPortClosed.load(std::memory_order_relaxed) == true)
+		return EIO;
+
+	return extensions->serialReconfigurationResult.load(std::memory_order_relaxed);
+}
+
+int FreemodbusSerialInstance::reconfigureSerial(const uint32_t baudRate, const uint8_t characterLength,
+		const distortos::devices::UartParity parity)
+{
+	if (extensions == nullptr)
+		return ENOTSUP;
+
+	if (extensions->serialReconfigurationPending.load(std::memory_order_acquire) == true)
+		return EBUSY;
+
+	extensions->pendingSerialConfiguration = {baudRate, parity, characterLength};
+	extensions->serialReconfigurationPending.store(true, std::memory_order_release);
+	return 0;
+}
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-void freemodbusSerialPoll(FreemodbusInstance& instance, const distortos::TickClock::time_point deadline)
+bool freemodbusSerialFlush(FreemodbusSerialInstance& instance)
 {
+	if (instance.bytesToSend == 0)
+		return true;
+
 	assert(instance.serialPort != nullptr);
+	assert(instance.frameBuffer != nullptr);
+	const auto ret = instance.serialPort->tryWriteUntil(distortos::TickClock::now(), instance.frameBuffer,
+			instance.bytesToSend);
+	// only lack of free space in write buffer is retried, the response is dropped on any other error
+	const size_t sent = ret.first == 0 || ret.first == ETIMEDOUT ? ret.second : instance.bytesToSend;
+	instance.bytesToSend -= sent;
+	if (instance.bytesToSend != 0)
+	{
+		memmove(instance.frameBuffer, instance.frameBuffer + sent, instance.bytesToSend);
+		return false;
+	}
 
-	while (instance.serialMode == FreemodbusInstance::SerialMode::receiver)
+	releaseFrameBuffer(instance);
+	return true;
+}
+
+void freemodbusSerialPoll(FreemodbusSerialInstance& instance, const distortos::TickClock::time_point deadline)
+{
+	assert(instance.serialPort != nullptr);
+
+	// response which waits in the frame buffer is sent before anything is received
+	if (freemodbusSerialFlush(instance) == false)
+		return;
+
+	while (instance.serialMode == FreemodbusSerialInstance::SerialMode::receiver)
 	{
-		const auto ret = instance.serialPort->tryReadUntil(deadline, instance.frameBuffer,
-				sizeof(instance.frameBuffer));
+		// buffer from the pool is taken only when first byte of the frame is received
+		const auto bufferless = instance.frameBuffer == nullptr;
+		// bytes are appended, so complete Modbus RTU frame is available for the hot range cache and capture
+		if (bufferless == false)
+		{
+			// received byte starts new frame when the timer is not running, no received frame waits for handling and
+			// no characters of Modbus ASCII frame are held - bytes of previous frame which did not end with a frame
+			// event (received during initialization, invalid) are dropped
+			if (instance.timerDeadline == decltype(instance.timerDeadline)::max() &&
+					freemodbusHasPendingEvents(instance) == false && instance.rxPosition == instance.bytesInBuffer)
+			{
+				instance.bytesInBuffer = {};
+				instance.rxPosition = {};
+			}
+			// frame longer than the buffer is rejected by FreeMODBUS, its following bytes replace the last one
+			else if (instance.bytesInBuffer == instance.frameBufferSize)
+			{
+				--instance.bytesInBuffer;
+				--instance.rxPosition;
+			}
+		}
+		uint8_t firstByte;
+		const auto ret = bufferless == false ?
+				instance.serialPort->tryReadUntil(deadline, &instance.frameBuffer[instance.bytesInBuffer],
+						instance.frameBufferSize - instance.bytesInBuffer) :
+				instance.serialPort->tryReadUntil(deadline, &firstByte, sizeof(firstByte));
 		if (ret.second == 0)
+		{
+			// while the timer is running or characters of Modbus ASCII frame are held the frame may be incomplete or
+			// its end was not signaled yet - buffer from the pool is kept, so complete Modbus RTU frame is still
+			// available when end of frame is handled
+			if (instance.timerDeadline != decltype(instance.timerDeadline)::max() ||
+					instance.rxPosition != instance.bytesInBuffer)
+				return;
+
+			releaseFrameBuffer(instance);
+			// receiver is idle when its timer is not running and no received frame waits for handling, serial port
+			// which could not be reopened is retried at the next poll
+			if (freemodbusHasPendingEvents(instance) == false && applySerialReconfiguration(instance) == false)
+				distortos::ThisThread::sleepUntil(deadline);
 			return;
+		}
 
-		instance.bytesInBuffer = ret.second;
-		instance.rxPosition = {};
-		for (size_t i {}; i < ret.second; ++i)
+		if (bufferless == true)
+		{
+			// if the pool is empty the byte is dropped, incomplete frame will be rejected by FreeMODBUS
+			if (acquireFrameBuffer(instance) == false)
+				continue;
+
+			instance.frameBuffer[0] = firstByte;
+			instance.bytesInBuffer = {};
+			instance.rxPosition = {};
+		}
+
+		instance.bytesInBuffer += ret.second;
+		const auto characters = filterAsciiCharacters(instance);
+		for (size_t i {}; i < characters; ++i)
 			instance.rawInstance.pxMBFrameCBByteReceived(&instance.rawInstance);
 	}
 
-	if (instance.serialMode == FreemodbusInstance::SerialMode::transmiter)
+	if (instance.serialMode == FreemodbusSerialInstance::SerialMode::transmiter)
 	{
-		while (instance.serialMode == FreemodbusInstance::SerialMode::transmiter)
+		// if the pool is empty, the response is delayed until a buffer is available
+		if (acquireFrameBuffer(instance) == false)
+		{
+			distortos::ThisThread::sleepUntil(deadline);
+			return;
+		}
+
+		while (instance.serialMode == FreemodbusSerialInstance::SerialMode::transmiter)
 			instance.rawInstance.pxMBFrameCBTransmitterEmpty(&instance.rawInstance);
 
+		if (instance.rawInstance.eMBCurrentMode == MB_RTU)
+			freemodbusCapture(instance, CaptureRing::Direction::sent, CaptureRing::Protocol::rtu, instance.frameBuffer,
+					instance.txPosition);
+
+		// the part of the response which does not fit in write buffer of serial port is sent by next calls of
+		// freemodbusSerialFlush()
+		if (instance.nonBlockingSend == true)
+		{
+			instance.bytesToSend = instance.txPosition;
+			freemodbusSerialFlush(instance);
+			return;
+		}
+
 		instance.serialPort->write(instance.frameBuffer, instance.txPosition);
+		releaseFrameBuffer(instance);
 	}
 }
 
@@ -54,12 +344,18 @@ extern "C" void vMBPortSerialEnable(xMBInstance* const instance, const bool rxEn
 	assert(instance != nullptr);
 	assert(rxEnable == false || txEnable == false);	// no more than one function may be enabled
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
-	freemodbusInstance.serialMode = rxEnable == true ? FreemodbusInstance::SerialMode::receiver :
-			txEnable == true ? FreemodbusInstance::SerialMode::transmiter : FreemodbusInstance::SerialMode::disabled;
+	auto& freemodbusInstance = *reinterpret_cast<FreemodbusSerialInstance*>(instance);
+	freemodbusInstance.serialMode = rxEnable == true ? FreemodbusSerialInstance::SerialMode::receiver :
+			txEnable == true ? FreemodbusSerialInstance::SerialMode::transmiter :
+			FreemodbusSerialInstance::SerialMode::disabled;
 
 	if (rxEnable == true)
+	{
+		freemodbusInstance.bytesInBuffer = {};
 		freemodbusInstance.rxPosition = {};
+		if (freemodbusInstance.extensions != nullptr)
+			freemodbusInstance.extensions->asciiFrameDropped = {};
+	}
 
 	if (txEnable == true)
 		freemodbusInstance.txPosition = {};
@@ -71,8 +367,10 @@ extern "C" void xMBPortSerialClose(xMBInstance* const instance)
 
 	xMBPortTimersClose(instance);
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
-	freemodbusInstance.serialMode = FreemodbusInstance::SerialMode::disabled;
+	auto& freemodbusInstance = *reinterpret_cast<FreemodbusSerialInstance*>(instance);
+	freemodbusInstance.serialMode = FreemodbusSerialInstance::SerialMode::disabled;
+	freemodbusInstance.bytesToSend = {};
+	releaseFrameBuffer(freemodbusInstance);
 
 	assert(freemodbusInstance.serialPort != nullptr);
 	const auto ret = freemodbusInstance.serialPort->close();
@@ -83,7 +381,7 @@ extern "C" bool xMBPortSerialGetByte(xMBInstance* const instance, uint8_t* const
 {
 	assert(instance != nullptr);
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
+	auto& freemodbusInstance = *reinterpret_cast<FreemodbusSerialInstance*>(instance);
 	if (freemodbusInstance.rxPosition >= freemodbusInstance.bytesInBuffer)
 		return false;
 
@@ -96,20 +394,27 @@ extern "C" bool xMBPortSerialInit(xMBInstance* const instance, uint8_t, const ui
 {
 	assert(instance != nullptr);
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
+	auto& freemodbusInstance = *reinterpret_cast<FreemodbusSerialInstance*>(instance);
 	const auto uartParity = parity == MB_PAR_ODD ? distortos::devices::UartParity::odd :
 			parity == MB_PAR_EVEN ? distortos::devices::UartParity::even : distortos::devices::UartParity::none;
 	assert(freemodbusInstance.serialPort != nullptr);
 	const auto ret = freemodbusInstance.serialPort->open(baudRate, dataBits, uartParity, false);
-	return ret == 0;
+	if (ret != 0)
+		return false;
+
+	// current parameters are needed only to restore them when reconfiguration fails
+	if (freemodbusInstance.extensions != nullptr)
+		freemodbusInstance.extensions->serialConfiguration = {baudRate, uartParity, dataBits};
+	return true;
 }
 
 extern "C" bool xMBPortSerialPutByte(xMBInstance* const instance, const uint8_t byte)
 {
 	assert(instance != nullptr);
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
-	if (freemodbusInstance.txPosition >= sizeof(freemodbusInstance.frameBuffer) - 1)
+	auto& freemodbusInstance = *reinterpret_cast<FreemodbusSerialInstance*>(instance);
+	if (freemodbusInstance.frameBuffer == nullptr ||
+			freemodbusInstance.txPosition >= freemodbusInstance.frameBufferSize - 1)
 		return false;
 
 	freemodbusInstance.frameBuffer[freemodbusInstance.txPosition++] = byte;
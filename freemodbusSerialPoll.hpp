@@ -1,6 +1,6 @@
 /**
  * \file
- * \brief freemodbusSerialPoll() declaration
+ * \brief freemodbusSerialFlush() and freemodbusSerialPoll() declarations
  *
  * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
@@ -14,19 +14,34 @@
 
 #include "distortos/TickClock.hpp"
 
-struct FreemodbusInstance;
+struct FreemodbusSerialInstance;
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * \brief Sends response which waits in frame buffer of instance which sends responses without blocking.
+ *
+ * Bytes are copied to write buffer of serial port only if it has free space, the rest is sent by next call. Frame
+ * buffer is returned to the pool when the whole response is copied.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS
+ *
+ * \return true if no bytes of response wait to be sent, false otherwise
+ */
+
+bool freemodbusSerialFlush(FreemodbusSerialInstance& instance);
+
 /**
  * \brief Polls serial port.
  *
+ * Serial port is not read while response of instance which sends responses without blocking waits in frame buffer.
+ *
  * \param [in] instance is a reference to instance of FreeMODBUS
  * \param [in] deadline is the deadline of polling operation
  */
 
-void freemodbusSerialPoll(FreemodbusInstance& instance, distortos::TickClock::time_point deadline);
+void freemodbusSerialPoll(FreemodbusSerialInstance& instance, distortos::TickClock::time_point deadline);
 
 #endif	// FREEMODBUS_INTEGRATION_FREEMODBUSSERIALPOLL_HPP_
@@ -2,7 +2,7 @@
  * \file
  * \brief Definitions of TCP-related functions for FreeMODBUS
  *
- * \author Copyright (C) 2019-2022 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2019-2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -13,20 +13,33 @@
 
 #if MB_TCP_ENABLED == 1
 
-#include "FreemodbusInstance.hpp"
-#include "ListenSocket.hpp"
+#include "freemodbusCapture.hpp"
+#include "FreemodbusExtensions.hpp"
+#include "freemodbusFrameBuffer.hpp"
+#include "freemodbusListenSockets.hpp"
+#include "freemodbusMbap.hpp"
+#include "FreemodbusTcpExtensions.hpp"
+#include "freemodbusTcpHooks.hpp"
+#include "FunctionHandlerTable.hpp"
+#include "HotRangeCache.hpp"
+#include "ModbusGateway.hpp"
+#include "RequestRateLimiter.hpp"
+#include "TcpTransport.hpp"
 
 #include "mbport.h"
 
 #include "lwip/sockets.h"
 
 #include "distortos/Mutex.hpp"
+#include "distortos/ThisThread.hpp"
 
 #include "estd/ScopeGuard.hpp"
 
 #include <mutex>
 
 #include <cassert>
+#include <cerrno>
+#include <cstring>
 
 namespace
 {
@@ -38,23 +51,229 @@ namespace
 /// default port for Modbus TCP
 constexpr uint16_t defaultPort {502};
 
-/// index of high byte of frame length in MBAP header
-constexpr size_t frameLengthHigh {4};
+/// index of high byte of protocol identifier in MBAP header
+constexpr size_t protocolIdentifierHigh {2};
 
-/// index of low byte of frame length in MBAP header
-constexpr size_t frameLengthLow {frameLengthHigh + 1};
+/// index of low byte of protocol identifier in MBAP header
+constexpr size_t protocolIdentifierLow {protocolIdentifierHigh + 1};
+
+/// index of unit identifier in MBAP header
+constexpr size_t unitIdentifier {frameLengthLow + 1};
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | local functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
 /**
- * \brief Releases client socket from FreemodbusInstance.
+ * \brief Converts pointer to instance of FreeMODBUS to reference to FreemodbusTcpInstance.
+ *
+ * \param [in] instance is a pointer to instance of FreeMODBUS, which must be embedded in FreemodbusTcpInstance
+ *
+ * \return reference to FreemodbusTcpInstance which contains \a instance
+ */
+
+FreemodbusTcpInstance& getTcpInstance(xMBInstance* const instance)
+{
+	return static_cast<FreemodbusTcpInstance&>(*reinterpret_cast<FreemodbusInstance*>(instance));
+}
+
+/**
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance
+ *
+ * \return deadline of sending the batch of responses, distortos::TickClock::time_point::max() if the batch is empty
+ */
+
+distortos::TickClock::time_point getTxBatchDeadline(const FreemodbusTcpInstance& freemodbusInstance)
+{
+	const auto extensions = freemodbusInstance.tcpExtensions;
+	return extensions != nullptr && extensions->txBatchSize != 0 ? extensions->txBatchDeadline :
+			distortos::TickClock::time_point::max();
+}
+
+/**
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance
+ *
+ * \return pointer to transport used on top of client socket, nullptr if socket is used directly
+ */
+
+TcpTransport* getTransport(const FreemodbusTcpInstance& freemodbusInstance)
+{
+	return freemodbusInstance.tcpExtensions != nullptr ? freemodbusInstance.tcpExtensions->transport : nullptr;
+}
+
+/**
+ * \brief Receives data from client socket, using transport if it is set.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance with connected client
+ * \param [out] buffer is a pointer to buffer for received data
+ * \param [in] size is the size of \a buffer, bytes
+ *
+ * \return number of received bytes, 0 if connection was closed, negative value on error
+ */
+
+ssize_t receiveFromClient(FreemodbusTcpInstance& freemodbusInstance, void* const buffer, const size_t size)
+{
+	const auto transport = getTransport(freemodbusInstance);
+	if (transport != nullptr)
+		return transport->receive(freemodbusInstance.clientSocket, buffer, size);
+
+	return lwip_recv(freemodbusInstance.clientSocket, buffer, size, {});
+}
+
+/**
+ * \brief Sends data to client socket, using transport if it is set.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance with connected client
+ * \param [in] iov is a pointer to array with buffers which will be sent in order
+ * \param [in] iovCount is the number of elements in \a iov array
+ *
+ * \return number of sent bytes, negative value on error
+ */
+
+ssize_t sendToClient(FreemodbusTcpInstance& freemodbusInstance, const iovec* const iov, const int iovCount)
+{
+	const auto transport = getTransport(freemodbusInstance);
+	if (transport != nullptr)
+		return transport->send(freemodbusInstance.clientSocket, iov, iovCount);
+
+	return lwip_writev(freemodbusInstance.clientSocket, iov, iovCount);
+}
+
+/**
+ * \brief Notifies all listen sockets to which FreemodbusTcpInstance is bound about connected or disconnected client.
+ *
+ * If notification of any listen socket fails, listen sockets which were already notified are rolled back.
+ *
+ * Must be called with listen sockets range mutex locked.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which listen sockets will be notified
+ * \param [in] notify is a pointer to member function of ListenSocket used for notification
+ * \param [in] rollback is a pointer to member function of ListenSocket used for rollback
+ *
+ * \return 0 on success, error code otherwise:
+ * - error codes returned by \a notify;
+ */
+
+int notifyListenSockets(FreemodbusTcpInstance& freemodbusInstance, int (ListenSocket::* const notify)(),
+		int (ListenSocket::* const rollback)())
+{
+	size_t notified {};
+	int ret {};
+	forEachListenSocket(freemodbusInstance,
+			[notify, &notified, &ret](ListenSocket& listenSocket)
+			{
+				if (ret != 0)
+					return;
+
+				ret = (listenSocket.*notify)();
+				if (ret == 0)
+					++notified;
+			});
+
+	if (ret == 0)
+		return 0;
+
+	forEachListenSocket(freemodbusInstance,
+			[rollback, &notified](ListenSocket& listenSocket)
+			{
+				if (notified == 0)
+					return;
+
+				(listenSocket.*rollback)();
+				--notified;
+			});
+
+	return ret;
+}
+
+/**
+ * \brief Binds FreemodbusTcpInstance to listen sockets for given port.
+ *
+ * Must be called with the mutex for listen sockets locked.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which is not bound to any listen socket
+ * \param [in] port is the port of Modbus TCP
+ *
+ * \return true if the instance was bound, false otherwise
+ */
+
+bool bindListenSockets(FreemodbusTcpInstance& freemodbusInstance, const uint16_t port)
+{
+	assert(freemodbusInstance.listenSocket == nullptr);
+
+	// instance is bound to all listen sockets with matching fixed port, so it accepts clients from each of them
+	const auto fixedListenSocket = std::find_if(freemodbusInstance.listenSocketsRange.begin(),
+			freemodbusInstance.listenSocketsRange.end(),
+			[port](const ListenSocket& listenSocket) -> bool
+			{
+				return listenSocket.getFixedPort() == port;
+			});
+	if (fixedListenSocket != freemodbusInstance.listenSocketsRange.end())
+	{
+		freemodbusInstance.listenSocket = fixedListenSocket;
+
+		size_t bound {};
+		int ret {};
+		forEachListenSocket(freemodbusInstance,
+				[port, &bound, &ret](ListenSocket& listenSocket)
+				{
+					if (ret != 0)
+						return;
+
+					ret = listenSocket.bind(port);
+					if (ret == 0)
+						++bound;
+				});
+
+		if (ret == 0)
+			return true;
+
+		forEachListenSocket(freemodbusInstance,
+				[&bound](ListenSocket& listenSocket)
+				{
+					if (bound == 0)
+						return;
+
+					listenSocket.unbind();
+					--bound;
+				});
+
+		freemodbusInstance.listenSocket = nullptr;
+		return false;
+	}
+
+	auto chosenListenSocket = std::find_if(freemodbusInstance.listenSocketsRange.begin(),
+			freemodbusInstance.listenSocketsRange.end(),
+			[port](const ListenSocket& listenSocket) -> bool
+			{
+				return listenSocket.getFixedPort() == 0 && listenSocket.getPort() == port;
+			});
+
+	if (chosenListenSocket == freemodbusInstance.listenSocketsRange.end())
+		chosenListenSocket = std::find_if(freemodbusInstance.listenSocketsRange.begin(),
+				freemodbusInstance.listenSocketsRange.end(),
+				[](const ListenSocket& listenSocket) -> bool
+				{
+					return listenSocket.getFixedPort() == 0 && listenSocket.getPort() == 0;
+				});
+
+	if (chosenListenSocket == freemodbusInstance.listenSocketsRange.end())
+		return false;
+
+	if (chosenListenSocket->bind(port) != 0)
+		return false;
+
+	freemodbusInstance.listenSocket = chosenListenSocket;
+	return true;
+}
+
+/**
+ * \brief Releases client socket from FreemodbusTcpInstance.
  *
- * \param [in] freemodbusInstance is a reference to FreemodbusInstance from which client socket will be released
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance from which client socket will be released
  */
 
-void releaseClientSocket(FreemodbusInstance& freemodbusInstance)
+void releaseClientSocket(FreemodbusTcpInstance& freemodbusInstance)
 {
 	{
 		assert(freemodbusInstance.listenSocket != nullptr);
@@ -62,24 +281,249 @@ void releaseClientSocket(FreemodbusInstance& freemodbusInstance)
 
 		std::lock_guard<distortos::Mutex> lockGuard {*freemodbusInstance.listenSocketsRangeMutex};
 
-		const auto ret = freemodbusInstance.listenSocket->clientDisconnected() != 0;
+		const auto ret = notifyListenSockets(freemodbusInstance, &ListenSocket::clientDisconnected,
+				&ListenSocket::clientConnected);
 		if (ret != 0)
 			return;
 	}
 
-	while (lwip_recv(freemodbusInstance.clientSocket, freemodbusInstance.frameBuffer,
-			sizeof(freemodbusInstance.frameBuffer), MSG_DONTWAIT) > 0);
+	const auto extensions = freemodbusInstance.tcpExtensions;
+	if (extensions != nullptr && extensions->transport != nullptr)
+		extensions->transport->close(freemodbusInstance.clientSocket);
+
+	// instance using the pool may have no buffer at this moment
+	uint8_t drainBuffer[16];
+	const auto buffer = freemodbusInstance.frameBuffer != nullptr ? freemodbusInstance.frameBuffer : drainBuffer;
+	const auto bufferSize = freemodbusInstance.frameBuffer != nullptr ? freemodbusInstance.frameBufferSize :
+			sizeof(drainBuffer);
+	while (lwip_recv(freemodbusInstance.clientSocket, buffer, bufferSize, MSG_DONTWAIT) > 0);
 	lwip_close(freemodbusInstance.clientSocket);
 	freemodbusInstance.clientSocket = -1;
+	if (extensions != nullptr)
+	{
+		extensions->txBatchSize = {};
+		extensions->admissionTime = {};
+	}
+	freemodbusInstance.bytesInBuffer = {};
+	freemodbusInstance.bytesToSend = {};
+	releaseFrameBuffer(freemodbusInstance);
+}
+
+/**
+ * \brief Sends the batch of responses.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which batch will be sent
+ * \param [in] frame is a pointer to frame which is sent after the batch, nullptr if none
+ * \param [in] length is the length of \a frame, bytes
+ *
+ * \return true if the batch and \a frame were sent, false otherwise
+ */
+
+bool sendTxBatch(FreemodbusTcpInstance& freemodbusInstance, const uint8_t* const frame, const size_t length)
+{
+	assert(freemodbusInstance.tcpExtensions != nullptr);
+
+	auto& extensions = *freemodbusInstance.tcpExtensions;
+	iovec iov[2] {};
+	iov[0].iov_base = extensions.txBatchRange.begin();
+	iov[0].iov_len = extensions.txBatchSize;
+	iov[1].iov_base = const_cast<uint8_t*>(frame);
+	iov[1].iov_len = length;
+	const auto totalLength = extensions.txBatchSize + length;
+	extensions.txBatchSize = {};
+
+	const auto ret = sendToClient(freemodbusInstance, iov, frame != nullptr ? 2 : 1);
+	if (ret < 0 || static_cast<size_t>(ret) != totalLength)
+	{
+		releaseClientSocket(freemodbusInstance);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * \brief Sends response to request frame which is stored in buffer.
+ *
+ * Transaction identifier, protocol identifier and unit identifier are the same as in the request.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which received the request
+ * \param [in] pduSize is the size of response PDU stored in buffer after MBAP header, bytes
+ */
+
+void sendResponse(FreemodbusTcpInstance& freemodbusInstance, const size_t pduSize)
+{
+	const auto length = pduSize + 1;
+	freemodbusInstance.frameBuffer[frameLengthHigh] = length >> 8;
+	freemodbusInstance.frameBuffer[frameLengthLow] = length;
+	xMBTCPPortSendResponse(&freemodbusInstance.rawInstance, freemodbusInstance.frameBuffer,
+			FreemodbusTcpInstance::mbapHeaderSize + pduSize);
+}
+
+/**
+ * \brief Takes complete request frame from buffer.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which received the request
+ *
+ * \return size of request PDU, bytes, 0 if the frame should be dropped
+ */
+
+size_t takeRequest(FreemodbusTcpInstance& freemodbusInstance)
+{
+	const auto requestSize = freemodbusInstance.bytesInBuffer;
+	freemodbusInstance.bytesInBuffer = {};
+
+	// frames of other protocols and frames without PDU are silently dropped, just like FreeMODBUS does
+	if (freemodbusInstance.frameBuffer[protocolIdentifierHigh] != 0 ||
+			freemodbusInstance.frameBuffer[protocolIdentifierLow] != 0 ||
+			requestSize <= FreemodbusTcpInstance::mbapHeaderSize)
+		return {};
+
+	return requestSize - FreemodbusTcpInstance::mbapHeaderSize;
+}
+
+/**
+ * \brief Applies limit of rate of requests to complete request frame.
+ *
+ * Request which must be delayed is deferred - it is kept in the frame buffer and FreemodbusTcpExtensions::admissionTime
+ * is set, the request is admitted by the first call after that time point. Request which exceeds its rate is answered
+ * with Server Busy exception.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which received the request
+ *
+ * \return true if the request may be handled, false if it was deferred, answered or dropped
+ */
+
+bool admitRequest(FreemodbusTcpInstance& freemodbusInstance)
+{
+	const auto extensions = freemodbusInstance.tcpExtensions;
+	if (extensions == nullptr || extensions->requestRateLimiter == nullptr)
+		return true;
+
+	if (extensions->admissionTime != distortos::TickClock::time_point{})
+	{
+		if (distortos::TickClock::now() < extensions->admissionTime)
+			return false;
+
+		extensions->admissionTime = {};
+		return true;
+	}
+
+	distortos::TickClock::time_point admissionTime;
+	if (extensions->requestRateLimiter->admit(extensions->masterAddress, extensions->masterPort,
+			freemodbusInstance.frameBuffer[unitIdentifier], admissionTime) == 0)
+	{
+		if (admissionTime <= distortos::TickClock::now())
+			return true;
+
+		extensions->admissionTime = admissionTime;
+		return false;
+	}
+
+	const auto pduSize = takeRequest(freemodbusInstance);
+	if (pduSize == 0)
+		return false;
+
+	const auto pdu = &freemodbusInstance.frameBuffer[FreemodbusTcpInstance::mbapHeaderSize];
+	pdu[0] |= MB_FUNC_ERROR;
+	pdu[1] = MB_EX_SLAVE_BUSY;
+	sendResponse(freemodbusInstance, 2);
+	return false;
+}
+
+/**
+ * \brief Answers complete request frame from the hot range cache.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which received the request
+ *
+ * \return true if the request was answered, false if it must be handled in the usual way
+ */
+
+bool answerFromHotRangeCache(FreemodbusTcpInstance& freemodbusInstance)
+{
+	const auto hotRangeCache =
+			freemodbusInstance.extensions != nullptr ? freemodbusInstance.extensions->hotRangeCache : nullptr;
+	if (hotRangeCache == nullptr || freemodbusInstance.frameBuffer[protocolIdentifierHigh] != 0 ||
+			freemodbusInstance.frameBuffer[protocolIdentifierLow] != 0 ||
+			freemodbusInstance.bytesInBuffer <= FreemodbusTcpInstance::mbapHeaderSize)
+		return false;
+
+	size_t pduSize {freemodbusInstance.bytesInBuffer - FreemodbusTcpInstance::mbapHeaderSize};
+	if (hotRangeCache->answerPdu(freemodbusInstance.frameBuffer[unitIdentifier],
+			&freemodbusInstance.frameBuffer[FreemodbusTcpInstance::mbapHeaderSize], pduSize,
+			freemodbusInstance.frameBufferSize - FreemodbusTcpInstance::mbapHeaderSize) == false)
+		return false;
+
+	freemodbusInstance.bytesInBuffer = {};
+	sendResponse(freemodbusInstance, pduSize);
+	return true;
+}
+
+/**
+ * \brief Executes complete request frame with function handler from the table and sends back the response.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which received the request
+ * \param [in] functionHandlerTable is a reference to table of function handlers of \a freemodbusInstance
+ */
+
+void executeWithFunctionHandlerTable(FreemodbusTcpInstance& freemodbusInstance,
+		const FunctionHandlerTable& functionHandlerTable)
+{
+	uint16_t pduSize = takeRequest(freemodbusInstance);
+	if (pduSize == 0)
+		return;
+
+	const auto pdu = &freemodbusInstance.frameBuffer[FreemodbusTcpInstance::mbapHeaderSize];
+	const auto exception = functionHandlerTable.dispatch(&freemodbusInstance.rawInstance, pdu, &pduSize);
+	if (exception != MB_EX_NONE)
+	{
+		pdu[0] |= MB_FUNC_ERROR;
+		pdu[1] = exception;
+		pduSize = 2;
+	}
+
+	sendResponse(freemodbusInstance, pduSize);
+}
+
+/**
+ * \brief Forwards complete request frame to the gateway and sends back the response.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which received the request
+ * \param [in] gateway is a reference to gateway of \a freemodbusInstance
+ */
+
+void forwardToGateway(FreemodbusTcpInstance& freemodbusInstance, ModbusGateway& gateway)
+{
+	const auto requestSize = takeRequest(freemodbusInstance);
+	if (requestSize == 0)
+		return;
+
+	// Modbus TCP frame may carry longer PDU than fits in Modbus RTU frame
+	if (requestSize > ModbusGateway::maxPduSize)
+	{
+		const auto pdu = &freemodbusInstance.frameBuffer[FreemodbusTcpInstance::mbapHeaderSize];
+		pdu[0] |= MB_FUNC_ERROR;
+		pdu[1] = MB_EX_ILLEGAL_DATA_VALUE;
+		sendResponse(freemodbusInstance, 2);
+		return;
+	}
+
+	const auto responseSize = gateway.transact(freemodbusInstance.frameBuffer[unitIdentifier],
+			&freemodbusInstance.frameBuffer[FreemodbusTcpInstance::mbapHeaderSize], requestSize,
+			freemodbusInstance.frameBufferSize - FreemodbusTcpInstance::mbapHeaderSize);
+	if (responseSize == 0)
+		return;
+
+	sendResponse(freemodbusInstance, responseSize);
 }
 
 /**
  * \brief Disconnects client if Modbus TCP keepalive deadline has expired.
  *
- * \param [in] freemodbusInstance is a reference to FreemodbusInstance from which client socket will be released
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance from which client socket will be released
  */
 
-void checkKeepalive(FreemodbusInstance& freemodbusInstance)
+void checkKeepalive(FreemodbusTcpInstance& freemodbusInstance)
 {
 	// if client is disconnected do nothing
 	if (freemodbusInstance.clientSocket == -1)
@@ -93,16 +537,150 @@ void checkKeepalive(FreemodbusInstance& freemodbusInstance)
 		releaseClientSocket(freemodbusInstance);
 }
 
+/**
+ * \brief Applies pending change of port of FreemodbusTcpInstance.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusTcpInstance which port will be changed
+ */
+
+void applyPortReconfiguration(FreemodbusTcpInstance& freemodbusInstance)
+{
+	if (freemodbusInstance.tcpExtensions == nullptr)
+		return;
+
+	const auto port = freemodbusInstance.tcpExtensions->pendingPort.exchange({}, std::memory_order_acquire);
+	if (port == 0)
+		return;
+
+	if (freemodbusInstance.hooks != nullptr)
+	{
+		freemodbusInstance.hooks->reconfigurePort(freemodbusInstance, port);
+		return;
+	}
+
+	if (freemodbusInstance.listenSocket == nullptr || freemodbusInstance.listenSocket->getPort() == port)
+		return;
+
+	assert(freemodbusInstance.listenSocketsRangeMutex != nullptr);
+
+	std::lock_guard<distortos::Mutex> lockGuard {*freemodbusInstance.listenSocketsRangeMutex};
+
+	const auto previousListenSocket = freemodbusInstance.listenSocket;
+	freemodbusInstance.listenSocket = nullptr;
+	if (bindListenSockets(freemodbusInstance, port) == false)
+	{
+		freemodbusInstance.listenSocket = previousListenSocket;
+		return;
+	}
+
+	const auto unbind = [](ListenSocket& listenSocket)
+			{
+				listenSocket.unbind();
+			};
+
+	// connected client is counted by new listen sockets before it is released from the previous ones
+	const auto connected = freemodbusInstance.clientSocket != -1;
+	if (connected == true && notifyListenSockets(freemodbusInstance, &ListenSocket::clientConnected,
+			&ListenSocket::clientDisconnected) != 0)
+	{
+		forEachListenSocket(freemodbusInstance, unbind);
+		freemodbusInstance.listenSocket = previousListenSocket;
+		return;
+	}
+
+	const auto newListenSocket = freemodbusInstance.listenSocket;
+	freemodbusInstance.listenSocket = previousListenSocket;
+	if (connected == true)
+		notifyListenSockets(freemodbusInstance, &ListenSocket::clientDisconnected, &ListenSocket::clientConnected);
+	forEachListenSocket(freemodbusInstance, unbind);
+	freemodbusInstance.listenSocket = newListenSocket;
+}
+
 }	// namespace
 
+/*---------------------------------------------------------------------------------------------------------------------+
+| FreemodbusTcpInstance's public functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int FreemodbusTcpInstance::reconfigurePort(const uint16_t port)
+{
+	if (tcpExtensions == nullptr)
+		return ENOTSUP;
+
+	if (tcpExtensions->pendingPort.load(std::memory_order_acquire) != 0)
+		return EBUSY;
+
+	tcpExtensions->pendingPort.store(port != 0 ? port : defaultPort, std::memory_order_release);
+	return 0;
+}
+
 /*---------------------------------------------------------------------------------------------------------------------+
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-void freemodbusTcpPoll(FreemodbusInstance& instance, const distortos::TickClock::time_point deadline)
+bool freemodbusTcpFlush(FreemodbusTcpInstance& instance)
+{
+	if (instance.bytesToSend == 0)
+		return true;
+
+	assert(instance.frameBuffer != nullptr);
+	const auto ret = lwip_send(instance.clientSocket, instance.frameBuffer, instance.bytesToSend, MSG_DONTWAIT);
+	if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+		return false;
+	if (ret <= 0)
+	{
+		releaseClientSocket(instance);
+		return true;
+	}
+
+	instance.bytesToSend -= ret;
+	if (instance.bytesToSend != 0)
+	{
+		memmove(instance.frameBuffer, instance.frameBuffer + ret, instance.bytesToSend);
+		return false;
+	}
+
+	releaseFrameBuffer(instance);
+	return true;
+}
+
+bool freemodbusTcpHandleRequest(FreemodbusTcpInstance& instance)
 {
+	if (admitRequest(instance) == false || answerFromHotRangeCache(instance) == true)
+		return false;
+
+	const auto extensions = instance.tcpExtensions;
+	const auto gateway = extensions != nullptr ? extensions->gateway : nullptr;
+	const auto functionHandlerTable = extensions != nullptr ? extensions->functionHandlerTable : nullptr;
+	if (gateway == nullptr && functionHandlerTable == nullptr)
+	{
+		xMBPortEventPost(&instance.rawInstance, EV_FRAME_RECEIVED);
+		return true;
+	}
+
+	if (gateway != nullptr)
+		forwardToGateway(instance, *gateway);
+	else
+		executeWithFunctionHandlerTable(instance, *functionHandlerTable);
+	return false;
+}
+
+void freemodbusTcpPoll(FreemodbusTcpInstance& instance, const distortos::TickClock::time_point deadline)
+{
+	applyPortReconfiguration(instance);
+
+	if (instance.hooks != nullptr)
+	{
+		instance.hooks->poll(instance, deadline);
+		return;
+	}
+
 	assert(instance.listenSocket != nullptr);
 
+	// response which waits in the frame buffer is sent before anything is received
+	if (freemodbusTcpFlush(instance) == false)
+		return;
+
 	distortos::TickClock::duration left;
 	while ((left = deadline - distortos::TickClock::now()) >= distortos::TickClock::duration{})
 	{
@@ -112,38 +690,94 @@ void freemodbusTcpPoll(FreemodbusInstance& instance, const distortos::TickClock:
 					checkKeepalive(instance);
 				});
 
+		// master which waits for response to deferred request is not disconnected by keepalive
+		if (freemodbusTcpIsDeferred(instance) == true)
+		{
+			keepaliveScopeGuard.release();
+			if (freemodbusTcpWaitForAdmission(instance, deadline) == false)
+				return;
+
+			if (freemodbusTcpHandleRequest(instance) == true)
+				return;
+
+			releaseFrameBuffer(instance);
+			instance.tcpKeepaliveDeadline = distortos::TickClock::now() + instance.tcpKeepaliveDuration;
+			continue;
+		}
+
 		fd_set fdSet;
 		FD_ZERO(&fdSet);
+		auto maxSocket = instance.clientSocket;
 		if (instance.clientSocket != -1)
 			FD_SET(instance.clientSocket, &fdSet);
-		else if (instance.listenSocket->getSocket() != -1)
-			FD_SET(instance.listenSocket->getSocket(), &fdSet);
+		else
+			forEachListenSocket(instance,
+					[&fdSet, &maxSocket](const ListenSocket& listenSocket)
+					{
+						if (listenSocket.getSocket() == -1)
+							return;
+
+						FD_SET(listenSocket.getSocket(), &fdSet);
+						maxSocket = std::max(maxSocket, listenSocket.getSocket());
+					});
+
+		// data already decrypted by transport is not visible to select, so the socket must not be waited for
+		const auto transport = instance.clientSocket != -1 ? getTransport(instance) : nullptr;
+		const auto buffered = transport != nullptr && transport->hasBufferedData() == true;
+		const auto transportDeadline = transport != nullptr ? transport->getDeadline() :
+				distortos::TickClock::time_point::max();
+		// wait no longer than until the deadline of the batch of responses or the deadline of transport
+		const auto waitDeadline = std::min(transportDeadline, getTxBatchDeadline(instance));
 
 		{
+			if (buffered == true)
+				left = {};
+			else if (waitDeadline != distortos::TickClock::time_point::max())
+				left = std::max(std::min(left, waitDeadline - distortos::TickClock::now()),
+						distortos::TickClock::duration{});
+
 			const auto leftSeconds = std::chrono::duration_cast<std::chrono::seconds>(left);
 			const auto leftMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(left - leftSeconds);
 			timeval timeout {};
 			timeout.tv_sec = leftSeconds.count();
 			timeout.tv_usec = leftMicroseconds.count();
-			if (lwip_select(std::max(instance.clientSocket, instance.listenSocket->getSocket()) + 1, &fdSet, nullptr,
-					nullptr, &timeout) <= 0)
+			const auto ret = lwip_select(maxSocket + 1, &fdSet, nullptr, nullptr, &timeout);
+			if (distortos::TickClock::now() >= getTxBatchDeadline(instance))
+				sendTxBatch(instance, nullptr, {});
+			// transport whose deadline passed is called without data, so it can handle the timeout
+			if ((buffered == true || distortos::TickClock::now() >= transportDeadline) && instance.clientSocket != -1)
+				FD_SET(instance.clientSocket, &fdSet);
+			else if (ret <= 0)
 				return;
 		}
 
 		if (instance.clientSocket != -1 && FD_ISSET(instance.clientSocket, &fdSet) != 0)
 		{
-			const uint16_t length = instance.bytesInBuffer < FreemodbusInstance::mbapHeaderSize - 1 ? 0 :
-					((instance.frameBuffer[frameLengthHigh] << 8) | instance.frameBuffer[frameLengthLow]);
-			const size_t totalSize = FreemodbusInstance::mbapHeaderSize - 1 + length;
-			if (totalSize > sizeof(instance.frameBuffer))
+			// if the pool is empty, data is left in the socket, so TCP flow control throttles the client
+			if (acquireFrameBuffer(instance) == false)
+			{
+				distortos::ThisThread::sleepUntil(std::min(deadline,
+						distortos::TickClock::now() + frameBufferRetryPeriod));
+				continue;
+			}
+
+			const auto totalSize = getMbapFrameSize(instance.frameBuffer, instance.bytesInBuffer);
+			if (totalSize > instance.frameBufferSize)
 			{
 				instance.bytesInBuffer = 0;
 				releaseClientSocket(instance);
 				continue;
 			}
 
-			const auto ret = lwip_recv(instance.clientSocket, &instance.frameBuffer[instance.bytesInBuffer],
-					totalSize - instance.bytesInBuffer, {});
+			const auto ret = receiveFromClient(instance, &instance.frameBuffer[instance.bytesInBuffer],
+					totalSize - instance.bytesInBuffer);
+			// transport may need more data (e.g. rest of the record) before it returns anything
+			if (ret < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			{
+				if (instance.bytesInBuffer == 0)
+					releaseFrameBuffer(instance);
+				continue;
+			}
 			if (ret <= 0)
 			{
 				instance.bytesInBuffer = 0;
@@ -153,18 +787,41 @@ void freemodbusTcpPoll(FreemodbusInstance& instance, const distortos::TickClock:
 			else
 			{
 				instance.bytesInBuffer += ret;
-				if (totalSize >= FreemodbusInstance::mbapHeaderSize && instance.bytesInBuffer == totalSize)
+				if (totalSize >= FreemodbusTcpInstance::mbapHeaderSize && instance.bytesInBuffer == totalSize)
 				{
 					instance.tcpKeepaliveDeadline = distortos::TickClock::now() + instance.tcpKeepaliveDuration;
-					xMBPortEventPost(&instance.rawInstance, EV_FRAME_RECEIVED);
 					keepaliveScopeGuard.release();
-					return;
+					freemodbusCapture(instance, CaptureRing::Direction::received, CaptureRing::Protocol::tcp,
+							instance.frameBuffer, instance.bytesInBuffer);
+					if (freemodbusTcpHandleRequest(instance) == true)
+						return;
+
+					// deferred request keeps the frame buffer
+					if (freemodbusTcpIsDeferred(instance) == true)
+						continue;
+
+					releaseFrameBuffer(instance);
+					instance.tcpKeepaliveDeadline = distortos::TickClock::now() + instance.tcpKeepaliveDuration;
+					continue;
 				}
 			}
 		}
-		if (instance.listenSocket->getSocket() != -1 && FD_ISSET(instance.listenSocket->getSocket(), &fdSet) != 0)
+
+		auto readyListenSocket = -1;
+		if (instance.clientSocket == -1)
+			forEachListenSocket(instance,
+					[&fdSet, &readyListenSocket](const ListenSocket& listenSocket)
+					{
+						if (readyListenSocket == -1 && listenSocket.getSocket() != -1 &&
+								FD_ISSET(listenSocket.getSocket(), &fdSet) != 0)
+							readyListenSocket = listenSocket.getSocket();
+					});
+		if (readyListenSocket != -1)
 		{
-			const auto clientSocket = lwip_accept(instance.listenSocket->getSocket(), nullptr, nullptr);
+			sockaddr_storage masterAddress {};
+			socklen_t masterAddressLength = sizeof(masterAddress);
+			const auto clientSocket = lwip_accept(readyListenSocket, reinterpret_cast<sockaddr*>(&masterAddress),
+					&masterAddressLength);
 			if (clientSocket == -1)
 				return;
 
@@ -181,24 +838,82 @@ void freemodbusTcpPoll(FreemodbusInstance& instance, const distortos::TickClock:
 
 				std::lock_guard<distortos::Mutex> lockGuard {*instance.listenSocketsRangeMutex};
 
-				const auto ret = instance.listenSocket->clientConnected();
+				const auto ret = notifyListenSockets(instance, &ListenSocket::clientConnected,
+						&ListenSocket::clientDisconnected);
 				if (ret != 0)
 					return;
 			}
 
+			const auto transport = getTransport(instance);
+			if (transport != nullptr && transport->accept(clientSocket) != 0)
+			{
+				std::lock_guard<distortos::Mutex> lockGuard {*instance.listenSocketsRangeMutex};
+
+				notifyListenSockets(instance, &ListenSocket::clientDisconnected, &ListenSocket::clientConnected);
+				return;
+			}
+
 			closeScopeGuard.release();
 			instance.clientSocket = clientSocket;
+			freemodbusTcpSetMasterAddress(instance, masterAddress);
 			keepaliveScopeGuard.release();
 		}
 	}
 }
 
+void freemodbusTcpSetMasterAddress(FreemodbusTcpInstance& instance, const sockaddr_storage& masterAddress)
+{
+	const auto extensions = instance.tcpExtensions;
+	if (extensions == nullptr)
+		return;
+
+#if LWIP_IPV6 == 1
+
+	if (masterAddress.ss_family == AF_INET6)
+	{
+		const auto& masterAddress6 = reinterpret_cast<const sockaddr_in6&>(masterAddress);
+		const auto bytes = reinterpret_cast<const uint8_t*>(&masterAddress6.sin6_addr);
+		// ::ffff:a.b.c.d
+		constexpr uint8_t ipv4MappedPrefix[12] {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0xff, 0xff};
+		uint32_t address {};
+		if (memcmp(bytes, ipv4MappedPrefix, sizeof(ipv4MappedPrefix)) == 0)
+			memcpy(&address, bytes + sizeof(ipv4MappedPrefix), sizeof(address));
+		extensions->masterAddress = address;
+		extensions->masterPort = masterAddress6.sin6_port;
+		return;
+	}
+
+#endif	// LWIP_IPV6 == 1
+
+	const auto& masterAddress4 = reinterpret_cast<const sockaddr_in&>(masterAddress);
+	extensions->masterAddress = masterAddress4.sin_addr.s_addr;
+	extensions->masterPort = masterAddress4.sin_port;
+}
+
+bool freemodbusTcpWaitForAdmission(FreemodbusTcpInstance& instance, const distortos::TickClock::time_point deadline)
+{
+	assert(freemodbusTcpIsDeferred(instance) == true);
+
+	const auto& extensions = *instance.tcpExtensions;
+	distortos::ThisThread::sleepUntil(std::min({deadline, extensions.admissionTime, getTxBatchDeadline(instance)}));
+
+	const auto now = distortos::TickClock::now();
+	if (now >= getTxBatchDeadline(instance))
+		sendTxBatch(instance, nullptr, {});
+	return now >= extensions.admissionTime;
+}
+
 extern "C" void vMBTCPPortClose(xMBInstance* const instance)
 {
 	assert(instance != nullptr);
 	vMBTCPPortDisable(instance);
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
+	auto& freemodbusInstance = getTcpInstance(instance);
+	if (freemodbusInstance.hooks != nullptr)
+	{
+		freemodbusInstance.hooks->close(freemodbusInstance);
+		return;
+	}
 
 	{
 		assert(freemodbusInstance.listenSocket != nullptr);
@@ -206,7 +921,11 @@ extern "C" void vMBTCPPortClose(xMBInstance* const instance)
 
 		std::lock_guard<distortos::Mutex> lockGuard {*freemodbusInstance.listenSocketsRangeMutex};
 
-		freemodbusInstance.listenSocket->unbind();
+		forEachListenSocket(freemodbusInstance,
+				[](ListenSocket& listenSocket)
+				{
+					listenSocket.unbind();
+				});
 	}
 
 	freemodbusInstance.listenSocket = nullptr;
@@ -216,8 +935,10 @@ extern "C" void vMBTCPPortDisable(xMBInstance* const instance)
 {
 	assert(instance != nullptr);
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
-	if (freemodbusInstance.clientSocket != -1)
+	auto& freemodbusInstance = getTcpInstance(instance);
+	if (freemodbusInstance.hooks != nullptr)
+		freemodbusInstance.hooks->disable(freemodbusInstance);
+	else if (freemodbusInstance.clientSocket != -1)
 		releaseClientSocket(freemodbusInstance);
 }
 
@@ -225,7 +946,7 @@ extern "C" bool xMBTCPPortGetRequest(xMBInstance* const instance, uint8_t** cons
 {
 	assert(instance != nullptr);
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
+	auto& freemodbusInstance = getTcpInstance(instance);
 
 	*frame = freemodbusInstance.frameBuffer;
 	*length = freemodbusInstance.bytesInBuffer;
@@ -236,50 +957,78 @@ extern "C" bool xMBTCPPortGetRequest(xMBInstance* const instance, uint8_t** cons
 extern "C" bool xMBTCPPortInit(xMBInstance* const instance, const uint16_t port)
 {
 	assert(instance != nullptr);
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
-	assert(freemodbusInstance.listenSocket == nullptr);
-	assert(freemodbusInstance.listenSocketsRangeMutex != nullptr);
+	auto& freemodbusInstance = getTcpInstance(instance);
 	const auto realPort = port != 0 ? port : defaultPort;
+	if (freemodbusInstance.hooks != nullptr)
+		return freemodbusInstance.hooks->init(freemodbusInstance, realPort);
 
-	std::lock_guard<distortos::Mutex> lockGuard {*freemodbusInstance.listenSocketsRangeMutex};
-
-	auto chosenListenSocket = std::find_if(freemodbusInstance.listenSocketsRange.begin(),
-			freemodbusInstance.listenSocketsRange.end(),
-			[realPort](const ListenSocket& listenSocket) -> bool
-			{
-				return listenSocket.getPort() == realPort;
-			});
-
-	if (chosenListenSocket == freemodbusInstance.listenSocketsRange.end())
-		chosenListenSocket = std::find_if(freemodbusInstance.listenSocketsRange.begin(),
-				freemodbusInstance.listenSocketsRange.end(),
-				[](const ListenSocket& listenSocket) -> bool
-				{
-					return listenSocket.getPort() == 0;
-				});
-
-	if (chosenListenSocket == freemodbusInstance.listenSocketsRange.end())
-		return false;
+	assert(freemodbusInstance.listenSocketsRangeMutex != nullptr);
 
-	if (chosenListenSocket->bind(realPort) != 0)
-		return false;
+	std::lock_guard<distortos::Mutex> lockGuard {*freemodbusInstance.listenSocketsRangeMutex};
 
-	freemodbusInstance.listenSocket = chosenListenSocket;
-	return true;
+	return bindListenSockets(freemodbusInstance, realPort);
 }
 
 extern "C" bool xMBTCPPortSendResponse(xMBInstance* const instance, const uint8_t* const frame, const uint16_t length)
 {
 	assert(instance != nullptr);
 
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
-	const auto ret = lwip_send(freemodbusInstance.clientSocket, frame, length, {});
+	auto& freemodbusInstance = getTcpInstance(instance);
+	if (freemodbusInstance.hooks != nullptr)
+		return freemodbusInstance.hooks->sendResponse(freemodbusInstance, frame, length);
+
+	freemodbusCapture(freemodbusInstance, CaptureRing::Direction::sent, CaptureRing::Protocol::tcp, frame, length);
+
+	const auto extensions = freemodbusInstance.tcpExtensions;
+	if (extensions != nullptr && extensions->txBatchRange.size() != 0)
+	{
+		// if next pipelined request is already waiting, response is deferred to be sent together with next ones
+		int available {};
+		const auto pending = (extensions->transport != nullptr && extensions->transport->hasBufferedData() == true) ||
+				(lwip_ioctl(freemodbusInstance.clientSocket, FIONREAD, &available) == 0 && available > 0);
+		if (pending == true && extensions->txBatchSize + length <= extensions->txBatchRange.size())
+		{
+			if (extensions->txBatchSize == 0)
+				extensions->txBatchDeadline = distortos::TickClock::now() + extensions->txBatchDelay;
+
+			memcpy(extensions->txBatchRange.begin() + extensions->txBatchSize, frame, length);
+			extensions->txBatchSize += length;
+			releaseFrameBuffer(freemodbusInstance);
+			return true;
+		}
+
+		if (extensions->txBatchSize != 0)
+		{
+			if (sendTxBatch(freemodbusInstance, frame, length) == false)
+				return false;
+
+			releaseFrameBuffer(freemodbusInstance);
+			return true;
+		}
+	}
+
+	// the part of the response which cannot be sent without blocking is sent by next calls of freemodbusTcpFlush()
+	if (freemodbusInstance.nonBlockingSend == true && getTransport(freemodbusInstance) == nullptr)
+	{
+		assert(freemodbusInstance.frameBuffer != nullptr && length <= freemodbusInstance.frameBufferSize);
+		if (frame != freemodbusInstance.frameBuffer)
+			memmove(freemodbusInstance.frameBuffer, frame, length);
+		freemodbusInstance.bytesToSend = length;
+		freemodbusTcpFlush(freemodbusInstance);
+		return freemodbusInstance.clientSocket != -1;
+	}
+
+	iovec iov {};
+	iov.iov_base = const_cast<uint8_t*>(frame);
+	iov.iov_len = length;
+	const auto ret = sendToClient(freemodbusInstance, &iov, 1);
 	if (ret != length)
 	{
 		releaseClientSocket(freemodbusInstance);
 		return false;
 	}
 
+	releaseFrameBuffer(freemodbusInstance);
 	return true;
 }
 
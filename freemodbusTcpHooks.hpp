@@ -0,0 +1,112 @@
+/**
+ * \file
+ * \brief FreemodbusTcpHooks struct header and declarations of functions shared by implementations of Modbus TCP port
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_FREEMODBUSTCPHOOKS_HPP_
+#define FREEMODBUS_INTEGRATION_FREEMODBUSTCPHOOKS_HPP_
+
+#include "FreemodbusTcpExtensions.hpp"
+#include "FreemodbusTcpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "lwip/sockets.h"
+
+/// period of retries of taking frame buffer from empty pool
+constexpr std::chrono::milliseconds frameBufferRetryPeriod {10};
+
+/**
+ * FreemodbusTcpHooks struct is a set of functions which implement Modbus TCP port of instance which does not use listen
+ * sockets and connected client socket (FreemodbusUdpInstance and FreemodbusLocalInstance).
+ *
+ * Instance with hooks (FreemodbusTcpInstance::hooks) is handled only by these functions, instance without hooks is
+ * handled by the port for listen sockets and connected client socket from freemodbusTcp.cpp.
+ */
+
+struct FreemodbusTcpHooks
+{
+	/// opens the instance for given port, returns true on success, false otherwise - called by xMBTCPPortInit()
+	bool (*init)(FreemodbusTcpInstance& instance, uint16_t port);
+
+	/// applies pending change of port - called by freemodbusTcpPoll() before poll
+	void (*reconfigurePort)(FreemodbusTcpInstance& instance, uint16_t port);
+
+	/// polls the instance until the deadline - called by freemodbusTcpPoll()
+	void (*poll)(FreemodbusTcpInstance& instance, distortos::TickClock::time_point deadline);
+
+	/// sends response to request which is currently handled, returns true on success, false otherwise - called by
+	/// xMBTCPPortSendResponse()
+	bool (*sendResponse)(FreemodbusTcpInstance& instance, const uint8_t* frame, uint16_t length);
+
+	/// drops request which is currently handled - called by vMBTCPPortDisable()
+	void (*disable)(FreemodbusTcpInstance& instance);
+
+	/// closes the instance - called by vMBTCPPortClose() after vMBTCPPortDisable()
+	void (*close)(FreemodbusTcpInstance& instance);
+};
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Handles complete request frame - admits it, then answers it from the hot range cache, forwards it to the
+ * gateway, executes it with the table of function handlers or passes it to FreeMODBUS.
+ *
+ * \param [in] instance is a reference to FreemodbusTcpInstance which received the request
+ *
+ * \return true if the request was passed to FreeMODBUS, false if it was handled, deferred, answered or dropped
+ */
+
+bool freemodbusTcpHandleRequest(FreemodbusTcpInstance& instance);
+
+/**
+ * \param [in] instance is a reference to FreemodbusTcpInstance
+ *
+ * \return true if request of \a instance is deferred by limiter of rate of requests, false otherwise
+ */
+
+inline bool freemodbusTcpIsDeferred(const FreemodbusTcpInstance& instance)
+{
+	return instance.tcpExtensions != nullptr &&
+			instance.tcpExtensions->admissionTime != distortos::TickClock::time_point{};
+}
+
+/**
+ * \brief Sets address and port of master of FreemodbusTcpInstance from the address of its socket.
+ *
+ * Only IPv4 addresses are stored - IPv4 master of dual-stack socket has its IPv4-mapped IPv6 address converted to
+ * IPv4, address of any other IPv6 master is stored as 0 (unspecified), only its port is stored.
+ *
+ * Does nothing if the instance has no Modbus TCP extensions - the address is used only by limiter of rate of requests.
+ *
+ * \param [in] instance is a reference to FreemodbusTcpInstance which master address will be set
+ * \param [in] masterAddress is a reference to address of master returned by lwip_accept() or lwip_recvfrom()
+ */
+
+void freemodbusTcpSetMasterAddress(FreemodbusTcpInstance& instance, const sockaddr_storage& masterAddress);
+
+/**
+ * \brief Waits until deferred request may be handled.
+ *
+ * Nothing is received while the request is deferred, so the sockets are not waited for - further requests wait in
+ * them. The batch of responses is sent if its deadline passes during the wait.
+ *
+ * \param [in] instance is a reference to FreemodbusTcpInstance with deferred request
+ * \param [in] deadline is the deadline of waiting
+ *
+ * \return true if deferred request may be handled now, false if \a deadline was reached first
+ */
+
+bool freemodbusTcpWaitForAdmission(FreemodbusTcpInstance& instance, distortos::TickClock::time_point deadline);
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_FREEMODBUSTCPHOOKS_HPP_
@@ -1,8 +1,8 @@
 /**
  * \file
- * \brief freemodbusTcpPoll() declaration
+ * \brief freemodbusTcpFlush() and freemodbusTcpPoll() declarations
  *
- * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2019-2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -18,20 +18,35 @@
 
 #include "distortos/TickClock.hpp"
 
-struct FreemodbusInstance;
+struct FreemodbusTcpInstance;
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
+/**
+ * \brief Sends response which waits in frame buffer of instance which sends responses without blocking.
+ *
+ * Bytes are sent only if client socket can take them without blocking, the rest is sent by next call. Frame buffer is
+ * returned to the pool when the whole response is sent. Client socket is closed if sending fails.
+ *
+ * \param [in] instance is a reference to instance of FreeMODBUS
+ *
+ * \return true if no bytes of response wait to be sent, false otherwise
+ */
+
+bool freemodbusTcpFlush(FreemodbusTcpInstance& instance);
+
 /**
  * \brief Polls TCP connections
  *
+ * Nothing is received while response of instance which sends responses without blocking waits in frame buffer.
+ *
  * \param [in] instance is a reference to instance of FreeMODBUS
  * \param [in] deadline is the deadline of polling operation
  */
 
-void freemodbusTcpPoll(FreemodbusInstance& instance, distortos::TickClock::time_point deadline);
+void freemodbusTcpPoll(FreemodbusTcpInstance& instance, distortos::TickClock::time_point deadline);
 
 #endif	// MB_TCP_ENABLED == 1
 
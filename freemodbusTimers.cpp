@@ -12,7 +12,7 @@
 
 #include "freemodbusTimersPoll.hpp"
 
-#include "FreemodbusInstance.hpp"
+#include "FreemodbusSerialInstance.hpp"
 
 #include "mbport.h"
 
@@ -24,7 +24,7 @@
 | global functions
 +---------------------------------------------------------------------------------------------------------------------*/
 
-distortos::TickClock::time_point freemodbusTimersPoll(FreemodbusInstance& instance)
+distortos::TickClock::time_point freemodbusTimersPoll(FreemodbusSerialInstance& instance)
 {
 	if (instance.timerDeadline != decltype(instance.timerDeadline)::max() &&
 			distortos::TickClock::now() >= instance.timerDeadline)
@@ -44,7 +44,7 @@ extern "C" void vMBPortTimersDelay(xMBInstance*, const uint16_t timeoutMs)
 extern "C" void vMBPortTimersDisable(xMBInstance* const instance)
 {
 	assert(instance != nullptr);
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
+	auto& freemodbusInstance = *reinterpret_cast<FreemodbusSerialInstance*>(instance);
 
 	freemodbusInstance.timerDeadline = decltype(freemodbusInstance.timerDeadline)::max();
 }
@@ -52,7 +52,7 @@ extern "C" void vMBPortTimersDisable(xMBInstance* const instance)
 extern "C" void vMBPortTimersEnable(xMBInstance* const instance)
 {
 	assert(instance != nullptr);
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
+	auto& freemodbusInstance = *reinterpret_cast<FreemodbusSerialInstance*>(instance);
 
 	freemodbusInstance.timerDeadline = distortos::TickClock::now() + freemodbusInstance.timerDuration;
 }
@@ -66,7 +66,7 @@ extern "C" bool xMBPortTimersInit(xMBInstance* const instance, const uint16_t ti
 {
 	assert(instance != nullptr);
 	assert(timeout50us != 0);
-	auto& freemodbusInstance = *reinterpret_cast<FreemodbusInstance*>(instance);
+	auto& freemodbusInstance = *reinterpret_cast<FreemodbusSerialInstance*>(instance);
 
 	const auto duration = std::chrono::microseconds{timeout50us * 50};
 	freemodbusInstance.timerDuration = std::chrono::duration_cast<decltype(freemodbusInstance.timerDuration)>(duration);
@@ -15,7 +15,7 @@
 
 #include "distortos/TickClock.hpp"
 
-struct FreemodbusInstance;
+struct FreemodbusSerialInstance;
 
 /*---------------------------------------------------------------------------------------------------------------------+
 | global functions
@@ -29,6 +29,6 @@ struct FreemodbusInstance;
  * \return next deadline of timer, distortos::TickClock::time_point::max() if timer is not enabled
  */
 
-distortos::TickClock::time_point freemodbusTimersPoll(FreemodbusInstance& instance);
+distortos::TickClock::time_point freemodbusTimersPoll(FreemodbusSerialInstance& instance);
 
 #endif	// FREEMODBUS_INTEGRATION_FREEMODBUSTIMERSPOLL_HPP_
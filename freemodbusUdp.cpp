@@ -0,0 +1,310 @@
+/**
+ * \file
+ * \brief Definitions of Modbus UDP port for FreeMODBUS
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "FreemodbusUdpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "freemodbusCapture.hpp"
+#include "freemodbusFrameBuffer.hpp"
+#include "freemodbusMbap.hpp"
+#include "freemodbusTcpHooks.hpp"
+
+#include "distortos/ThisThread.hpp"
+
+#include "estd/ScopeGuard.hpp"
+
+#include <cassert>
+#include <cstring>
+
+namespace
+{
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| local functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Converts reference to FreemodbusTcpInstance to reference to FreemodbusUdpInstance.
+ *
+ * \param [in] instance is a reference to FreemodbusTcpInstance, which must be FreemodbusUdpInstance
+ *
+ * \return reference to \a instance as FreemodbusUdpInstance
+ */
+
+FreemodbusUdpInstance& getUdpInstance(FreemodbusTcpInstance& instance)
+{
+	return static_cast<FreemodbusUdpInstance&>(instance);
+}
+
+/**
+ * \brief Opens socket for Modbus UDP.
+ *
+ * \param [in] freemodbusInstance is a reference to FreemodbusUdpInstance for which the socket will be opened
+ * \param [in] port is a port for Modbus UDP to open
+ *
+ * \return true if socket was opened, false otherwise
+ */
+
+bool openUdpSocket(FreemodbusUdpInstance& freemodbusInstance, const uint16_t port)
+{
+	assert(freemodbusInstance.clientSocket == -1);
+
+	const auto& localAddress = freemodbusInstance.localAddress;
+
+#if LWIP_IPV6 != 1
+
+	if (localAddress.family != ListenSocket::Family::ipv4)
+		return false;
+
+	const auto domain = AF_INET;
+
+#else	// LWIP_IPV6 == 1
+
+	const auto domain = localAddress.family == ListenSocket::Family::ipv4 ? AF_INET : AF_INET6;
+
+#endif	// LWIP_IPV6 == 1
+
+	const auto udpSocket = lwip_socket(domain, SOCK_DGRAM, IPPROTO_UDP);
+	if (udpSocket == -1)
+		return false;
+
+	auto closeScopeGuard = estd::makeScopeGuard(
+			[udpSocket]()
+			{
+				lwip_close(udpSocket);
+			});
+
+#if LWIP_IPV6 == 1
+
+	if (domain == AF_INET6)
+	{
+		// dual-stack socket receives also datagrams of IPv4 masters
+		const int optionValue = localAddress.family == ListenSocket::Family::ipv6;
+		if (lwip_setsockopt(udpSocket, IPPROTO_IPV6, IPV6_V6ONLY, &optionValue, sizeof(optionValue)) == -1)
+			return false;
+
+		sockaddr_in6 serverAddress {};
+		serverAddress.sin6_family = AF_INET6;
+		memcpy(&serverAddress.sin6_addr, localAddress.bytes.begin(), sizeof(serverAddress.sin6_addr));
+		serverAddress.sin6_port = htons(port);
+		if (lwip_bind(udpSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) == -1)
+			return false;
+	}
+	else
+
+#endif	// LWIP_IPV6 == 1
+
+	{
+		sockaddr_in serverAddress {};
+		serverAddress.sin_family = AF_INET;
+		memcpy(&serverAddress.sin_addr, localAddress.bytes.begin(), sizeof(serverAddress.sin_addr));
+		serverAddress.sin_port = htons(port);
+		if (lwip_bind(udpSocket, reinterpret_cast<sockaddr*>(&serverAddress), sizeof(serverAddress)) == -1)
+			return false;
+	}
+
+	closeScopeGuard.release();
+	freemodbusInstance.clientSocket = udpSocket;
+	return true;
+}
+
+/**
+ * \brief Closes socket for Modbus UDP.
+ *
+ * \param [in] instance is a reference to FreemodbusUdpInstance which socket will be closed
+ */
+
+void closeUdp(FreemodbusTcpInstance& instance)
+{
+	if (instance.clientSocket != -1)
+		lwip_close(instance.clientSocket);
+	instance.clientSocket = -1;
+}
+
+/**
+ * \brief Drops request of Modbus UDP which is currently handled.
+ *
+ * Socket for Modbus UDP stays open until the instance is closed.
+ *
+ * \param [in] instance is a reference to FreemodbusUdpInstance which request will be dropped
+ */
+
+void disableUdp(FreemodbusTcpInstance& instance)
+{
+	instance.bytesInBuffer = {};
+	if (instance.tcpExtensions != nullptr)
+		instance.tcpExtensions->admissionTime = {};
+	releaseFrameBuffer(instance);
+}
+
+/**
+ * \brief Opens socket for Modbus UDP.
+ *
+ * \param [in] instance is a reference to FreemodbusUdpInstance for which the socket will be opened
+ * \param [in] port is a port for Modbus UDP to open
+ *
+ * \return true if socket was opened, false otherwise
+ */
+
+bool initUdp(FreemodbusTcpInstance& instance, const uint16_t port)
+{
+	return openUdpSocket(getUdpInstance(instance), port);
+}
+
+/**
+ * \brief Polls Modbus UDP socket.
+ *
+ * \param [in] instance is a reference to FreemodbusUdpInstance which will be polled
+ * \param [in] deadline is the deadline of polling operation
+ */
+
+void pollUdp(FreemodbusTcpInstance& instance, const distortos::TickClock::time_point deadline)
+{
+	auto& udpInstance = getUdpInstance(instance);
+
+	distortos::TickClock::duration left;
+	while ((left = deadline - distortos::TickClock::now()) >= distortos::TickClock::duration{})
+	{
+		if (udpInstance.clientSocket == -1)
+		{
+			distortos::ThisThread::sleepUntil(deadline);
+			return;
+		}
+
+		if (freemodbusTcpIsDeferred(udpInstance) == true)
+		{
+			if (freemodbusTcpWaitForAdmission(udpInstance, deadline) == false)
+				return;
+
+			if (freemodbusTcpHandleRequest(udpInstance) == true)
+				return;
+
+			releaseFrameBuffer(udpInstance);
+			continue;
+		}
+
+		{
+			fd_set fdSet;
+			FD_ZERO(&fdSet);
+			FD_SET(udpInstance.clientSocket, &fdSet);
+
+			const auto leftSeconds = std::chrono::duration_cast<std::chrono::seconds>(left);
+			const auto leftMicroseconds = std::chrono::duration_cast<std::chrono::microseconds>(left - leftSeconds);
+			timeval timeout {};
+			timeout.tv_sec = leftSeconds.count();
+			timeout.tv_usec = leftMicroseconds.count();
+			const auto ret = lwip_select(udpInstance.clientSocket + 1, &fdSet, nullptr, nullptr, &timeout);
+			if (ret <= 0)
+				return;
+		}
+
+		// if the pool is empty, datagrams wait in the socket
+		if (acquireFrameBuffer(udpInstance) == false)
+		{
+			distortos::ThisThread::sleepUntil(std::min(deadline, distortos::TickClock::now() + frameBufferRetryPeriod));
+			continue;
+		}
+
+		socklen_t masterAddressLength = sizeof(udpInstance.masterSocketAddress);
+		const auto ret = lwip_recvfrom(udpInstance.clientSocket, udpInstance.frameBuffer, udpInstance.frameBufferSize,
+				MSG_DONTWAIT, reinterpret_cast<sockaddr*>(&udpInstance.masterSocketAddress), &masterAddressLength);
+
+		// datagram must contain exactly one complete frame, truncated or malformed datagrams are silently dropped
+		const size_t size = ret > 0 ? ret : 0;
+		if (size < FreemodbusTcpInstance::mbapHeaderSize || size == udpInstance.frameBufferSize ||
+				getMbapFrameSize(udpInstance.frameBuffer, size) != size)
+		{
+			releaseFrameBuffer(udpInstance);
+			continue;
+		}
+
+		freemodbusTcpSetMasterAddress(udpInstance, udpInstance.masterSocketAddress);
+		udpInstance.bytesInBuffer = size;
+		freemodbusCapture(udpInstance, CaptureRing::Direction::received, CaptureRing::Protocol::udp,
+				udpInstance.frameBuffer, udpInstance.bytesInBuffer);
+		if (freemodbusTcpHandleRequest(udpInstance) == true)
+			return;
+
+		// deferred request keeps the frame buffer
+		if (freemodbusTcpIsDeferred(udpInstance) == false)
+			releaseFrameBuffer(udpInstance);
+	}
+}
+
+/**
+ * \brief Applies pending change of port of FreemodbusUdpInstance.
+ *
+ * New socket is opened before the previous one is closed, so the previous port is kept if new socket cannot be opened.
+ * No request is in progress here, so the response will not be sent from the new socket.
+ *
+ * \param [in] instance is a reference to FreemodbusUdpInstance which port will be changed
+ * \param [in] port is the new port of Modbus UDP
+ */
+
+void reconfigureUdpPort(FreemodbusTcpInstance& instance, const uint16_t port)
+{
+	const auto previousSocket = instance.clientSocket;
+	instance.clientSocket = -1;
+	if (openUdpSocket(getUdpInstance(instance), port) == false)
+	{
+		instance.clientSocket = previousSocket;
+		return;
+	}
+
+	if (previousSocket != -1)
+		lwip_close(previousSocket);
+}
+
+/**
+ * \brief Sends Modbus UDP response to master which sent the request.
+ *
+ * \param [in] instance is a reference to FreemodbusUdpInstance which received the request
+ * \param [in] frame is a pointer to response frame
+ * \param [in] length is the length of \a frame, bytes
+ *
+ * \return true if response was sent, false otherwise
+ */
+
+bool sendUdpResponse(FreemodbusTcpInstance& instance, const uint8_t* const frame, const uint16_t length)
+{
+	auto& udpInstance = getUdpInstance(instance);
+	freemodbusCapture(udpInstance, CaptureRing::Direction::sent, CaptureRing::Protocol::udp, frame, length);
+
+	const auto& masterAddress = udpInstance.masterSocketAddress;
+	const socklen_t masterAddressLength =
+#if LWIP_IPV6 == 1
+			masterAddress.ss_family == AF_INET6 ? sizeof(sockaddr_in6) :
+#endif	// LWIP_IPV6 == 1
+			sizeof(sockaddr_in);
+	const auto ret = lwip_sendto(udpInstance.clientSocket, frame, length, {},
+			reinterpret_cast<const sockaddr*>(&masterAddress), masterAddressLength);
+	releaseFrameBuffer(udpInstance);
+	return ret == length;
+}
+
+}	// namespace
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| FreemodbusUdpInstance's private static objects
++---------------------------------------------------------------------------------------------------------------------*/
+
+const FreemodbusTcpHooks FreemodbusUdpInstance::udpHooks
+{
+		initUdp,
+		reconfigureUdpPort,
+		pollUdp,
+		sendUdpResponse,
+		disableUdp,
+		closeUdp,
+};
+
+#endif	// MB_TCP_ENABLED == 1
@@ -0,0 +1,114 @@
+/**
+ * \file
+ * \brief CaptureReplay class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_CAPTUREREPLAY_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_CAPTUREREPLAY_HPP_
+
+#include "CaptureRing.hpp"
+
+/**
+ * CaptureReplay reads records from pcap file exported by CaptureRing and paces them with their original timing.
+ *
+ * Captured traffic may be used as workload - for example received requests are sent to a server by a Modbus TCP
+ * client, at original speed or accelerated.
+ *
+ * \code
+ * CaptureReplay replay {pcap, pcapSize, 10};
+ * CaptureRing::Record record;
+ * while (replay.next(record) == 0)
+ *     if (record.direction == CaptureRing::Direction::received)
+ *     {
+ *         replay.waitFor(record);
+ *         send(record.data, record.capturedSize);
+ *     }
+ * \endcode
+ */
+
+class CaptureReplay
+{
+public:
+
+	/**
+	 * \brief CaptureReplay's constructor
+	 *
+	 * \param [in] pcap is a pointer to contents of pcap file exported by CaptureRing
+	 * \param [in] size is the size of \a pcap, bytes
+	 * \param [in] speedup is the factor by which intervals between records are shortened, 1 - original timing, 0 - no
+	 * waiting at all
+	 */
+
+	constexpr CaptureReplay(const uint8_t* const pcap, const size_t size, const uint32_t speedup) :
+			start_{},
+			firstTimestamp_{},
+			pcap_{pcap},
+			position_{},
+			size_{size},
+			speedup_{speedup},
+			started_{}
+	{
+
+	}
+
+	/**
+	 * \brief Reads next record.
+	 *
+	 * \param [out] record is a reference to buffer for read record
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a pcap is not a valid file exported by CaptureRing;
+	 * - ENOENT - no more records;
+	 */
+
+	int next(CaptureRing::Record& record);
+
+	/**
+	 * \brief Rewinds to the first record.
+	 */
+
+	void rewind()
+	{
+		position_ = {};
+		started_ = {};
+	}
+
+	/**
+	 * \brief Waits until the time of record, relative to the first waited record and scaled by speedup.
+	 *
+	 * \param [in] record is a reference to record returned by next()
+	 */
+
+	void waitFor(const CaptureRing::Record& record);
+
+private:
+
+	/// time point at which first record was waited for
+	distortos::TickClock::time_point start_;
+
+	/// timestamp of first record which was waited for, microseconds
+	uint64_t firstTimestamp_;
+
+	/// pointer to contents of pcap file
+	const uint8_t* pcap_;
+
+	/// position of next record in pcap_
+	size_t position_;
+
+	/// size of pcap_, bytes
+	size_t size_;
+
+	/// factor by which intervals between records are shortened, 0 - no waiting at all
+	uint32_t speedup_;
+
+	/// true if first record was already waited for, false otherwise
+	bool started_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_CAPTUREREPLAY_HPP_
@@ -0,0 +1,260 @@
+/**
+ * \file
+ * \brief CaptureRing class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_CAPTURERING_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_CAPTURERING_HPP_
+
+#include "distortos/TickClock.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+#include <atomic>
+
+/**
+ * CaptureRing is a flight recorder of frames received and sent by instances of FreeMODBUS.
+ *
+ * Instances with attached ring (FreemodbusExtensions::captureRing) copy each complete Modbus TCP, Modbus UDP and Modbus
+ * RTU frame into the ring, together with its timestamp. Writers never wait - the ring is lock-free, any number of
+ * instances may write to it concurrently and the oldest records are overwritten when the ring is full. Frames longer
+ * than snapLength are truncated.
+ *
+ * Contents of the ring are exported in pcap format, with link type of Wireshark "exported PDU", so Modbus TCP, Modbus
+ * UDP and Modbus RTU frames are dissected by Wireshark from a single file. Channel of the instance is encoded in the
+ * port of the client, so frames of each instance form a separate conversation. Captures can be fed back with
+ * CaptureReplay.
+ */
+
+class CaptureRing
+{
+public:
+
+	/// max number of bytes of frame stored in record
+	constexpr static size_t snapLength {260};
+
+	/// size of header of pcap file, bytes
+	constexpr static size_t pcapHeaderSize {24};
+
+	/// max size of header of pcap record, bytes
+	constexpr static size_t pcapRecordHeaderSize {16 + 12 + 3 * 8 + 4};
+
+	/// link type of pcap file - LINKTYPE_WIRESHARK_UPPER_PDU
+	constexpr static uint32_t pcapLinkType {252};
+
+	/// port of server in exported records
+	constexpr static uint16_t serverPort {502};
+
+	/// base of port of client in exported records, channel is added to this value
+	constexpr static uint16_t clientPortBase {49152};
+
+	/// Direction contains directions of frames
+	enum class Direction : uint8_t
+	{
+		/// frame received by the instance
+		received,
+		/// frame sent by the instance
+		sent,
+	};
+
+	/// Protocol contains protocols of frames
+	enum class Protocol : uint8_t
+	{
+		/// Modbus TCP
+		tcp,
+		/// Modbus UDP
+		udp,
+		/// Modbus RTU
+		rtu,
+	};
+
+	/// Record is a single captured frame
+	struct Record
+	{
+		/// timestamp of the frame, microseconds since the start of TickClock
+		uint64_t timestamp;
+
+		/// original size of the frame, bytes
+		uint16_t size;
+
+		/// number of bytes of the frame stored in data
+		uint16_t capturedSize;
+
+		/// channel of the instance which captured the frame
+		uint8_t channel;
+
+		/// direction of the frame
+		Direction direction;
+
+		/// protocol of the frame
+		Protocol protocol;
+
+		/// captured bytes of the frame
+		uint8_t data[snapLength];
+	};
+
+	/// Slot is a single element of the ring
+	struct Slot
+	{
+		/// sequence of the slot, odd while the record is written, 2 * (ticket + 1) when record with ticket is complete
+		std::atomic<uint32_t> sequence;
+
+		/// record stored in the slot
+		Record record;
+	};
+
+	/// type alias for range of slots
+	using SlotsRange = estd::ContiguousRange<Slot>;
+
+	/**
+	 * \brief CaptureRing's constructor
+	 *
+	 * \param [in] slotsRange is a range of slots, should have more elements than the number of concurrent writers
+	 */
+
+	constexpr explicit CaptureRing(const SlotsRange slotsRange) :
+			slotsRange_{slotsRange},
+			writeTicket_{}
+	{
+
+	}
+
+	/**
+	 * \brief Exports records from the ring in pcap format.
+	 *
+	 * \tparam Writer is the type of \a writer, should be callable as int(const void* buffer, size_t size)
+	 *
+	 * \param [in] writer is a functor which writes exported data, returns 0 on success, error code otherwise
+	 * \param [in,out] ticket is a reference to ticket of first exported record, ticket after last exported record is
+	 * written here, allows exporting in multiple steps
+	 * \param [in] fileHeader selects whether header of pcap file is written before records
+	 * \param [in] epochSeconds is the number of seconds added to all timestamps, allows converting them to real time,
+	 * default - 0
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by \a writer;
+	 */
+
+	template<typename Writer>
+	int exportPcap(Writer writer, uint32_t& ticket, const bool fileHeader, const uint32_t epochSeconds = {}) const
+	{
+		if (fileHeader == true)
+		{
+			uint8_t header[pcapHeaderSize];
+			serializePcapHeader(header);
+			const auto ret = writer(header, sizeof(header));
+			if (ret != 0)
+				return ret;
+		}
+
+		Record record;
+		while (read(ticket, record) == true)
+		{
+			uint8_t recordHeader[pcapRecordHeaderSize];
+			const auto recordHeaderSize = serializePcapRecordHeader(record, epochSeconds, recordHeader);
+			auto ret = writer(recordHeader, recordHeaderSize);
+			if (ret == 0)
+				ret = writer(record.data, record.capturedSize);
+			if (ret != 0)
+				return ret;
+		}
+
+		return 0;
+	}
+
+	/**
+	 * \return ticket of the oldest record which is still stored in the ring
+	 */
+
+	uint32_t getOldestTicket() const;
+
+	/**
+	 * \brief Parses header of pcap file.
+	 *
+	 * \param [in] buffer is a pointer to header of pcap file
+	 * \param [in] size is the number of bytes available in \a buffer
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a buffer does not contain header of pcap file exported by CaptureRing;
+	 */
+
+	static int parsePcapHeader(const uint8_t* buffer, size_t size);
+
+	/**
+	 * \brief Parses pcap record exported by CaptureRing.
+	 *
+	 * \param [in] buffer is a pointer to pcap record
+	 * \param [in] size is the number of bytes available in \a buffer
+	 * \param [out] record is a reference to buffer for parsed record
+	 * \param [out] recordSize is a reference to variable for size of complete pcap record, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a buffer does not contain complete pcap record exported by CaptureRing or its original size is
+	 * inconsistent with its tags;
+	 */
+
+	static int parsePcapRecord(const uint8_t* buffer, size_t size, Record& record, size_t& recordSize);
+
+	/**
+	 * \brief Stores frame in the ring.
+	 *
+	 * \param [in] channel is the channel of the instance which captured the frame
+	 * \param [in] direction is the direction of the frame
+	 * \param [in] protocol is the protocol of the frame
+	 * \param [in] frame is a pointer to the frame
+	 * \param [in] size is the size of \a frame, bytes
+	 */
+
+	void push(uint8_t channel, Direction direction, Protocol protocol, const uint8_t* frame, size_t size);
+
+	/**
+	 * \brief Reads record from the ring.
+	 *
+	 * Records which were overwritten are skipped.
+	 *
+	 * \param [in,out] ticket is a reference to ticket of record which will be read, ticket of next record is written
+	 * here
+	 * \param [out] record is a reference to buffer for read record
+	 *
+	 * \return true if the record was read, false if no complete record is available
+	 */
+
+	bool read(uint32_t& ticket, Record& record) const;
+
+	/**
+	 * \brief Serializes header of pcap file.
+	 *
+	 * \param [out] buffer is a reference to buffer for header of pcap file
+	 */
+
+	static void serializePcapHeader(uint8_t (&buffer)[pcapHeaderSize]);
+
+	/**
+	 * \brief Serializes header of pcap record, including tags of exported PDU.
+	 *
+	 * \param [in] record is a reference to record for which the header will be serialized
+	 * \param [in] epochSeconds is the number of seconds added to timestamp
+	 * \param [out] buffer is a reference to buffer for header of pcap record
+	 *
+	 * \return size of serialized header, bytes
+	 */
+
+	static size_t serializePcapRecordHeader(const Record& record, uint32_t epochSeconds,
+			uint8_t (&buffer)[pcapRecordHeaderSize]);
+
+private:
+
+	/// range of slots
+	SlotsRange slotsRange_;
+
+	/// ticket of next written record
+	std::atomic<uint32_t> writeTicket_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_CAPTURERING_HPP_
@@ -0,0 +1,105 @@
+/**
+ * \file
+ * \brief FileRecordBackend class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FILERECORDBACKEND_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FILERECORDBACKEND_HPP_
+
+#include <utility>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * FileRecordBackend is an interface of source and sink of data transferred with Modbus File Record functions by
+ * FileRecordServer.
+ *
+ * Data is read directly into the response frame and written directly from the request frame, so the backend is the
+ * only place where it is copied. Files are addressed with byte offsets - record number multiplied by 2. Blobs larger
+ * than one file (10000 records) are usually split into consecutive file numbers.
+ *
+ * Functions may be called concurrently by instances polled by different threads.
+ */
+
+class FileRecordBackend
+{
+public:
+
+	/**
+	 * \brief FileRecordBackend's destructor
+	 */
+
+	virtual ~FileRecordBackend() = default;
+
+	/**
+	 * \brief Gets size of the file.
+	 *
+	 * Used to check ranges of all sub-requests of Write File Record request before anything is written.
+	 *
+	 * \param [in] file is the file number, [1; 65535]
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and size of the file, bytes; error codes:
+	 * - ENOENT - file does not exist;
+	 * - other error codes are answered with Server Device Failure exception;
+	 */
+
+	virtual std::pair<int, uint32_t> getSize(uint16_t file) = 0;
+
+	/**
+	 * \brief Hints that given range of the file will probably be read next.
+	 *
+	 * Called after each Read File Record request, before its response is sent, with the range which directly follows
+	 * the last one which was read - the backend may start loading next chunk of its source while the response is being
+	 * sent. Default implementation does nothing.
+	 *
+	 * \param [in] file is the file number, [1; 65535]
+	 * \param [in] offset is the offset in the file, bytes
+	 * \param [in] size is the size of range, bytes
+	 */
+
+	virtual void prefetch(uint16_t, uint32_t, size_t)
+	{
+
+	}
+
+	/**
+	 * \brief Reads data of records.
+	 *
+	 * \param [in] file is the file number, [1; 65535]
+	 * \param [in] offset is the offset in the file, bytes
+	 * \param [out] buffer is a pointer to buffer in the response frame for read data
+	 * \param [in] size is the number of bytes which will be read, even
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - range exceeds size of the file;
+	 * - ENOENT - file does not exist;
+	 * - other error codes are answered with Server Device Failure exception;
+	 */
+
+	virtual int read(uint16_t file, uint32_t offset, uint8_t* buffer, size_t size) = 0;
+
+	/**
+	 * \brief Writes data of records.
+	 *
+	 * \param [in] file is the file number, [1; 65535]
+	 * \param [in] offset is the offset in the file, bytes
+	 * \param [in] data is a pointer to data in the request frame
+	 * \param [in] size is the number of bytes which will be written, even
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - range exceeds size of the file;
+	 * - ENOENT - file does not exist;
+	 * - other error codes are answered with Server Device Failure exception;
+	 */
+
+	virtual int write(uint16_t file, uint32_t offset, const uint8_t* data, size_t size) = 0;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FILERECORDBACKEND_HPP_
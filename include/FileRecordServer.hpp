@@ -0,0 +1,137 @@
+/**
+ * \file
+ * \brief FileRecordServer class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FILERECORDSERVER_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FILERECORDSERVER_HPP_
+
+#include "mbinstance.h"
+#include "mbproto.h"
+
+#include <cstddef>
+
+class FileRecordBackend;
+
+/**
+ * FileRecordServer handles Modbus Read File Record (20) and Write File Record (21) requests with FileRecordBackend.
+ *
+ * One request transfers up to 248 bytes in one or more sub-requests, so bulk data (logs, recipes, firmware chunks)
+ * moves with far fewer transactions than with register reads. Data goes directly between the frame and the backend,
+ * and after each read the backend gets a hint to prefetch the range which follows, while the response is being sent.
+ *
+ * All sub-requests of write request are validated before anything is written - also against sizes of files reported by
+ * the backend - so a malformed write request does not modify anything. Only a failure of the backend itself (error
+ * other than EINVAL or ENOENT) during write of one sub-request leaves the preceding sub-requests of the request
+ * written.
+ *
+ * Handlers are bound to a server with static storage duration:
+ *
+ * \code
+ * FileRecordServer fileRecordServer {backend};
+ * constexpr auto functionHandlerTable = makeFunctionHandlerTable<
+ *         FunctionHandlerEntry<FileRecordServer::readFunctionCode, readFileRecordHandler<fileRecordServer>>,
+ *         FunctionHandlerEntry<FileRecordServer::writeFunctionCode, writeFileRecordHandler<fileRecordServer>>>();
+ * \endcode
+ *
+ * The same handlers may be registered in FreeMODBUS with eMBRegisterCB().
+ */
+
+class FileRecordServer
+{
+public:
+
+	/// function code of Read File Record
+	constexpr static uint8_t readFunctionCode {20};
+
+	/// function code of Write File Record
+	constexpr static uint8_t writeFunctionCode {21};
+
+	/// number of records in one file
+	constexpr static uint16_t recordsPerFile {10000};
+
+	/// max size of request and response PDU, bytes
+	constexpr static size_t maxPduSize {253};
+
+	/**
+	 * \brief FileRecordServer's constructor
+	 *
+	 * \param [in] backendd is a reference to backend with data of files
+	 */
+
+	constexpr explicit FileRecordServer(FileRecordBackend& backendd) :
+			backend_{backendd}
+	{
+
+	}
+
+	/**
+	 * \brief Handles Read File Record request.
+	 *
+	 * \param [in,out] pdu is a pointer to buffer with request PDU, response PDU is written here, at least maxPduSize
+	 * bytes
+	 * \param [in,out] pduSize is a pointer to size of request PDU, size of response PDU is written here
+	 *
+	 * \return MB_EX_NONE on success, exception code which will be sent in response otherwise
+	 */
+
+	eMBException readFileRecord(uint8_t* pdu, uint16_t* pduSize) const;
+
+	/**
+	 * \brief Handles Write File Record request.
+	 *
+	 * \param [in,out] pdu is a pointer to buffer with request PDU, response PDU (echo of request) is left here
+	 * \param [in,out] pduSize is a pointer to size of request PDU, size of response PDU is written here
+	 *
+	 * \return MB_EX_NONE on success, exception code which will be sent in response otherwise
+	 */
+
+	eMBException writeFileRecord(uint8_t* pdu, uint16_t* pduSize) const;
+
+private:
+
+	/// reference to backend with data of files
+	FileRecordBackend& backend_;
+};
+
+/**
+ * \brief Function handler of Read File Record bound to FileRecordServer.
+ *
+ * \tparam Server is a reference to FileRecordServer which handles the requests
+ *
+ * \param [in,out] pdu is a pointer to buffer with request PDU, response PDU is written here
+ * \param [in,out] pduSize is a pointer to size of request PDU, size of response PDU is written here
+ *
+ * \return MB_EX_NONE on success, exception code which will be sent in response otherwise
+ */
+
+template<FileRecordServer& Server>
+eMBException readFileRecordHandler(xMBInstance*, uint8_t* const pdu, uint16_t* const pduSize)
+{
+	return Server.readFileRecord(pdu, pduSize);
+}
+
+/**
+ * \brief Function handler of Write File Record bound to FileRecordServer.
+ *
+ * \tparam Server is a reference to FileRecordServer which handles the requests
+ *
+ * \param [in,out] pdu is a pointer to buffer with request PDU, response PDU is written here
+ * \param [in,out] pduSize is a pointer to size of request PDU, size of response PDU is written here
+ *
+ * \return MB_EX_NONE on success, exception code which will be sent in response otherwise
+ */
+
+template<FileRecordServer& Server>
+eMBException writeFileRecordHandler(xMBInstance*, uint8_t* const pdu, uint16_t* const pduSize)
+{
+	return Server.writeFileRecord(pdu, pduSize);
+}
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FILERECORDSERVER_HPP_
@@ -0,0 +1,194 @@
+/**
+ * \file
+ * \brief FrameBufferPool class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FRAMEBUFFERPOOL_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FRAMEBUFFERPOOL_HPP_
+
+#include <atomic>
+
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * FrameBufferPool is a lock-free pool of fixed-size frame buffers shared by instances of FreeMODBUS.
+ *
+ * Free buffers are kept on a stack with tagged head, so allocation and deallocation never block and may be done from
+ * any thread. Buffers which were never used are handed out from the end of storage, so the pool needs no run-time
+ * initialization.
+ */
+
+class FrameBufferPool
+{
+public:
+
+	/// max number of buffers in the pool
+	constexpr static size_t maxBlocksCount {UINT16_MAX};
+
+	/**
+	 * \brief FrameBufferPool's constructor
+	 *
+	 * \param [in] storage is a pointer to storage for buffers, its size must be \a blockSize * \a blocksCount
+	 * \param [in] links is a pointer to array of \a blocksCount links of free buffers
+	 * \param [in] blockSize is the size of single buffer, bytes
+	 * \param [in] blocksCount is the number of buffers, [0; maxBlocksCount)
+	 */
+
+	constexpr FrameBufferPool(uint8_t* const storage, std::atomic<uint16_t>* const links, const size_t blockSize,
+			const size_t blocksCount) :
+					storage_{storage},
+					links_{links},
+					blockSize_{blockSize},
+					allocationFailures_{},
+					head_{endIndex},
+					blocksCount_{static_cast<uint16_t>(blocksCount)},
+					nextUnusedBlock_{},
+					peakUsedBlocks_{},
+					usedBlocks_{}
+	{
+
+	}
+
+	/**
+	 * \brief Returns buffer to the pool.
+	 *
+	 * \param [in] buffer is a pointer to buffer previously returned by tryAllocate()
+	 */
+
+	void deallocate(uint8_t* buffer);
+
+	/**
+	 * \return number of failed allocations because the pool was empty
+	 */
+
+	size_t getAllocationFailures() const
+	{
+		return allocationFailures_.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * \return number of buffers in the pool
+	 */
+
+	size_t getBlocksCount() const
+	{
+		return blocksCount_;
+	}
+
+	/**
+	 * \return size of single buffer, bytes
+	 */
+
+	size_t getBlockSize() const
+	{
+		return blockSize_;
+	}
+
+	/**
+	 * \return max number of buffers which were allocated at the same time
+	 */
+
+	size_t getPeakUsedBlocks() const
+	{
+		return peakUsedBlocks_.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * \return number of currently allocated buffers
+	 */
+
+	size_t getUsedBlocks() const
+	{
+		return usedBlocks_.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Tries to allocate buffer from the pool.
+	 *
+	 * \return pointer to allocated buffer, nullptr if the pool is empty
+	 */
+
+	uint8_t* tryAllocate();
+
+private:
+
+	/// index which marks the end of stack of free buffers
+	constexpr static uint16_t endIndex {UINT16_MAX};
+
+	/**
+	 * \brief Updates occupancy counters after successful allocation.
+	 */
+
+	void updateCounters();
+
+	/// pointer to storage for buffers
+	uint8_t* storage_;
+
+	/// pointer to array with links of free buffers - each element is the index of next free buffer
+	std::atomic<uint16_t>* links_;
+
+	/// size of single buffer, bytes
+	size_t blockSize_;
+
+	/// number of failed allocations because the pool was empty
+	std::atomic<size_t> allocationFailures_;
+
+	/// head of stack of free buffers - index of first free buffer in low half-word, modification tag in high half-word
+	std::atomic<uint32_t> head_;
+
+	/// number of buffers
+	uint16_t blocksCount_;
+
+	/// index of first buffer which was never allocated
+	std::atomic<uint16_t> nextUnusedBlock_;
+
+	/// max number of buffers which were allocated at the same time
+	std::atomic<uint16_t> peakUsedBlocks_;
+
+	/// number of currently allocated buffers
+	std::atomic<uint16_t> usedBlocks_;
+};
+
+/**
+ * StaticFrameBufferPool is a variant of FrameBufferPool that has automatic storage for buffers.
+ *
+ * \tparam BlockSize is the size of single buffer, bytes
+ * \tparam BlocksCount is the number of buffers
+ */
+
+template<size_t BlockSize, size_t BlocksCount>
+class StaticFrameBufferPool : public FrameBufferPool
+{
+	static_assert(BlocksCount < FrameBufferPool::maxBlocksCount, "Too many buffers!");
+
+public:
+
+	/**
+	 * \brief StaticFrameBufferPool's constructor
+	 */
+
+	constexpr StaticFrameBufferPool() :
+			FrameBufferPool{storage_[0], links_, BlockSize, BlocksCount},
+			links_{},
+			storage_{}
+	{
+
+	}
+
+private:
+
+	/// storage for links of free buffers
+	std::atomic<uint16_t> links_[BlocksCount];
+
+	/// storage for buffers
+	uint8_t storage_[BlocksCount][BlockSize];
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FRAMEBUFFERPOOL_HPP_
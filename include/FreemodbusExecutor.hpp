@@ -0,0 +1,342 @@
+/**
+ * \file
+ * \brief FreemodbusExecutor class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSEXECUTOR_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSEXECUTOR_HPP_
+
+#if defined(__cpp_impl_coroutine)
+
+#include "mbconfig.h"
+
+#include "distortos/TickClock.hpp"
+
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+
+struct FreemodbusInstance;
+
+/**
+ * FreemodbusTask is a coroutine which is started immediately and destroys itself when it finishes.
+ *
+ * Frame of the coroutine is allocated with operator new.
+ */
+
+struct FreemodbusTask
+{
+	/// promise type of the coroutine
+	struct promise_type
+	{
+		/**
+		 * \return FreemodbusTask object returned to the caller of the coroutine
+		 */
+
+		FreemodbusTask get_return_object() const noexcept
+		{
+			return {};
+		}
+
+		/**
+		 * \return awaitable which does not suspend the coroutine before its body
+		 */
+
+		std::suspend_never initial_suspend() const noexcept
+		{
+			return {};
+		}
+
+		/**
+		 * \return awaitable which does not suspend the coroutine after its body, so its frame is destroyed
+		 */
+
+		std::suspend_never final_suspend() const noexcept
+		{
+			return {};
+		}
+
+		/**
+		 * \brief Handles the end of the coroutine.
+		 */
+
+		void return_void() const noexcept
+		{
+
+		}
+
+		/**
+		 * \brief Handles exception which escaped from the coroutine.
+		 */
+
+		[[noreturn]] void unhandled_exception() const noexcept
+		{
+			std::terminate();
+		}
+	};
+};
+
+/**
+ * FreemodbusExecutor runs coroutines which handle instances of FreeMODBUS in one thread.
+ *
+ * Coroutines wait with awaitables returned by frameReceived(), responseSent(), timerExpired() and - for Modbus TCP -
+ * writable(). Instances awaited with frameReceived() are switched to non-blocking mode, so all their I/O is done by the
+ * executor between resumptions. When no awaitable is ready, the executor waits on all awaited sockets, bounded by the
+ * earliest deadline - just like FreemodbusScheduler does.
+ *
+ * Instances handled by serve() also send responses without blocking - response is left in the frame buffer and the
+ * coroutine awaits responseSent(), so slow peer stalls only its own coroutine. Response which is sent with transport
+ * (e.g. MbedtlsTransport) or together with the batch of pipelined responses is still sent with blocking writes.
+ *
+ * Example:
+ *
+ *     FreemodbusTask serveTwoInstances(FreemodbusExecutor& executor)
+ *     {
+ *         executor.serve(rtuInstance);
+ *         executor.serve(tcpInstance);
+ *         while (1)
+ *         {
+ *             co_await executor.timerExpired(distortos::TickClock::now() + std::chrono::seconds{1});
+ *             publishStatistics();
+ *         }
+ *     }
+ */
+
+class FreemodbusExecutor
+{
+public:
+
+	/// Awaitable is an object which suspends the coroutine until its condition is satisfied
+	class Awaitable
+	{
+		friend class FreemodbusExecutor;
+
+	public:
+
+		/**
+		 * \return true if condition is already satisfied, false otherwise
+		 */
+
+		bool await_ready()
+		{
+			return isReady();
+		}
+
+		/**
+		 * \brief Adds suspended coroutine to the executor.
+		 *
+		 * \param [in] coroutine is the handle of suspended coroutine
+		 */
+
+		void await_suspend(std::coroutine_handle<> coroutine);
+
+		/**
+		 * \brief Does nothing, condition of awaitable has no result.
+		 */
+
+		void await_resume() const
+		{
+
+		}
+
+	private:
+
+		/// Type contains possible types of awaitables
+		enum class Type : uint8_t
+		{
+			/// frame received by instance of FreeMODBUS
+			frameReceived,
+			/// response of instance of FreeMODBUS sent
+			responseSent,
+			/// socket is writable
+			writable,
+			/// timer expired
+			timerExpired,
+		};
+
+		/**
+		 * \brief Awaitable's constructor
+		 *
+		 * \param [in] executor is a reference to executor which will resume the coroutine
+		 * \param [in] type is the type of awaitable
+		 * \param [in] deadline is the deadline of timer, used only for Type::timerExpired
+		 * \param [in] instance is a pointer to instance, used only for Type::frameReceived and Type::responseSent
+		 * \param [in] socket is the socket, used only for Type::writable
+		 */
+
+		constexpr Awaitable(FreemodbusExecutor& executor, const Type type,
+				const distortos::TickClock::time_point deadline, FreemodbusInstance* const instance, const int socket) :
+						deadline_{deadline},
+						coroutine_{},
+						executor_{executor},
+						instance_{instance},
+						next_{},
+						socket_{socket},
+						type_{type}
+		{
+
+		}
+
+		/**
+		 * \brief Checks whether condition of awaitable is satisfied.
+		 *
+		 * For Type::frameReceived all data which is already available for the instance is handled, for
+		 * Type::responseSent the part of response which can be sent without blocking is sent.
+		 *
+		 * \return true if condition is satisfied, false otherwise
+		 */
+
+		bool isReady();
+
+		/// deadline of timer
+		distortos::TickClock::time_point deadline_;
+
+		/// handle of suspended coroutine
+		std::coroutine_handle<> coroutine_;
+
+		/// reference to executor which will resume the coroutine
+		FreemodbusExecutor& executor_;
+
+		/// pointer to awaited instance of FreeMODBUS
+		FreemodbusInstance* instance_;
+
+		/// next awaitable in the list of executor, nullptr if this is the last one
+		Awaitable* next_;
+
+		/// awaited socket
+		int socket_;
+
+		/// type of awaitable
+		Type type_;
+	};
+
+	/**
+	 * \brief FreemodbusExecutor's constructor
+	 *
+	 * \param [in] serialPollPeriod is the max interval between polls of serial ports, should be shorter than the
+	 * duration of 3.5 characters at the highest baud rate in use
+	 */
+
+	constexpr explicit FreemodbusExecutor(const distortos::TickClock::duration serialPollPeriod) :
+			serialPollPeriod_{serialPollPeriod},
+			head_{}
+	{
+
+	}
+
+	/**
+	 * \brief Returns awaitable which is ready when the instance has a pending event - usually a received frame.
+	 *
+	 * \param [in] instance is a reference to instance of FreeMODBUS, it must be initialized and enabled with FreeMODBUS
+	 * API
+	 *
+	 * \return awaitable for received frame
+	 */
+
+	Awaitable frameReceived(FreemodbusInstance& instance)
+	{
+		return {*this, Awaitable::Type::frameReceived, {}, &instance, -1};
+	}
+
+	/**
+	 * \brief Runs one iteration of the executor.
+	 *
+	 * All coroutines whose awaitables are ready are resumed, then the executor waits for activity on awaited sockets,
+	 * earliest deadline, serial poll period or \a deadline, whichever comes first.
+	 *
+	 * \param [in] deadline is the deadline of waiting
+	 */
+
+	void poll(distortos::TickClock::time_point deadline);
+
+	/**
+	 * \brief Returns awaitable which is ready when the whole response of the instance is sent - copied to client socket
+	 * (Modbus TCP) or to write buffer of serial port (Modbus ASCII/RTU).
+	 *
+	 * \param [in] instance is a reference to instance of FreeMODBUS which sends responses without blocking
+	 *
+	 * \return awaitable for sent response
+	 */
+
+	Awaitable responseSent(FreemodbusInstance& instance)
+	{
+		return {*this, Awaitable::Type::responseSent, {}, &instance, -1};
+	}
+
+	/**
+	 * \brief Runs the executor forever.
+	 */
+
+	void run();
+
+	/**
+	 * \brief Starts coroutine which handles all requests received by the instance.
+	 *
+	 * The instance is switched to sending of responses without blocking.
+	 *
+	 * \param [in] instance is a reference to instance of FreeMODBUS, it must be initialized and enabled with FreeMODBUS
+	 * API
+	 *
+	 * \return FreemodbusTask of started coroutine
+	 */
+
+	FreemodbusTask serve(FreemodbusInstance& instance);
+
+	/**
+	 * \brief Returns awaitable which is ready when the deadline is reached.
+	 *
+	 * \param [in] deadline is the deadline of timer
+	 *
+	 * \return awaitable for timer
+	 */
+
+	Awaitable timerExpired(const distortos::TickClock::time_point deadline)
+	{
+		return {*this, Awaitable::Type::timerExpired, deadline, nullptr, -1};
+	}
+
+#if MB_TCP_ENABLED == 1
+
+	/**
+	 * \brief Returns awaitable which is ready when the socket can be written without blocking.
+	 *
+	 * Intended for sockets written by coroutines themselves - responses of instances are awaited with responseSent().
+	 *
+	 * \param [in] socket is the socket
+	 *
+	 * \return awaitable for writable socket
+	 */
+
+	Awaitable writable(const int socket)
+	{
+		return {*this, Awaitable::Type::writable, {}, nullptr, socket};
+	}
+
+#endif	// MB_TCP_ENABLED == 1
+
+private:
+
+	/**
+	 * \brief Waits for activity on any of awaited objects.
+	 *
+	 * \param [in] deadline is the deadline of waiting
+	 */
+
+	void wait(distortos::TickClock::time_point deadline) const;
+
+	/// max interval between polls of serial ports
+	distortos::TickClock::duration serialPollPeriod_;
+
+	/// first awaitable in the list of suspended coroutines, nullptr if list is empty
+	Awaitable* head_;
+};
+
+#endif	// defined(__cpp_impl_coroutine)
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSEXECUTOR_HPP_
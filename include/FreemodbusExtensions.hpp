@@ -0,0 +1,110 @@
+/**
+ * \file
+ * \brief FreemodbusExtensions struct header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSEXTENSIONS_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSEXTENSIONS_HPP_
+
+#include "distortos/devices/communication/UartParity.hpp"
+
+#include <atomic>
+
+class CaptureRing;
+class HotRangeCache;
+class WriteNotificationQueue;
+
+/**
+ * FreemodbusExtensions struct contains state of optional features of FreemodbusInstance.
+ *
+ * Instance holds only a pointer to its extensions (FreemodbusInstance::extensions), so instances which use none of
+ * these features pay for a single pointer. Extensions must be attached before the instance is initialized and must not
+ * be shared by several instances.
+ *
+ * Features:
+ * - publishing of notifications about writes - writeNotificationQueue;
+ * - answering reads of hot register ranges with ready responses - hotRangeCache;
+ * - capture of received and sent frames - captureRing and captureChannel;
+ * - warm reconfiguration of serial port - FreemodbusSerialInstance::reconfigureSerial();
+ * - dropping of Modbus ASCII frames addressed to other slaves before they reach FreeMODBUS - asciiAddress;
+ */
+
+struct FreemodbusExtensions
+{
+	/// SerialConfiguration contains parameters of serial port
+	struct SerialConfiguration
+	{
+		/// baud rate, bps
+		uint32_t baudRate;
+
+		/// parity
+		distortos::devices::UartParity parity;
+
+		/// character length, bits
+		uint8_t characterLength;
+	};
+
+	/**
+	 * \brief FreemodbusExtensions's constructor
+	 */
+
+	constexpr FreemodbusExtensions() :
+			writeNotificationQueue{},
+			hotRangeCache{},
+			captureRing{},
+			serialConfiguration{},
+			pendingSerialConfiguration{},
+			serialReconfigurationResult{},
+			serialReconfigurationPending{},
+			serialPortClosed{},
+			asciiFrameDropped{},
+			asciiAddress{},
+			captureChannel{}
+	{
+
+	}
+
+	/// pointer to queue of notifications about writes which is published by the instance, nullptr if not used
+	WriteNotificationQueue* writeNotificationQueue;
+
+	/// pointer to cache of ready responses to reads of hot register ranges, nullptr if not used
+	HotRangeCache* hotRangeCache;
+
+	/// pointer to ring to which received and sent Modbus TCP, Modbus UDP and Modbus RTU frames are copied, nullptr if
+	/// not used
+	CaptureRing* captureRing;
+
+	/// current parameters of serial port
+	SerialConfiguration serialConfiguration;
+
+	/// parameters of serial port which will be applied at next frame boundary
+	SerialConfiguration pendingSerialConfiguration;
+
+	/// result of the last applied change of parameters of serial port - 0 if new parameters were applied, error code
+	/// returned by distortos::devices::SerialPort::open() for new parameters otherwise
+	std::atomic<int> serialReconfigurationResult;
+
+	/// true if pendingSerialConfiguration waits to be applied, false otherwise
+	std::atomic<bool> serialReconfigurationPending;
+
+	/// true if serial port could be opened neither with new nor with previous parameters, false otherwise
+	std::atomic<bool> serialPortClosed;
+
+	/// true if characters of Modbus ASCII frame addressed to other slave are dropped until its end, false otherwise
+	bool asciiFrameDropped;
+
+	/// address of Modbus ASCII slave, frames addressed to other slaves are dropped without passing their characters to
+	/// FreeMODBUS, 0 if all frames are passed to FreeMODBUS
+	uint8_t asciiAddress;
+
+	/// channel of the instance in records of captureRing
+	uint8_t captureChannel;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSEXTENSIONS_HPP_
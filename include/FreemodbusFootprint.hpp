@@ -0,0 +1,143 @@
+/**
+ * \file
+ * \brief FreemodbusFootprint struct header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSFOOTPRINT_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSFOOTPRINT_HPP_
+
+#include "FreemodbusExtensions.hpp"
+#include "FreemodbusTcpExtensions.hpp"
+#include "StaticFreemodbusInstance.hpp"
+
+/**
+ * FreemodbusFootprint is a static report of RAM used by instances of FreeMODBUS in current configuration.
+ *
+ * All values are compile-time constants, so they can be checked with static_assert() or printed by the application.
+ * Sizes of instances do not include optional features, which are paid only by instances with attached extensions, so
+ * savings compare only the layouts of instances.
+ */
+
+struct FreemodbusFootprint
+{
+private:
+
+	/// BaselineInstance mirrors the layout of FreemodbusInstance in which every instance had fields of all protocols
+	/// and embedded buffer for the largest frame
+	struct BaselineInstance
+	{
+#if MB_TCP_ENABLED == 1
+
+		/// size of buffer for complete Modbus frame
+		constexpr static size_t bufferSize {FreemodbusTcpInstance::tcpBufferSize};
+
+#else	// MB_TCP_ENABLED != 1
+
+		/// size of buffer for complete Modbus frame
+		constexpr static size_t bufferSize {FreemodbusSerialInstance::serialBufferSize};
+
+#endif	// MB_TCP_ENABLED != 1
+
+		/// instance of FreeMODBUS
+		xMBInstance rawInstance;
+
+#if MB_TCP_ENABLED == 1
+
+		/// range of listen sockets for Modbus TCP
+		FreemodbusTcpInstance::ListenSocketsRange listenSocketsRange;
+
+		/// deadline of Modbus TCP keepalive
+		distortos::TickClock::time_point tcpKeepaliveDeadline;
+
+		/// duration of Modbus TCP keepalive
+		distortos::TickClock::duration tcpKeepaliveDuration;
+
+#endif	// MB_TCP_ENABLED == 1
+
+		/// timer deadline
+		distortos::TickClock::time_point timerDeadline;
+
+		/// timer duration
+		distortos::TickClock::duration timerDuration;
+
+		/// number of bytes stored in buffer
+		size_t bytesInBuffer;
+
+#if MB_TCP_ENABLED == 1
+
+		/// client socket for Modbus TCP
+		int clientSocket;
+
+		/// listen socket for Modbus TCP
+		ListenSocket* listenSocket;
+
+		/// pointer to mutex used for serialization of access to shared listen sockets for Modbus TCP
+		distortos::Mutex* listenSocketsRangeMutex;
+
+#endif	// MB_TCP_ENABLED == 1
+
+		/// pointer to serial port
+		distortos::devices::SerialPort* serialPort;
+
+		/// current receiver position
+		size_t rxPosition;
+
+		/// current transmiter position
+		size_t txPosition;
+
+		/// buffer for bytes
+		uint8_t frameBuffer[bufferSize];
+
+		/// array with counters of pending events
+		std::array<uint8_t, 4> pendingEvents;
+
+		/// current mode of serial port
+		FreemodbusSerialInstance::SerialMode serialMode;
+	};
+
+public:
+
+	/// size of instance in the layout in which every instance had fields of all protocols and embedded buffer for the
+	/// largest frame, bytes
+	constexpr static size_t baselineInstance {sizeof(BaselineInstance)};
+
+	/// size of Modbus ASCII/RTU instance without frame buffer - shared buffer or buffer from a pool is used, bytes
+	constexpr static size_t bufferlessInstance {sizeof(FreemodbusSerialInstance)};
+
+	/// size of Modbus ASCII/RTU instance with embedded frame buffer, bytes
+	constexpr static size_t serialInstance {sizeof(StaticFreemodbusInstance<>)};
+
+	/// RAM saved by each Modbus ASCII/RTU instance with embedded frame buffer compared to baselineInstance, bytes
+	constexpr static size_t serialInstanceSavings {baselineInstance - serialInstance};
+
+#if MB_TCP_ENABLED == 1
+
+	/// size of Modbus TCP instance without frame buffer, bytes
+	constexpr static size_t bufferlessTcpInstance {sizeof(FreemodbusTcpInstance)};
+
+	/// size of Modbus TCP instance with embedded frame buffer, bytes
+	constexpr static size_t tcpInstance {sizeof(StaticFreemodbusTcpInstance<>)};
+
+	/// size of Modbus UDP instance with embedded frame buffer, bytes - one instance serves any number of masters, while
+	/// Modbus TCP needs one instance per connected master
+	constexpr static size_t udpInstance {sizeof(StaticFreemodbusUdpInstance<>)};
+
+	/// size of Modbus TCP extensions of one Modbus TCP instance which uses optional features, bytes
+	constexpr static size_t tcpExtensions {sizeof(FreemodbusTcpExtensions)};
+
+#endif	// MB_TCP_ENABLED == 1
+
+	/// RAM saved by each Modbus ASCII/RTU instance which does not embed its frame buffer, bytes
+	constexpr static size_t bufferlessInstanceSavings {serialInstance - bufferlessInstance};
+
+	/// size of extensions of one instance which uses optional features, bytes
+	constexpr static size_t extensions {sizeof(FreemodbusExtensions)};
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSFOOTPRINT_HPP_
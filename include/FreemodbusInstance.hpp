@@ -3,6 +3,7 @@
  * \brief FreemodbusInstance struct header
  *
  * \author Copyright (C) 2019 Aleksander Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -14,189 +15,84 @@
 
 #include "mbinstance.h"
 
-#include "distortos/TickClock.hpp"
-
-#if MB_TCP_ENABLED == 1
-
-#include "estd/ContiguousRange.hpp"
-
-#endif	// MB_TCP_ENABLED == 1
-
 #include <array>
 
-namespace distortos
-{
-
-#if MB_TCP_ENABLED == 1
-
-class Mutex;
-
-#endif	// MB_TCP_ENABLED == 1
+#include <cstddef>
+#include <cstdint>
 
-namespace devices
-{
-
-class SerialPort;
-
-}	// namespace devices
-
-}	// namespace distortos
+class FrameBufferPool;
+struct FreemodbusExtensions;
 
-#if MB_TCP_ENABLED == 1
-
-class ListenSocket;
-
-#endif	// MB_TCP_ENABLED == 1
+/**
+ * FreemodbusInstance struct is an instance of FreeMODBUS
+ *
+ * This struct contains only the fields shared by all instances and does not own its frame buffer. Use
+ * FreemodbusSerialInstance (or StaticFreemodbusInstance, with embedded frame buffer) for Modbus ASCII/RTU and
+ * FreemodbusTcpInstance for Modbus TCP - each of them has only the fields of its protocol.
+ *
+ * Instead of dedicated buffer, the instance may use a FrameBufferPool - buffer is taken from the pool only for the
+ * duration of a transaction, so idle instances hold no buffer at all.
+ */
 
-/// FreemodbusInstance struct is an instance of FreeMODBUS
 struct FreemodbusInstance
 {
-#if MB_TCP_ENABLED == 1
+	/// instance of FreeMODBUS
+	xMBInstance rawInstance;
 
-	/// size of MBAP header of Modbus TCP
-	constexpr static size_t mbapHeaderSize {7};
+	/// number of bytes stored in buffer
+	size_t bytesInBuffer;
 
-	/// size of buffer for complete Modbus TCP frame
-	constexpr static size_t tcpBufferSize {mbapHeaderSize + MB_SER_SIZE_MAX};
+	/// pointer to state of optional features of the instance, nullptr if none of them is used
+	FreemodbusExtensions* extensions;
 
-	/// size of buffer for complete Modbus frame
-	constexpr static size_t bufferSize {tcpBufferSize};
+	/// pointer to pool from which frame buffers are taken, nullptr if dedicated frame buffer is used
+	FrameBufferPool* frameBufferPool;
 
-	/// type alias for range of listen sockets for Modbus TCP
-	using ListenSocketsRange = estd::ContiguousRange<ListenSocket>;
+	/// pointer to buffer for bytes, nullptr if no buffer is currently taken from the pool
+	uint8_t* frameBuffer;
 
-#else
+	/// size of buffer for bytes
+	size_t frameBufferSize;
+
+	/// array with counters of pending events
+	std::array<uint8_t, 4> pendingEvents;
 
-	/// size of buffer for complete Modbus frame
-	constexpr static size_t bufferSize {MB_SER_SIZE_MAX};
+	/// true if xMBPortEventGet() must not wait for events (instance is polled by FreemodbusScheduler), false otherwise
+	bool nonBlocking;
 
-#endif	// MB_TCP_ENABLED == 1
+	/// true if responses are sent without blocking (instance is served by FreemodbusExecutor), false otherwise
+	bool nonBlockingSend;
 
-	/// SerialMode contains possible modes of serial port
-	enum class SerialMode : uint8_t
-	{
-		/// serial port disabled
-		disabled,
-		/// serial port is in receiver mode
-		receiver,
-		/// serial port is in transmiter mode
-		transmiter,
-	};
+	/// number of bytes of response which were not sent yet, stored at the beginning of buffer, used only if
+	/// nonBlockingSend is true
+	uint16_t bytesToSend;
 
-#if MB_TCP_ENABLED == 1
+protected:
 
 	/**
 	 * \brief FreemodbusInstance's constructor
 	 *
-	 * \param [in] serialPortt is a pointer to serial port that will be used for communication for Modbus ASCII/RTU,
-	 * ignored for Modbus TCP
-	 * \param [in] listenSocketsRangee is a range of listen sockets for Modbus TCP, ignored for Modbus ASCII/RTU
-	 * \param [in] listenSocketsRangeMutexx is a pointer to mutex used for serialization of access to shared listen
-	 * sockets for Modbus TCP, ignored for Modbus ASCII/RTU
+	 * \param [in] frameBufferr is a pointer to buffer for frames, nullptr if buffers are taken from the pool
+	 * \param [in] frameBufferSizee is the size of \a frameBufferr, bytes
+	 * \param [in] frameBufferPooll is a pointer to pool from which frame buffers are taken, nullptr if dedicated frame
+	 * buffer is used
 	 */
 
-	constexpr FreemodbusInstance(distortos::devices::SerialPort* const serialPortt,
-			const ListenSocketsRange listenSocketsRangee, distortos::Mutex* const listenSocketsRangeMutexx) :
+	constexpr FreemodbusInstance(uint8_t* const frameBufferr, const size_t frameBufferSizee,
+			FrameBufferPool* const frameBufferPooll) :
 					rawInstance{},
-					listenSocketsRange{listenSocketsRangee},
-					tcpKeepaliveDeadline{},
-					tcpKeepaliveDuration{},
-					timerDeadline{distortos::TickClock::time_point::max()},
-					timerDuration{},
 					bytesInBuffer{},
-					clientSocket{-1},
-					listenSocket{},
-					listenSocketsRangeMutex{listenSocketsRangeMutexx},
-					serialPort{serialPortt},
-					rxPosition{},
-					txPosition{},
-					frameBuffer{},
+					extensions{},
+					frameBufferPool{frameBufferPooll},
+					frameBuffer{frameBufferr},
+					frameBufferSize{frameBufferSizee},
 					pendingEvents{},
-					serialMode{SerialMode::disabled}
+					nonBlocking{},
+					nonBlockingSend{},
+					bytesToSend{}
 	{
 
 	}
-
-#else	// MB_TCP_ENABLED != 1
-
-	/**
-	 * \brief FreemodbusInstance's constructor
-	 *
-	 * \param [in] serialPortt is a reference to serial port that will be used for communication for Modbus ASCII/RTU
-	 */
-
-	constexpr explicit FreemodbusInstance(distortos::devices::SerialPort& serialPortt) :
-			rawInstance{},
-			timerDeadline{distortos::TickClock::time_point::max()},
-			timerDuration{},
-			bytesInBuffer{},
-			serialPort{&serialPortt},
-			rxPosition{},
-			txPosition{},
-			frameBuffer{},
-			pendingEvents{},
-			serialMode{SerialMode::disabled}
-	{
-
-	}
-
-#endif	// MB_TCP_ENABLED != 1
-
-	/// instance of FreeMODBUS
-	xMBInstance rawInstance;
-
-#if MB_TCP_ENABLED == 1
-
-	/// range of listen sockets for Modbus TCP
-	ListenSocketsRange listenSocketsRange;
-
-	/// deadline of Modbus TCP keepalive
-	distortos::TickClock::time_point tcpKeepaliveDeadline;
-
-	/// duration of Modbus TCP keepalive
-	distortos::TickClock::duration tcpKeepaliveDuration;
-
-#endif	// MB_TCP_ENABLED == 1
-
-	/// timer deadline
-	distortos::TickClock::time_point timerDeadline;
-
-	/// timer duration
-	distortos::TickClock::duration timerDuration;
-
-	/// number of bytes stored in buffer
-	size_t bytesInBuffer;
-
-#if MB_TCP_ENABLED == 1
-
-	/// client socket for Modbus TCP, -1 if no client is connected
-	int clientSocket;
-
-	/// listen socket for Modbus TCP
-	ListenSocket* listenSocket;
-
-	/// pointer to mutex used for serialization of access to shared listen sockets for Modbus TCP
-	distortos::Mutex* listenSocketsRangeMutex;
-
-#endif	// MB_TCP_ENABLED == 1
-
-	/// pointer to serial port that will be used for communication for Modbus ASCII/RTU
-	distortos::devices::SerialPort* serialPort;
-
-	/// current receiver position
-	size_t rxPosition;
-
-	/// current transmiter position
-	size_t txPosition;
-
-	/// buffer for bytes
-	uint8_t frameBuffer[bufferSize];
-
-	/// array with counters of pending events
-	std::array<uint8_t, 4> pendingEvents;
-
-	/// current mode of serial port
-	SerialMode serialMode;
 };
 
 #endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSINSTANCE_HPP_
@@ -0,0 +1,59 @@
+/**
+ * \file
+ * \brief FreemodbusLocalInstance struct header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSLOCALINSTANCE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSLOCALINSTANCE_HPP_
+
+#include "FreemodbusTcpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+class LocalRing;
+
+/**
+ * FreemodbusLocalInstance struct is an instance of FreeMODBUS for co-located client, which exchanges Modbus TCP frames
+ * through LocalRing instead of sockets
+ *
+ * The instance is initialized with eMBTCPInit() and works in MB_TCP mode, port given there is ignored. Frames are
+ * handled in place in slots of the ring, so the instance has no frame buffer of its own. Master address of requests
+ * (for RequestRateLimiter) is the loopback address (127.0.0.1), master port is 0.
+ *
+ * The instance is woken directly by the client, so it should be polled by its own thread - FreemodbusScheduler and
+ * FreemodbusExecutor wait only for sockets, so they notice requests of the ring only on their periodic wake-ups.
+ */
+
+struct FreemodbusLocalInstance : public FreemodbusTcpInstance
+{
+	/**
+	 * \brief FreemodbusLocalInstance's constructor
+	 *
+	 * \param [in] localRingg is a reference to ring with requests of local client
+	 */
+
+	constexpr explicit FreemodbusLocalInstance(LocalRing& localRingg) :
+			FreemodbusTcpInstance{{}, nullptr, nullptr, 0, nullptr, &localHooks},
+			localRing{localRingg}
+	{
+
+	}
+
+	/// reference to ring with requests of local client
+	LocalRing& localRing;
+
+private:
+
+	/// implementation of port of local client
+	static const FreemodbusTcpHooks localHooks;
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSLOCALINSTANCE_HPP_
@@ -0,0 +1,136 @@
+/**
+ * \file
+ * \brief FreemodbusScheduler class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSSCHEDULER_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSSCHEDULER_HPP_
+
+#include "mbconfig.h"
+
+#include "distortos/TickClock.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+struct FreemodbusInstance;
+
+#if MB_TCP_ENABLED == 1
+
+class FreemodbusWorkerPool;
+
+#endif	// MB_TCP_ENABLED == 1
+
+/**
+ * FreemodbusScheduler runs many instances of FreeMODBUS (Modbus ASCII/RTU and Modbus TCP) cooperatively in one thread.
+ *
+ * Instances are switched to non-blocking mode, so each eMBPoll() only handles data which is already available. Between
+ * the steps the scheduler waits on sockets of all Modbus TCP instances, bounded by the earliest timer deadline of
+ * Modbus ASCII/RTU instances. Serial ports cannot be waited on together with sockets, so while any serial port is
+ * enabled the wait is additionally bounded by serial poll period.
+ *
+ * If worker pool is given, requests received by Modbus TCP instances are executed by the pool and the scheduler only
+ * does their I/O. Sockets of instances whose requests are executed are not waited on, instead the scheduler waits on
+ * wake socket of the pool (FreemodbusWorkerPool::openWakeSocket()), so completed instance is picked up as soon as lwIP
+ * delivers the datagram sent by the worker (one pass of tcpip thread), independently of serial poll period. If wake
+ * socket of the pool is not opened, the wait is bounded by serial poll period, which limits each connection to one
+ * request per this period.
+ */
+
+class FreemodbusScheduler
+{
+public:
+
+	/// type alias for range of pointers to instances run by the scheduler
+	using Range = estd::ContiguousRange<FreemodbusInstance* const>;
+
+	/**
+	 * \brief FreemodbusScheduler's constructor
+	 *
+	 * \param [in] range is a range of pointers to instances run by the scheduler, all of them must be initialized and
+	 * enabled with FreeMODBUS API before they are polled
+	 * \param [in] serialPollPeriod is the max interval between polls of serial ports, should be shorter than the
+	 * duration of 3.5 characters at the highest baud rate in use
+	 */
+
+	constexpr FreemodbusScheduler(const Range range, const distortos::TickClock::duration serialPollPeriod) :
+			range_{range},
+			serialPollPeriod_{serialPollPeriod}
+#if MB_TCP_ENABLED == 1
+			, workerPool_{}
+#endif	// MB_TCP_ENABLED == 1
+	{
+
+	}
+
+#if MB_TCP_ENABLED == 1
+
+	/**
+	 * \brief FreemodbusScheduler's constructor
+	 *
+	 * \param [in] range is a range of pointers to instances run by the scheduler, all of them must be initialized and
+	 * enabled with FreeMODBUS API before they are polled
+	 * \param [in] serialPollPeriod is the max interval between polls of serial ports (and of instances whose requests
+	 * are executed by \a workerPool, if its wake socket is not opened), should be shorter than the duration of 3.5
+	 * characters at the highest baud rate in use
+	 * \param [in] workerPool is a reference to worker pool which executes requests received by Modbus TCP instances
+	 */
+
+	constexpr FreemodbusScheduler(const Range range, const distortos::TickClock::duration serialPollPeriod,
+			FreemodbusWorkerPool& workerPool) :
+					range_{range},
+					serialPollPeriod_{serialPollPeriod},
+					workerPool_{&workerPool}
+	{
+
+	}
+
+#endif	// MB_TCP_ENABLED == 1
+
+	/**
+	 * \brief Runs one iteration of the scheduler.
+	 *
+	 * Each instance is stepped until it has no pending events, then the scheduler waits for activity on any socket,
+	 * earliest timer deadline, serial poll period or \a deadline, whichever comes first.
+	 *
+	 * \param [in] deadline is the deadline of waiting
+	 */
+
+	void poll(distortos::TickClock::time_point deadline) const;
+
+	/**
+	 * \brief Runs the scheduler forever.
+	 */
+
+	void run() const;
+
+private:
+
+	/**
+	 * \brief Waits for activity on any of the instances.
+	 *
+	 * \param [in] deadline is the deadline of waiting
+	 */
+
+	void wait(distortos::TickClock::time_point deadline) const;
+
+	/// range of pointers to instances run by the scheduler
+	Range range_;
+
+	/// max interval between polls of serial ports
+	distortos::TickClock::duration serialPollPeriod_;
+
+#if MB_TCP_ENABLED == 1
+
+	/// pointer to worker pool which executes requests received by Modbus TCP instances, nullptr if not used
+	FreemodbusWorkerPool* workerPool_;
+
+#endif	// MB_TCP_ENABLED == 1
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSSCHEDULER_HPP_
@@ -0,0 +1,170 @@
+/**
+ * \file
+ * \brief FreemodbusSerialInstance struct header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSSERIALINSTANCE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSSERIALINSTANCE_HPP_
+
+#include "FreemodbusInstance.hpp"
+
+#include "distortos/devices/communication/UartParity.hpp"
+
+#include "distortos/TickClock.hpp"
+
+namespace distortos
+{
+
+namespace devices
+{
+
+class SerialPort;
+
+}	// namespace devices
+
+}	// namespace distortos
+
+/**
+ * FreemodbusSerialInstance struct is an instance of FreeMODBUS for Modbus ASCII/RTU
+ *
+ * Only instances which are initialized for Modbus ASCII/RTU (eMBInit()) must be of this type - all serial port and
+ * timer functions of the port cast the instance to FreemodbusSerialInstance.
+ *
+ * This struct does not own its frame buffer. Use StaticFreemodbusInstance for an instance with embedded frame buffer.
+ */
+
+struct FreemodbusSerialInstance : public FreemodbusInstance
+{
+	/// size of buffer for complete Modbus ASCII/RTU frame
+	constexpr static size_t serialBufferSize {MB_SER_SIZE_MAX};
+
+	/// SerialMode contains possible modes of serial port
+	enum class SerialMode : uint8_t
+	{
+		/// serial port disabled
+		disabled,
+		/// serial port is in receiver mode
+		receiver,
+		/// serial port is in transmiter mode
+		transmiter,
+	};
+
+	/**
+	 * \brief FreemodbusSerialInstance's constructor
+	 *
+	 * \param [in] serialPortt is a reference to serial port that will be used for communication for Modbus ASCII/RTU
+	 * \param [in] frameBufferr is a pointer to buffer for frames, it may be shared with other instances which are
+	 * never active at the same time
+	 * \param [in] frameBufferSizee is the size of \a frameBufferr, bytes, should be at least serialBufferSize
+	 */
+
+	constexpr FreemodbusSerialInstance(distortos::devices::SerialPort& serialPortt, uint8_t* const frameBufferr,
+			const size_t frameBufferSizee) :
+					FreemodbusSerialInstance{serialPortt, frameBufferr, frameBufferSizee, nullptr}
+	{
+
+	}
+
+	/**
+	 * \brief FreemodbusSerialInstance's constructor
+	 *
+	 * \param [in] serialPortt is a reference to serial port that will be used for communication for Modbus ASCII/RTU
+	 * \param [in] frameBufferPooll is a reference to pool from which frame buffers are taken, size of its buffers
+	 * should be at least serialBufferSize
+	 */
+
+	constexpr FreemodbusSerialInstance(distortos::devices::SerialPort& serialPortt, FrameBufferPool& frameBufferPooll) :
+			FreemodbusSerialInstance{serialPortt, nullptr, 0, &frameBufferPooll}
+	{
+
+	}
+
+	/**
+	 * \brief Requests change of parameters of serial port without closing the instance.
+	 *
+	 * Parameters are applied by the thread which polls the instance, at the next frame boundary - when the receiver is
+	 * idle and no received frame waits for handling. Only the serial port is reopened, FreeMODBUS is not reinitialized
+	 * and duration of Modbus RTU T3.5 timer is recalculated for new baud rate. If the serial port cannot be opened with
+	 * new parameters, previous parameters are restored. If the port cannot be opened with previous parameters either,
+	 * it stays closed and each poll of the instance retries to open it with previous parameters. Outcome of the change
+	 * is available from getSerialReconfigurationResult().
+	 *
+	 * State of the change is kept in extensions of the instance, which must be attached before the instance is
+	 * initialized. Must not be called concurrently for the same instance.
+	 *
+	 * \param [in] baudRate is the new baud rate, bps
+	 * \param [in] characterLength is the new character length, bits
+	 * \param [in] parity is the new parity
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBUSY - previous change was not applied yet;
+	 * - ENOTSUP - instance has no extensions attached;
+	 */
+
+	int reconfigureSerial(uint32_t baudRate, uint8_t characterLength, distortos::devices::UartParity parity);
+
+	/**
+	 * \brief Gets outcome of the last change of parameters of serial port requested with reconfigureSerial().
+	 *
+	 * \return 0 if new parameters were applied or no change was requested, error code otherwise:
+	 * - EINPROGRESS - change was not applied yet;
+	 * - EIO - serial port could be opened neither with new nor with previous parameters, it is closed until one of the
+	 * retries succeeds;
+	 * - ENOTSUP - instance has no extensions attached;
+	 * - error codes returned by distortos::devices::SerialPort::open() for new parameters - previous parameters were
+	 * restored;
+	 */
+
+	int getSerialReconfigurationResult() const;
+
+	/// timer deadline
+	distortos::TickClock::time_point timerDeadline;
+
+	/// timer duration
+	distortos::TickClock::duration timerDuration;
+
+	/// pointer to serial port that will be used for communication for Modbus ASCII/RTU
+	distortos::devices::SerialPort* serialPort;
+
+	/// current receiver position
+	size_t rxPosition;
+
+	/// current transmiter position
+	size_t txPosition;
+
+	/// current mode of serial port
+	SerialMode serialMode;
+
+protected:
+
+	/**
+	 * \brief FreemodbusSerialInstance's constructor
+	 *
+	 * \param [in] serialPortt is a reference to serial port that will be used for communication for Modbus ASCII/RTU
+	 * \param [in] frameBufferr is a pointer to buffer for frames, nullptr if buffers are taken from the pool
+	 * \param [in] frameBufferSizee is the size of \a frameBufferr, bytes
+	 * \param [in] frameBufferPooll is a pointer to pool from which frame buffers are taken, nullptr if dedicated frame
+	 * buffer is used
+	 */
+
+	constexpr FreemodbusSerialInstance(distortos::devices::SerialPort& serialPortt, uint8_t* const frameBufferr,
+			const size_t frameBufferSizee, FrameBufferPool* const frameBufferPooll) :
+					FreemodbusInstance{frameBufferr, frameBufferSizee, frameBufferPooll},
+					timerDeadline{distortos::TickClock::time_point::max()},
+					timerDuration{},
+					serialPort{&serialPortt},
+					rxPosition{},
+					txPosition{},
+					serialMode{SerialMode::disabled}
+	{
+
+	}
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSSERIALINSTANCE_HPP_
@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \brief FreemodbusTcpExtensions struct header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSTCPEXTENSIONS_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSTCPEXTENSIONS_HPP_
+
+#include "mbconfig.h"
+
+#if MB_TCP_ENABLED == 1
+
+#include "distortos/TickClock.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+#include <atomic>
+
+struct FunctionHandlerTable;
+class ModbusGateway;
+class RequestRateLimiter;
+class TcpTransport;
+
+/**
+ * FreemodbusTcpExtensions struct contains state of optional features of FreemodbusTcpInstance.
+ *
+ * Instance holds only a pointer to its extensions (FreemodbusTcpInstance::tcpExtensions), so plain Modbus TCP slave
+ * pays for a single pointer. Extensions must be attached before the instance is initialized and must not be shared by
+ * several instances.
+ *
+ * Features:
+ * - forwarding of requests to Modbus RTU bus - gateway;
+ * - execution of requests with the table of function handlers - functionHandlerTable;
+ * - transport on top of client socket (e.g. MbedtlsTransport) - transport;
+ * - batching of responses to pipelined requests - txBatchRange and txBatchDelay;
+ * - limiting of rate of requests - requestRateLimiter;
+ * - execution of requests by FreemodbusWorkerPool - executing;
+ * - change of port without closing the instance - FreemodbusTcpInstance::reconfigurePort();
+ */
+
+struct FreemodbusTcpExtensions
+{
+	/// type alias for range of storage for batch of responses
+	using TxBatchRange = estd::ContiguousRange<uint8_t>;
+
+	/**
+	 * \brief FreemodbusTcpExtensions's constructor
+	 */
+
+	constexpr FreemodbusTcpExtensions() :
+			txBatchRange{},
+			txBatchDeadline{},
+			txBatchDelay{},
+			admissionTime{},
+			txBatchSize{},
+			functionHandlerTable{},
+			gateway{},
+			transport{},
+			requestRateLimiter{},
+			masterAddress{},
+			executing{},
+			pendingPort{},
+			masterPort{}
+	{
+
+	}
+
+	/// range of storage for batch of responses to pipelined requests, empty range disables batching
+	TxBatchRange txBatchRange;
+
+	/// deadline of sending the batch of responses
+	distortos::TickClock::time_point txBatchDeadline;
+
+	/// max duration for which first response in the batch may be delayed
+	distortos::TickClock::duration txBatchDelay;
+
+	/// time point at which request deferred by requestRateLimiter may be handled, default-constructed if no request is
+	/// deferred
+	distortos::TickClock::time_point admissionTime;
+
+	/// number of bytes stored in the batch of responses
+	size_t txBatchSize;
+
+	/// pointer to table of function handlers used for received requests, nullptr if function handlers registered in
+	/// FreeMODBUS are used
+	const FunctionHandlerTable* functionHandlerTable;
+
+	/// pointer to gateway to which received requests are forwarded, nullptr if handled locally
+	ModbusGateway* gateway;
+
+	/// pointer to transport used on top of client socket, nullptr if socket is used directly
+	TcpTransport* transport;
+
+	/// pointer to limiter of rate of requests, nullptr if not used
+	RequestRateLimiter* requestRateLimiter;
+
+	/// IPv4 address of connected master (Modbus TCP) or of master which sent the request which is currently handled
+	/// (Modbus UDP), network byte order, IPv4-mapped IPv6 address is converted to IPv4, 0 for any other IPv6 address
+	uint32_t masterAddress;
+
+	/// true if received request is currently executed by FreemodbusWorkerPool, false otherwise
+	std::atomic<bool> executing;
+
+	/// port which will be applied before the next poll, 0 if no change is pending
+	std::atomic<uint16_t> pendingPort;
+
+	/// port of connected master (Modbus TCP) or of master which sent the request which is currently handled (Modbus
+	/// UDP), network byte order
+	uint16_t masterPort;
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSTCPEXTENSIONS_HPP_
@@ -0,0 +1,174 @@
+/**
+ * \file
+ * \brief FreemodbusTcpInstance struct header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSTCPINSTANCE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSTCPINSTANCE_HPP_
+
+#include "FreemodbusInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "distortos/TickClock.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+namespace distortos
+{
+
+class Mutex;
+
+}	// namespace distortos
+
+struct FreemodbusTcpExtensions;
+struct FreemodbusTcpHooks;
+class ListenSocket;
+
+/**
+ * FreemodbusTcpInstance struct is an instance of FreeMODBUS for Modbus TCP
+ *
+ * Only instances which are initialized for Modbus TCP (eMBTCPInit()) must be of this type - all Modbus TCP functions
+ * of the port cast the instance to FreemodbusTcpInstance.
+ *
+ * This struct contains only the fields needed by plain Modbus TCP slave, state of optional features (gateway, table of
+ * function handlers, transport, batching of responses, limiting of rate of requests, ...) is kept in
+ * FreemodbusTcpExtensions.
+ */
+
+struct FreemodbusTcpInstance : public FreemodbusInstance
+{
+	/// size of MBAP header of Modbus TCP
+	constexpr static size_t mbapHeaderSize {7};
+
+	/// size of buffer for complete Modbus TCP frame
+	constexpr static size_t tcpBufferSize {mbapHeaderSize + MB_SER_SIZE_MAX};
+
+	/// type alias for range of listen sockets for Modbus TCP
+	using ListenSocketsRange = estd::ContiguousRange<ListenSocket>;
+
+	/**
+	 * \brief FreemodbusTcpInstance's constructor
+	 *
+	 * \param [in] listenSocketsRangee is a range of listen sockets for Modbus TCP
+	 * \param [in] listenSocketsRangeMutexx is a pointer to mutex used for serialization of access to shared listen
+	 * sockets for Modbus TCP
+	 * \param [in] frameBufferr is a pointer to buffer for frames
+	 * \param [in] frameBufferSizee is the size of \a frameBufferr, bytes, should be at least tcpBufferSize
+	 */
+
+	constexpr FreemodbusTcpInstance(const ListenSocketsRange listenSocketsRangee,
+			distortos::Mutex* const listenSocketsRangeMutexx, uint8_t* const frameBufferr,
+			const size_t frameBufferSizee) :
+					FreemodbusTcpInstance{listenSocketsRangee, listenSocketsRangeMutexx, frameBufferr, frameBufferSizee,
+							nullptr, nullptr}
+	{
+
+	}
+
+	/**
+	 * \brief FreemodbusTcpInstance's constructor
+	 *
+	 * \param [in] listenSocketsRangee is a range of listen sockets for Modbus TCP
+	 * \param [in] listenSocketsRangeMutexx is a pointer to mutex used for serialization of access to shared listen
+	 * sockets for Modbus TCP
+	 * \param [in] frameBufferPooll is a reference to pool from which frame buffers are taken, size of its buffers
+	 * should be at least tcpBufferSize
+	 */
+
+	constexpr FreemodbusTcpInstance(const ListenSocketsRange listenSocketsRangee,
+			distortos::Mutex* const listenSocketsRangeMutexx, FrameBufferPool& frameBufferPooll) :
+					FreemodbusTcpInstance{listenSocketsRangee, listenSocketsRangeMutexx, nullptr, 0, &frameBufferPooll,
+							nullptr}
+	{
+
+	}
+
+	/**
+	 * \brief Requests change of port without closing the instance.
+	 *
+	 * The change is applied by the thread which polls the instance, at the beginning of its next poll - when it wakes
+	 * up for activity of the instance or for its timeout. Modbus TCP instance is bound to listen sockets for new port
+	 * before it is unbound from the previous ones, so connected client is not disconnected. Modbus UDP instance opens
+	 * new socket before closing the previous one. If the instance cannot be bound to new port, previous port is kept.
+	 *
+	 * State of the change is kept in Modbus TCP extensions of the instance, which must be attached before the instance
+	 * is initialized. Must not be called concurrently for the same instance.
+	 *
+	 * \param [in] port is the new port, 0 to use default Modbus TCP port (502)
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBUSY - previous change was not applied yet;
+	 * - ENOTSUP - instance has no Modbus TCP extensions attached;
+	 */
+
+	int reconfigurePort(uint16_t port);
+
+	/// range of listen sockets for Modbus TCP
+	ListenSocketsRange listenSocketsRange;
+
+	/// deadline of Modbus TCP keepalive
+	distortos::TickClock::time_point tcpKeepaliveDeadline;
+
+	/// duration of Modbus TCP keepalive
+	distortos::TickClock::duration tcpKeepaliveDuration;
+
+	/// client socket for Modbus TCP (socket for Modbus UDP in FreemodbusUdpInstance), -1 if no client is connected
+	int clientSocket;
+
+	/// pointer to implementation of Modbus TCP port of instance which does not use listen sockets (e.g.
+	/// FreemodbusUdpInstance), nullptr if listen sockets and connected client socket are used
+	const FreemodbusTcpHooks* hooks;
+
+	/// listen socket for Modbus TCP
+	ListenSocket* listenSocket;
+
+	/// pointer to mutex used for serialization of access to shared listen sockets for Modbus TCP
+	distortos::Mutex* listenSocketsRangeMutex;
+
+	/// pointer to state of optional features of Modbus TCP, nullptr if none of them is used
+	FreemodbusTcpExtensions* tcpExtensions;
+
+protected:
+
+	/**
+	 * \brief FreemodbusTcpInstance's constructor
+	 *
+	 * \param [in] listenSocketsRangee is a range of listen sockets for Modbus TCP
+	 * \param [in] listenSocketsRangeMutexx is a pointer to mutex used for serialization of access to shared listen
+	 * sockets for Modbus TCP
+	 * \param [in] frameBufferr is a pointer to buffer for frames, nullptr if buffers are taken from the pool
+	 * \param [in] frameBufferSizee is the size of \a frameBufferr, bytes
+	 * \param [in] frameBufferPooll is a pointer to pool from which frame buffers are taken, nullptr if dedicated frame
+	 * buffer is used
+	 * \param [in] hookss is a pointer to implementation of Modbus TCP port of instance which does not use listen
+	 * sockets, nullptr if listen sockets and connected client socket are used
+	 */
+
+	constexpr FreemodbusTcpInstance(const ListenSocketsRange listenSocketsRangee,
+			distortos::Mutex* const listenSocketsRangeMutexx, uint8_t* const frameBufferr,
+			const size_t frameBufferSizee, FrameBufferPool* const frameBufferPooll,
+			const FreemodbusTcpHooks* const hookss) :
+					FreemodbusInstance{frameBufferr, frameBufferSizee, frameBufferPooll},
+					listenSocketsRange{listenSocketsRangee},
+					tcpKeepaliveDeadline{},
+					tcpKeepaliveDuration{},
+					clientSocket{-1},
+					hooks{hookss},
+					listenSocket{},
+					listenSocketsRangeMutex{listenSocketsRangeMutexx},
+					tcpExtensions{}
+	{
+
+	}
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSTCPINSTANCE_HPP_
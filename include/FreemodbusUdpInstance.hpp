@@ -0,0 +1,83 @@
+/**
+ * \file
+ * \brief FreemodbusUdpInstance struct header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSUDPINSTANCE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSUDPINSTANCE_HPP_
+
+#include "FreemodbusTcpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "ListenSocket.hpp"
+
+#include "lwip/sockets.h"
+
+/**
+ * FreemodbusUdpInstance struct is an instance of FreeMODBUS for Modbus UDP
+ *
+ * Modbus UDP uses the same MBAP framing as Modbus TCP, so the instance is initialized with eMBTCPInit() and works in
+ * MB_TCP mode. One datagram carries exactly one frame. All masters share one UDP socket of the instance - there is no
+ * connection, keepalive or listen socket, response is sent to the address from which the request was received. Requests
+ * are handled one at a time, requests from other masters wait in the socket. The socket is bound to the local address
+ * selected just like for ListenSocket - IPv4, IPv6 or both.
+ */
+
+struct FreemodbusUdpInstance : public FreemodbusTcpInstance
+{
+	/**
+	 * \brief FreemodbusUdpInstance's constructor
+	 *
+	 * \param [in] frameBufferr is a pointer to buffer for frames
+	 * \param [in] frameBufferSizee is the size of \a frameBufferr, bytes, should be at least tcpBufferSize
+	 * \param [in] localAddresss is the local address to which the socket is bound, default - any local IPv4 address
+	 */
+
+	constexpr FreemodbusUdpInstance(uint8_t* const frameBufferr, const size_t frameBufferSizee,
+			const ListenSocket::LocalAddress& localAddresss = ListenSocket::ipv4Address({})) :
+					FreemodbusTcpInstance{{}, nullptr, frameBufferr, frameBufferSizee, nullptr, &udpHooks},
+					localAddress{localAddresss},
+					masterSocketAddress{}
+	{
+
+	}
+
+	/**
+	 * \brief FreemodbusUdpInstance's constructor
+	 *
+	 * \param [in] frameBufferPooll is a reference to pool from which frame buffers are taken, size of its buffers
+	 * should be at least tcpBufferSize
+	 * \param [in] localAddresss is the local address to which the socket is bound, default - any local IPv4 address
+	 */
+
+	constexpr explicit FreemodbusUdpInstance(FrameBufferPool& frameBufferPooll,
+			const ListenSocket::LocalAddress& localAddresss = ListenSocket::ipv4Address({})) :
+					FreemodbusTcpInstance{{}, nullptr, nullptr, 0, &frameBufferPooll, &udpHooks},
+					localAddress{localAddresss},
+					masterSocketAddress{}
+	{
+
+	}
+
+	/// local address to which the socket is bound
+	ListenSocket::LocalAddress localAddress;
+
+	/// address of master which sent the request which is currently handled
+	sockaddr_storage masterSocketAddress;
+
+private:
+
+	/// implementation of Modbus UDP port
+	static const FreemodbusTcpHooks udpHooks;
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSUDPINSTANCE_HPP_
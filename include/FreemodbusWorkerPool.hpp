@@ -0,0 +1,209 @@
+/**
+ * \file
+ * \brief FreemodbusWorkerPool class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSWORKERPOOL_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSWORKERPOOL_HPP_
+
+#include "mbconfig.h"
+
+#if MB_TCP_ENABLED == 1
+
+#include "distortos/Mutex.hpp"
+#include "distortos/Semaphore.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+#include <atomic>
+
+struct FreemodbusTcpInstance;
+
+/**
+ * FreemodbusWorkerPool executes requests received by Modbus TCP instances in a pool of worker threads.
+ *
+ * FreemodbusScheduler given a pool only does I/O and MBAP reassembly - complete requests are submitted to the pool,
+ * where function handlers are executed and responses are sent with xMBTCPPortSendResponse(). Each worker has its own
+ * queue, idle workers steal requests from the queues of others. Instance does not receive next request until its
+ * current one is completed, so responses of each connection are sent in order.
+ *
+ * Worker threads are created by the application, each one calls runWorker() with a different index.
+ *
+ * When execution of a request is done, worker wakes the scheduler with a datagram sent to wake socket (UDP socket
+ * connected to itself on loopback interface, opened with openWakeSocket()), so the scheduler waits on sockets of all
+ * instances and the next request of the instance is received after the delivery of this datagram by lwIP (one pass of
+ * tcpip thread), not after serial poll period. Without wake socket the scheduler checks instances whose requests are
+ * executed every serial poll period, which limits each connection to one request per this period. One pool wakes one
+ * scheduler.
+ */
+
+class FreemodbusWorkerPool
+{
+public:
+
+	/// type alias for range of storage for queue of a worker
+	using QueueRange = estd::ContiguousRange<FreemodbusTcpInstance*>;
+
+	/// Worker is a single worker of the pool
+	class Worker
+	{
+		friend class FreemodbusWorkerPool;
+
+	public:
+
+		/**
+		 * \brief Worker's constructor
+		 *
+		 * \param [in] queueRange is a range of storage for queue of the worker, its size is the capacity of the queue
+		 */
+
+		constexpr explicit Worker(const QueueRange queueRange) :
+				mutex_{distortos::Mutex::Type::normal, distortos::Mutex::Protocol::priorityInheritance},
+				semaphore_{0, 1},
+				queueRange_{queueRange},
+				queueBegin_{},
+				queueSize_{},
+				busy_{}
+		{
+
+		}
+
+	private:
+
+		/**
+		 * \brief Tries to take request from the front of the queue - used by the owner of the queue.
+		 *
+		 * \return pointer to instance with request, nullptr if the queue is empty
+		 */
+
+		FreemodbusTcpInstance* tryPopFront();
+
+		/**
+		 * \brief Tries to take request from the back of the queue - used by other workers.
+		 *
+		 * \return pointer to instance with request, nullptr if the queue is empty
+		 */
+
+		FreemodbusTcpInstance* tryPopBack();
+
+		/**
+		 * \brief Tries to add request to the queue.
+		 *
+		 * \param [in] instance is a reference to instance with request
+		 *
+		 * \return true if request was added, false if the queue is full
+		 */
+
+		bool tryPush(FreemodbusTcpInstance& instance);
+
+		/// mutex used for serialization of access to the queue
+		distortos::Mutex mutex_;
+
+		/// semaphore used to wake the worker
+		distortos::Semaphore semaphore_;
+
+		/// range of storage for the queue
+		QueueRange queueRange_;
+
+		/// index of first element of the queue
+		size_t queueBegin_;
+
+		/// number of elements in the queue
+		size_t queueSize_;
+
+		/// true if the worker is executing a request, false otherwise
+		std::atomic<bool> busy_;
+	};
+
+	/// type alias for range of workers
+	using WorkersRange = estd::ContiguousRange<Worker>;
+
+	/**
+	 * \brief FreemodbusWorkerPool's constructor
+	 *
+	 * \param [in] workersRange is a range of workers of the pool
+	 */
+
+	constexpr explicit FreemodbusWorkerPool(const WorkersRange workersRange) :
+			workersRange_{workersRange},
+			nextWorker_{},
+			wakeSocket_{-1},
+			wakePending_{}
+	{
+
+	}
+
+	/**
+	 * \brief Clears pending wake of the scheduler and drains wake socket.
+	 *
+	 * Called by the scheduler before it checks which instances are done, so completions after this call wake it again.
+	 */
+
+	void consumeWake();
+
+	/**
+	 * \return wake socket, readable when execution of a request is done, -1 if wake socket is not opened
+	 */
+
+	int getWakeSocket() const
+	{
+		return wakeSocket_;
+	}
+
+	/**
+	 * \brief Opens wake socket.
+	 *
+	 * Must be called after lwIP is initialized (loopback interface must be enabled) and before the scheduler is run.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBUSY - wake socket is already opened;
+	 * - error codes returned by lwIP library;
+	 */
+
+	int openWakeSocket();
+
+	/**
+	 * \brief Runs a worker - never returns.
+	 *
+	 * \param [in] index is the index of worker in range of workers, each worker thread must use a different one
+	 */
+
+	[[noreturn]] void runWorker(size_t index);
+
+	/**
+	 * \brief Submits instance with received request to the pool.
+	 *
+	 * Idle workers are preferred, otherwise the requests are distributed evenly.
+	 *
+	 * \param [in] instance is a reference to instance with request (pending EV_EXECUTE event), it must have Modbus TCP
+	 * extensions with FreemodbusTcpExtensions::executing flag set
+	 *
+	 * \return true if the request was submitted, false if the queues are full
+	 */
+
+	bool submit(FreemodbusTcpInstance& instance);
+
+private:
+
+	/// range of workers of the pool
+	WorkersRange workersRange_;
+
+	/// index of worker which is checked first by next submit()
+	std::atomic<size_t> nextWorker_;
+
+	/// UDP socket connected to itself, used to wake the scheduler, -1 if not opened
+	int wakeSocket_;
+
+	/// true if datagram which wakes the scheduler was sent and not consumed yet, false otherwise
+	std::atomic<bool> wakePending_;
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FREEMODBUSWORKERPOOL_HPP_
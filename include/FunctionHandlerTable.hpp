@@ -0,0 +1,205 @@
+/**
+ * \file
+ * \brief FunctionHandlerTable struct header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_FUNCTIONHANDLERTABLE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_FUNCTIONHANDLERTABLE_HPP_
+
+#include "mbinstance.h"
+#include "mbproto.h"
+
+#include "estd/IntegerSequence.hpp"
+
+#include <array>
+#include <type_traits>
+
+/**
+ * \brief Type of Modbus function handler.
+ *
+ * The signature is the same as the one of function handlers of FreeMODBUS, so these can be used directly.
+ *
+ * \param [in] instance is a pointer to instance of FreeMODBUS which received the request
+ * \param [in,out] pdu is a pointer to buffer with request PDU, response PDU is written here
+ * \param [in,out] pduSize is a pointer to size of request PDU, size of response PDU is written here
+ *
+ * \return MB_EX_NONE on success, exception code which will be sent in response otherwise
+ */
+
+using FunctionHandler = eMBException(xMBInstance* instance, uint8_t* pdu, uint16_t* pduSize);
+
+/**
+ * FunctionHandlerTable is a table of Modbus function handlers indexed directly by function code.
+ *
+ * The table is meant to be generated at compile time with makeFunctionHandlerTable(), so it can be placed in flash and
+ * only the handlers which are listed get linked.
+ */
+
+struct FunctionHandlerTable
+{
+	/// number of entries in the table - all function codes without exception bit
+	constexpr static size_t size {MB_FUNC_ERROR};
+
+	/**
+	 * \brief Executes function handler selected by function code of request.
+	 *
+	 * \param [in] instance is a pointer to instance of FreeMODBUS which received the request
+	 * \param [in,out] pdu is a pointer to buffer with request PDU, response PDU is written here
+	 * \param [in,out] pduSize is a pointer to size of request PDU, size of response PDU is written here
+	 *
+	 * \return value returned by selected function handler, MB_EX_ILLEGAL_FUNCTION if there is no handler for function
+	 * code of request
+	 */
+
+	eMBException dispatch(xMBInstance* const instance, uint8_t* const pdu, uint16_t* const pduSize) const
+	{
+		const auto functionCode = pdu[0];
+		if (functionCode >= size)
+			return MB_EX_ILLEGAL_FUNCTION;
+
+		const auto handler = handlers[functionCode];
+		if (handler == nullptr)
+			return MB_EX_ILLEGAL_FUNCTION;
+
+		return handler(instance, pdu, pduSize);
+	}
+
+	/// array with pointers to function handlers, nullptr for unsupported function codes
+	std::array<FunctionHandler*, size> handlers;
+};
+
+/**
+ * FunctionHandlerEntry is a single entry of FunctionHandlerTable given to makeFunctionHandlerTable()
+ *
+ * \tparam FunctionCode is the function code
+ * \tparam Handler is a reference to function handler for \a FunctionCode
+ */
+
+template<uint8_t FunctionCode, FunctionHandler& Handler>
+struct FunctionHandlerEntry
+{
+	static_assert(FunctionCode != MB_FUNC_NONE && FunctionCode < FunctionHandlerTable::size, "Invalid function code!");
+
+	/// function code
+	constexpr static uint8_t functionCode {FunctionCode};
+
+	/**
+	 * \return pointer to function handler
+	 */
+
+	constexpr static FunctionHandler* getHandler()
+	{
+		return &Handler;
+	}
+};
+
+namespace internal
+{
+
+/**
+ * \brief Finds function handler for function code.
+ *
+ * Terminating case - there are no more entries.
+ *
+ * \tparam functionCode is the function code
+ *
+ * \return nullptr
+ */
+
+template<size_t functionCode>
+constexpr FunctionHandler* findFunctionHandler()
+{
+	return nullptr;
+}
+
+/**
+ * \brief Finds function handler for function code.
+ *
+ * \tparam functionCode is the function code
+ * \tparam Entry is the first entry which will be checked
+ * \tparam Entries are the remaining entries
+ *
+ * \return pointer to function handler from first entry matching \a functionCode, nullptr if there is none
+ */
+
+template<size_t functionCode, typename Entry, typename... Entries>
+constexpr FunctionHandler* findFunctionHandler()
+{
+	return Entry::functionCode == functionCode ? Entry::getHandler() : findFunctionHandler<functionCode, Entries...>();
+}
+
+/**
+ * \brief Checks whether function code of each entry is used only once.
+ *
+ * Terminating case - there are no more entries.
+ *
+ * \return true
+ */
+
+template<typename... Entries>
+constexpr typename std::enable_if<sizeof...(Entries) == 0, bool>::type areFunctionCodesUnique()
+{
+	return true;
+}
+
+/**
+ * \brief Checks whether function code of each entry is used only once.
+ *
+ * \tparam Entry is the first entry which will be checked
+ * \tparam Entries are the remaining entries
+ *
+ * \return true if function code of each entry is used only once, false otherwise
+ */
+
+template<typename Entry, typename... Entries>
+constexpr bool areFunctionCodesUnique()
+{
+	return findFunctionHandler<Entry::functionCode, Entries...>() == nullptr && areFunctionCodesUnique<Entries...>();
+}
+
+/**
+ * \brief Generates FunctionHandlerTable.
+ *
+ * \tparam Entries are the entries of generated table
+ * \tparam Indexes is a sequence of all indexes of generated table
+ *
+ * \return FunctionHandlerTable with handlers from \a Entries
+ */
+
+template<typename... Entries, size_t... Indexes>
+constexpr FunctionHandlerTable makeFunctionHandlerTable(estd::IndexSequence<Indexes...>)
+{
+	return FunctionHandlerTable{{{findFunctionHandler<Indexes, Entries...>()...}}};
+}
+
+}	// namespace internal
+
+/**
+ * \brief Generates FunctionHandlerTable at compile time.
+ *
+ * Example:
+ *
+ *     constexpr FunctionHandlerTable functionHandlerTable {makeFunctionHandlerTable<
+ *             FunctionHandlerEntry<MB_FUNC_READ_HOLDING_REGISTER, readHoldingRegisters>,
+ *             FunctionHandlerEntry<MB_FUNC_WRITE_MULTIPLE_REGISTERS, writeMultipleRegisters>>()};
+ *
+ * \tparam Entries are FunctionHandlerEntry types with entries of generated table
+ *
+ * \return FunctionHandlerTable with handlers from \a Entries
+ */
+
+template<typename... Entries>
+constexpr FunctionHandlerTable makeFunctionHandlerTable()
+{
+	static_assert(internal::areFunctionCodesUnique<Entries...>() == true, "Function codes must be unique!");
+
+	return internal::makeFunctionHandlerTable<Entries...>(estd::MakeIndexSequence<FunctionHandlerTable::size>{});
+}
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_FUNCTIONHANDLERTABLE_HPP_
@@ -0,0 +1,185 @@
+/**
+ * \file
+ * \brief HotRangeCache class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_HOTRANGECACHE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_HOTRANGECACHE_HPP_
+
+#include "distortos/Mutex.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+/**
+ * HotRangeCache keeps ready-to-send responses to reads of registered ranges of holding or input registers.
+ *
+ * Each entry holds complete Modbus RTU response frame, including CRC. When registers change, update() patches the
+ * frames in place and updates their CRC incrementally, so a matching request is answered with memcmp() of the request
+ * and one copy of the response, without calling register callbacks and without calculating CRC of the whole frame.
+ * Modbus TCP responses use the same frames without address and CRC fields.
+ *
+ * Values of registers in the cache must be kept up to date - either by RegisterStore to which the cache is attached
+ * (RegisterStore::setHotRangeCache()) or by calling update() for all changes.
+ */
+
+class HotRangeCache
+{
+public:
+
+	/// size of Modbus RTU request frame of register read
+	constexpr static size_t requestFrameSize {8};
+
+	/// Entry is a single registered range of registers
+	struct Entry
+	{
+		/**
+		 * \brief Entry's constructor
+		 *
+		 * \param [in] unitIdd is the unit identifier (slave address) of requests which are answered
+		 * \param [in] functionCodee is the function code of requests which are answered, MB_FUNC_READ_HOLDING_REGISTER
+		 * or MB_FUNC_READ_INPUT_REGISTER
+		 * \param [in] addresss is the address of first register, 0-based
+		 * \param [in] countt is the number of registers, [1; 125]
+		 * \param [in] framee is a pointer to storage for response frame, at least getFrameSize(countt) bytes
+		 */
+
+		constexpr Entry(const uint8_t unitIdd, const uint8_t functionCodee, const uint16_t addresss,
+				const uint16_t countt, uint8_t* const framee) :
+						frame{framee},
+						address{addresss},
+						count{countt},
+						functionCode{functionCodee},
+						unitId{unitIdd},
+						request{}
+		{
+
+		}
+
+		/**
+		 * \param [in] count is the number of registers
+		 *
+		 * \return size of Modbus RTU response frame with \a count registers, bytes
+		 */
+
+		constexpr static size_t getFrameSize(const uint16_t count)
+		{
+			return 5 + count * 2;
+		}
+
+		/// pointer to Modbus RTU response frame
+		uint8_t* frame;
+
+		/// address of first register, 0-based
+		uint16_t address;
+
+		/// number of registers
+		uint16_t count;
+
+		/// function code of requests which are answered
+		uint8_t functionCode;
+
+		/// unit identifier (slave address) of requests which are answered
+		uint8_t unitId;
+
+		/// Modbus RTU request frame which is answered, valid after HotRangeCache::initialize()
+		uint8_t request[requestFrameSize];
+	};
+
+	/// type alias for range of entries
+	using EntriesRange = estd::ContiguousRange<Entry>;
+
+	/**
+	 * \brief HotRangeCache's constructor
+	 *
+	 * \param [in] entriesRange is a range of registered entries
+	 */
+
+	constexpr explicit HotRangeCache(const EntriesRange entriesRange) :
+			mutex_{distortos::Mutex::Type::normal, distortos::Mutex::Protocol::priorityInheritance},
+			entriesRange_{entriesRange},
+			hits_{},
+			initialized_{}
+	{
+
+	}
+
+	/**
+	 * \brief Answers Modbus TCP request if it matches one of the entries.
+	 *
+	 * \param [in] unitId is the unit identifier of the request
+	 * \param [in,out] pdu is a pointer to buffer with request PDU, response PDU is written here
+	 * \param [in,out] pduSize is a reference to size of request PDU, bytes, size of response PDU is written here
+	 * \param [in] bufferSize is the size of \a pdu buffer, bytes
+	 *
+	 * \return true if the request was answered, false otherwise
+	 */
+
+	bool answerPdu(uint8_t unitId, uint8_t* pdu, size_t& pduSize, size_t bufferSize);
+
+	/**
+	 * \brief Answers Modbus RTU request if it matches one of the entries.
+	 *
+	 * \param [in,out] frame is a pointer to buffer with request frame, response frame is written here
+	 * \param [in,out] frameSize is a reference to size of request frame, bytes, size of response frame is written
+	 * here
+	 * \param [in] bufferSize is the size of \a frame buffer, bytes
+	 *
+	 * \return true if the request was answered, false otherwise
+	 */
+
+	bool answerRtuFrame(uint8_t* frame, size_t& frameSize, size_t bufferSize);
+
+	/**
+	 * \return number of requests answered from the cache
+	 */
+
+	uint32_t getHits() const
+	{
+		return hits_;
+	}
+
+	/**
+	 * \brief Builds requests and response frames of all entries, with all registers equal to zero.
+	 *
+	 * Must be called before the cache is used by any instance, RegisterStore::setHotRangeCache() does that when the
+	 * cache is attached.
+	 */
+
+	void initialize();
+
+	/**
+	 * \brief Updates values of registers in all entries which overlap with the range.
+	 *
+	 * Only changed bytes are patched and CRC of each frame is updated incrementally.
+	 *
+	 * \param [in] functionCode selects registers - MB_FUNC_READ_HOLDING_REGISTER for holding registers or
+	 * MB_FUNC_READ_INPUT_REGISTER for input registers
+	 * \param [in] address is the address of first register, 0-based
+	 * \param [in] values is a pointer to buffer with values of registers, big-endian
+	 * \param [in] count is the number of registers
+	 */
+
+	void update(uint8_t functionCode, uint16_t address, const uint8_t* values, uint16_t count);
+
+private:
+
+	/// mutex used for serialization of access to entries
+	distortos::Mutex mutex_;
+
+	/// range of registered entries
+	EntriesRange entriesRange_;
+
+	/// number of requests answered from the cache
+	uint32_t hits_;
+
+	/// true if initialize() was called, false otherwise
+	bool initialized_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_HOTRANGECACHE_HPP_
@@ -2,7 +2,7 @@
  * \file
  * \brief ListenSocket class header
  *
- * \author Copyright (C) 2019 Aleksander Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2019-2026 Aleksander Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -16,25 +16,112 @@
 
 #if MB_TCP_ENABLED == 1
 
+#include <array>
+
 #include <cstddef>
 #include <cstdint>
 
-/// ListenSocket represents a listen socket for Modbus TCP
+/**
+ * ListenSocket represents a listen socket for Modbus TCP
+ *
+ * Listen socket may be bound to any local address or to specific local address (e.g. of dedicated fieldbus interface),
+ * using IPv4, IPv6 or both. Listen sockets with fixed port share the accept path - FreeMODBUS instance is bound to all
+ * listen sockets from its range which have the requested fixed port, so it accepts clients from any of them. This way
+ * several interfaces may be served by one group of instances, while critical interface may get dedicated instances by
+ * placing its listen socket in a separate range.
+ */
+
 class ListenSocket
 {
 public:
 
+	/// Family selects address family of listen socket
+	enum class Family : uint8_t
+	{
+		/// IPv4 only
+		ipv4,
+		/// IPv6 only
+		ipv6,
+		/// IPv6 and IPv4 (dual-stack), requires any local address
+		dualStack,
+	};
+
+	/// LocalAddress is the local address to which listen socket is bound
+	struct LocalAddress
+	{
+		/// bytes of address in network byte order (only first 4 are used for IPv4), all zeros - any address
+		std::array<uint8_t, 16> bytes;
+
+		/// address family
+		Family family;
+	};
+
+	/**
+	 * \brief Creates local IPv4 address.
+	 *
+	 * \param [in] address is the IPv4 address, host byte order, 0 - any address
+	 *
+	 * \return local IPv4 address
+	 */
+
+	constexpr static LocalAddress ipv4Address(const uint32_t address)
+	{
+		return LocalAddress{{{static_cast<uint8_t>(address >> 24), static_cast<uint8_t>(address >> 16),
+				static_cast<uint8_t>(address >> 8), static_cast<uint8_t>(address)}}, Family::ipv4};
+	}
+
+	/**
+	 * \brief Creates local IPv6 address.
+	 *
+	 * \param [in] address is the IPv6 address, network byte order, all zeros - any address
+	 *
+	 * \return local IPv6 address
+	 */
+
+	constexpr static LocalAddress ipv6Address(const std::array<uint8_t, 16>& address)
+	{
+		return LocalAddress{address, Family::ipv6};
+	}
+
+	/**
+	 * \return any local address, both IPv6 and IPv4 (dual-stack)
+	 */
+
+	constexpr static LocalAddress dualStackAddress()
+	{
+		return LocalAddress{{}, Family::dualStack};
+	}
+
 	/**
 	 * \brief ListenSocket's constructor
 	 *
+	 * Listen socket is bound to any local IPv4 address, its port is selected by first bound FreeMODBUS instance.
+	 *
 	 * \param [in] backlogSize is the size of listen socket's backlog
 	 */
 
 	constexpr explicit ListenSocket(const int backlogSize) :
+			ListenSocket{backlogSize, ipv4Address({})}
+	{
+
+	}
+
+	/**
+	 * \brief ListenSocket's constructor
+	 *
+	 * \param [in] backlogSize is the size of listen socket's backlog
+	 * \param [in] localAddress is the local address to which listen socket is bound
+	 * \param [in] fixedPort is the fixed port of listen socket, 0 if port is selected by first bound FreeMODBUS
+	 * instance, default - 0
+	 */
+
+	constexpr ListenSocket(const int backlogSize, const LocalAddress& localAddress, const uint16_t fixedPort = {}) :
+			localAddress_{localAddress},
 			backlogSize_{backlogSize},
 			bindCounter_{},
 			clientCounter_{},
 			socket_{-1},
+			fixedPort_{fixedPort},
 			port_{}
 	{
 
@@ -46,7 +133,7 @@ public:
 	 * \param [in] port is a port for Modbus TCP to open
 	 *
 	 * \return 0 on success, error code otherwise:
-	 * - EBUSY - tried to bind already opened socket with wrong port number;
+	 * - EBUSY - tried to bind already opened socket or socket with fixed port with wrong port number;
 	 * - error codes returned by openSocket();
 	 */
 
@@ -72,6 +159,15 @@ public:
 
 	int clientDisconnected();
 
+	/**
+	 * \return fixed port of listen socket, 0 if port is selected by first bound FreeMODBUS instance
+	 */
+
+	uint16_t getFixedPort() const
+	{
+		return fixedPort_;
+	}
+
 	/**
 	 * \return current port of listen socket for Modbus TCP
 	 */
@@ -107,11 +203,15 @@ private:
 	 * \param [in] port is a port for Modbus TCP to open
 	 *
 	 * \return 0 on success, error code otherwise:
+	 * - EAFNOSUPPORT - IPv6 was requested, but it is not enabled in lwIP;
 	 * - error codes returned by lwIP library;
 	 */
 
 	int openSocket(uint16_t port);
 
+	/// local address to which listen socket is bound
+	LocalAddress localAddress_;
+
 	/// size of listen socket's backlog
 	int backlogSize_;
 
@@ -124,6 +224,9 @@ private:
 	/// listen socket for Modbus TCP, -1 if no listen socket is created
 	int socket_;
 
+	/// fixed port of listen socket, 0 if port is selected by first bound FreeMODBUS instance
+	uint16_t fixedPort_;
+
 	/// current port of listen socket for Modbus TCP
 	uint16_t port_;
 };
@@ -0,0 +1,189 @@
+/**
+ * \file
+ * \brief LocalRing class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_LOCALRING_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_LOCALRING_HPP_
+
+#include "FreemodbusTcpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+#include "distortos/Semaphore.hpp"
+
+/**
+ * LocalRing is a ring of request/response slots which connects one co-located client (application thread, e.g. HMI)
+ * with FreemodbusLocalInstance, bypassing the network stack.
+ *
+ * The client writes complete Modbus TCP frame (with MBAP header) directly into the slot and submits it, the instance is
+ * woken with a semaphore, handles the frame in place - the slot is its frame buffer - and writes the response into the
+ * same slot, then wakes the client. Frames are never copied and there is no connection, listen socket or keepalive.
+ * Requests may be pipelined up to the number of slots, responses are returned in the order of requests.
+ *
+ * Client functions (getRequestFrame(), submit(), waitResponse() and releaseResponse()) must be called only by one
+ * client thread, other functions are used by the port.
+ *
+ * \code
+ * auto frame = localRing.getRequestFrame();
+ * // write request to frame
+ * localRing.submit(size);
+ * const uint8_t* response;
+ * size_t responseSize;
+ * if (localRing.waitResponse(deadline, response, responseSize) == 0)
+ * {
+ *         // use response
+ *         localRing.releaseResponse();
+ * }
+ * \endcode
+ */
+
+class LocalRing
+{
+public:
+
+	/// Slot is a single slot of the ring
+	struct Slot
+	{
+		/**
+		 * \brief Slot's constructor
+		 */
+
+		constexpr Slot() :
+				frame{},
+				size{}
+		{
+
+		}
+
+		/// buffer for request frame, response frame is written here
+		uint8_t frame[FreemodbusTcpInstance::tcpBufferSize];
+
+		/// size of frame stored in the slot, bytes
+		size_t size;
+	};
+
+	/// type alias for range of slots
+	using SlotsRange = estd::ContiguousRange<Slot>;
+
+	/**
+	 * \brief LocalRing's constructor
+	 *
+	 * \param [in] slotsRangee is a range of slots, its size is the max number of pipelined requests
+	 */
+
+	constexpr explicit LocalRing(const SlotsRange slotsRangee) :
+			slotsRange_{slotsRangee},
+			requestSemaphore_{0},
+			responseSemaphore_{0},
+			handledPosition_{},
+			readPosition_{},
+			writePosition_{}
+	{
+
+	}
+
+	/**
+	 * \brief Completes request which is currently handled.
+	 *
+	 * Must be called only by the port.
+	 *
+	 * \param [in] size is the size of response frame stored in the slot, bytes, 0 if the request was dropped
+	 */
+
+	void complete(size_t size);
+
+	/**
+	 * Must be called only by the port, after successful waitRequest().
+	 *
+	 * \return reference to slot with request which is currently handled
+	 */
+
+	Slot& getRequest() const
+	{
+		return slotsRange_[handledPosition_ % slotsRange_.size()];
+	}
+
+	/**
+	 * \return pointer to buffer for next request frame, FreemodbusTcpInstance::tcpBufferSize bytes, nullptr if all
+	 * slots are taken
+	 */
+
+	uint8_t* getRequestFrame() const;
+
+	/**
+	 * \brief Releases the slot of the oldest response, obtained with waitResponse().
+	 */
+
+	void releaseResponse();
+
+	/**
+	 * \brief Submits request frame written to the buffer from getRequestFrame().
+	 *
+	 * \param [in] size is the size of request frame, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EINVAL - \a size is not the size of complete Modbus TCP frame given in its MBAP header;
+	 * - ENOBUFS - all slots are taken;
+	 */
+
+	int submit(size_t size);
+
+	/**
+	 * \brief Waits for request submitted by the client.
+	 *
+	 * Must be called only by the port.
+	 *
+	 * \param [in] deadline is the deadline of waiting
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by distortos::Semaphore::tryWaitUntil();
+	 */
+
+	int waitRequest(distortos::TickClock::time_point deadline);
+
+	/**
+	 * \brief Waits for response to the oldest submitted request.
+	 *
+	 * Slot of the response must be released with releaseResponse() after the response is used.
+	 *
+	 * \param [in] deadline is the deadline of waiting
+	 * \param [out] frame is a reference to variable for pointer to response frame
+	 * \param [out] size is a reference to variable for size of response frame, bytes, 0 if the request was dropped
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by distortos::Semaphore::tryWaitUntil();
+	 */
+
+	int waitResponse(distortos::TickClock::time_point deadline, const uint8_t*& frame, size_t& size);
+
+private:
+
+	/// range of slots
+	SlotsRange slotsRange_;
+
+	/// semaphore used to wake the port, its value is the number of submitted requests which were not taken yet
+	distortos::Semaphore requestSemaphore_;
+
+	/// semaphore used to wake the client, its value is the number of completed requests which were not taken yet
+	distortos::Semaphore responseSemaphore_;
+
+	/// number of requests completed so far, used only by the port
+	size_t handledPosition_;
+
+	/// number of responses released so far, used only by the client
+	size_t readPosition_;
+
+	/// number of requests submitted so far, used only by the client
+	size_t writePosition_;
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_LOCALRING_HPP_
@@ -0,0 +1,216 @@
+/**
+ * \file
+ * \brief MbedtlsTransport class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_MBEDTLSTRANSPORT_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_MBEDTLSTRANSPORT_HPP_
+
+#include "TcpTransport.hpp"
+
+#if MB_TCP_ENABLED == 1 && MB_TCP_TLS_ENABLED == 1
+
+#include "distortos/TickClock.hpp"
+
+#include "mbedtls/ssl.h"
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+#include "mbedtls/ssl_cache.h"
+#endif	// defined(MBEDTLS_SSL_CACHE_C)
+
+/**
+ * MbedtlsTransport is a Modbus/TCP Security (TLS) transport implemented with mbedTLS.
+ *
+ * Configuration of mbedTLS (certificates, keys, RNG, ciphersuites) is prepared by the application and shared by all
+ * transports. Decrypted records are copied by mbedTLS from its input buffer straight into the frame buffer of the
+ * instance, without intermediate buffers of the integration.
+ *
+ * The client socket is switched to non-blocking mode. Handshake is continued and records are read only when the poll
+ * loop of the instance finds the socket readable, so client which sends partial record or stalls during handshake does
+ * not block the thread. Handshake which does not complete before its deadline closes the connection. Sending waits
+ * until the whole response is written to the socket, just like Modbus TCP instance without transport, but at most for
+ * the send timeout - client which stops reading fails the send and the connection is closed.
+ */
+
+class MbedtlsTransport : public TcpTransport
+{
+public:
+
+	/**
+	 * \brief MbedtlsTransport's constructor
+	 *
+	 * \param [in] configuration is a reference to configuration of mbedTLS server, shared by all transports
+	 * \param [in] handshakeTimeout is the max duration of the whole handshake, counted from accept()
+	 * \param [in] sendTimeout is the max duration of sending of one response, counted from the call to send()
+	 */
+
+	MbedtlsTransport(const mbedtls_ssl_config& configuration, distortos::TickClock::duration handshakeTimeout,
+			distortos::TickClock::duration sendTimeout);
+
+	/**
+	 * \brief MbedtlsTransport's destructor
+	 */
+
+	~MbedtlsTransport() override;
+
+	/**
+	 * \brief Starts TLS session on newly accepted client socket.
+	 *
+	 * The socket is switched to non-blocking mode and the handshake is started, it is continued by receive().
+	 *
+	 * \param [in] socket is the accepted client socket
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ECONNABORTED - handshake failed;
+	 * - ENOMEM - mbedTLS context could not be set up;
+	 * - error codes returned by lwip_fcntl();
+	 */
+
+	int accept(int socket) override;
+
+	/**
+	 * \brief Sends close notification and resets TLS session.
+	 *
+	 * \param [in] socket is the client socket
+	 */
+
+	void close(int socket) override;
+
+	/**
+	 * \return deadline of handshake in progress, distortos::TickClock::time_point::max() if handshake is complete
+	 */
+
+	distortos::TickClock::time_point getDeadline() const override
+	{
+		return handshakeDeadline_;
+	}
+
+	/**
+	 * \return true if mbedTLS has decrypted data which was not read yet, false otherwise
+	 */
+
+	bool hasBufferedData() const override;
+
+	/**
+	 * \brief Continues handshake in progress, then receives and decrypts data.
+	 *
+	 * \param [in] socket is the client socket
+	 * \param [out] buffer is a pointer to buffer for received data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return number of received bytes, 0 if connection was closed, negative value on error - errno is EAGAIN if no
+	 * complete record was received yet, ETIMEDOUT if handshake did not complete before its deadline, ECONNABORTED if
+	 * handshake failed or mbedTLS reported any other error (e.g. invalid MAC of record or fatal alert of the client)
+	 */
+
+	ssize_t receive(int socket, void* buffer, size_t size) override;
+
+	/**
+	 * \brief Encrypts and sends data.
+	 *
+	 * \param [in] socket is the client socket
+	 * \param [in] iov is a pointer to array with buffers which will be sent in order
+	 * \param [in] iovCount is the number of elements in \a iov array
+	 *
+	 * \return number of sent bytes, negative value on error - errno is ETIMEDOUT if the data could not be written
+	 * before the send timeout, ECONNABORTED if mbedTLS reported an error
+	 */
+
+	ssize_t send(int socket, const iovec* iov, int iovCount) override;
+
+#if defined(MBEDTLS_SSL_CACHE_C)
+
+	/**
+	 * \brief Enables session resumption with server-side session cache.
+	 *
+	 * Clients which reconnect with cached session skip full handshake. Must be called once for the shared
+	 * configuration, before any transport is used.
+	 *
+	 * \param [in] configuration is a reference to configuration of mbedTLS server
+	 * \param [in] cache is a reference to initialized session cache
+	 */
+
+	static void enableSessionCache(mbedtls_ssl_config& configuration, mbedtls_ssl_cache_context& cache);
+
+#endif	// defined(MBEDTLS_SSL_CACHE_C)
+
+private:
+
+	/**
+	 * \brief Continues handshake in progress.
+	 *
+	 * \return 0 if handshake is complete, error code otherwise:
+	 * - EAGAIN - handshake needs more data from client;
+	 * - ECONNABORTED - handshake failed;
+	 * - ETIMEDOUT - handshake did not complete before its deadline;
+	 */
+
+	int handshake();
+
+	/**
+	 * \brief Receives data from the socket - receive callback of mbedTLS.
+	 *
+	 * \param [in] context is a pointer to MbedtlsTransport
+	 * \param [out] buffer is a pointer to buffer for received data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return number of received bytes, 0 if connection was closed, error code of mbedTLS otherwise
+	 */
+
+	static int receiveCallback(void* context, unsigned char* buffer, size_t size);
+
+	/**
+	 * \brief Sends data to the socket - send callback of mbedTLS.
+	 *
+	 * \param [in] context is a pointer to MbedtlsTransport
+	 * \param [in] buffer is a pointer to data which will be sent
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return number of sent bytes, error code of mbedTLS otherwise
+	 */
+
+	static int sendCallback(void* context, const unsigned char* buffer, size_t size);
+
+	/**
+	 * \brief Waits until the socket is ready for operation requested by mbedTLS.
+	 *
+	 * \param [in] want is the error code of mbedTLS, MBEDTLS_ERR_SSL_WANT_READ or MBEDTLS_ERR_SSL_WANT_WRITE
+	 * \param [in] deadline is the deadline of waiting
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ETIMEDOUT - the socket was not ready before \a deadline;
+	 */
+
+	int waitSocket(int want, distortos::TickClock::time_point deadline) const;
+
+	/// context of TLS session
+	mbedtls_ssl_context context_;
+
+	/// reference to configuration of mbedTLS server
+	const mbedtls_ssl_config& configuration_;
+
+	/// deadline of handshake in progress, distortos::TickClock::time_point::max() if handshake is complete
+	distortos::TickClock::time_point handshakeDeadline_;
+
+	/// max duration of the whole handshake
+	distortos::TickClock::duration handshakeTimeout_;
+
+	/// max duration of sending of one response
+	distortos::TickClock::duration sendTimeout_;
+
+	/// client socket, -1 if there is none
+	int socket_;
+
+	/// true if context_ was set up with configuration_, false otherwise
+	bool setUp_;
+};
+
+#endif	// MB_TCP_ENABLED == 1 && MB_TCP_TLS_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_MBEDTLSTRANSPORT_HPP_
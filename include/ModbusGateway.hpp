@@ -0,0 +1,340 @@
+/**
+ * \file
+ * \brief ModbusGateway class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_MODBUSGATEWAY_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_MODBUSGATEWAY_HPP_
+
+#include "mbinstance.h"
+
+#if MB_TCP_ENABLED == 1
+
+#include "distortos/ConditionVariable.hpp"
+#include "distortos/devices/communication/UartParity.hpp"
+#include "distortos/Mutex.hpp"
+#include "distortos/TickClock.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+namespace distortos
+{
+
+namespace devices
+{
+
+class SerialPort;
+
+}	// namespace devices
+
+}	// namespace distortos
+
+/**
+ * ModbusGateway forwards Modbus requests received by Modbus TCP instances of FreeMODBUS to Modbus RTU or ASCII slaves
+ * on one serial bus.
+ *
+ * Requests from all instances bound to the gateway are queued and executed one at a time, in the order of arrival.
+ * Responses are matched by unit identifier - frames from other slaves which appear on the bus are ignored. Responses to
+ * read requests (function codes 1-4) are stored in a short-lived cache, so identical reads which arrive while the cache
+ * entry is still valid are answered without touching the serial bus.
+ *
+ * Register reads (function codes 3 and 4) of one slave with overlapping or adjacent ranges which wait in the queue at
+ * the same time are coalesced into one wider read, the response of which is then split into individual responses.
+ *
+ * Modbus ASCII frames are encoded and decoded in bulk with table-driven codec, in chunks and in place, so ASCII mode
+ * needs no buffers larger than the ones used for Modbus RTU.
+ */
+
+class ModbusGateway
+{
+public:
+
+	/// size of request PDU of all read functions which can be cached
+	constexpr static size_t cachedRequestSize {5};
+
+	/// max number of registers read by coalesced request
+	constexpr static uint16_t maxCoalescedRegisters {125};
+
+	/// max size of PDU
+	constexpr static size_t maxPduSize {MB_SER_SIZE_MAX - 3};
+
+	/// Mode selects transmission mode of the bus
+	enum class Mode : uint8_t
+	{
+		/// Modbus RTU
+		rtu,
+		/// Modbus ASCII
+		ascii,
+	};
+
+	/// CacheEntry is a single entry of response cache
+	struct CacheEntry
+	{
+		/// time point at which the entry was stored
+		distortos::TickClock::time_point timestamp;
+
+		/// size of response PDU, 0 if entry is not valid
+		size_t responseSize;
+
+		/// unit identifier of the request
+		uint8_t unitId;
+
+		/// request PDU
+		uint8_t request[cachedRequestSize];
+
+		/// response PDU
+		uint8_t response[maxPduSize];
+	};
+
+	/// type alias for range of entries of response cache
+	using CacheRange = estd::ContiguousRange<CacheEntry>;
+
+	/**
+	 * \brief ModbusGateway's constructor
+	 *
+	 * \param [in] serialPort is a reference to serial port of the bus with Modbus RTU slaves
+	 * \param [in] cacheRange is a range of entries of response cache, empty range disables the cache
+	 * \param [in] cacheLifetime is the duration for which the entries of response cache are valid, zero disables the
+	 * cache
+	 * \param [in] responseTimeout is the max duration between sending the request and receiving the first byte of
+	 * response
+	 */
+
+	constexpr ModbusGateway(distortos::devices::SerialPort& serialPort, const CacheRange cacheRange,
+			const distortos::TickClock::duration cacheLifetime, const distortos::TickClock::duration responseTimeout) :
+					conditionVariable_{},
+					mutex_{distortos::Mutex::Type::normal, distortos::Mutex::Protocol::priorityInheritance},
+					cacheRange_{cacheRange},
+					cacheLifetime_{cacheLifetime},
+					frameDelay_{},
+					lastActivity_{},
+					responseTimeout_{responseTimeout},
+					queueHead_{},
+					queueTail_{},
+					serialPort_{serialPort},
+					coalescedPdu_{},
+					frameBuffer_{},
+					mode_{},
+					busy_{},
+					opened_{}
+	{
+
+	}
+
+	/**
+	 * \brief Closes serial port of the bus.
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the gateway is not opened;
+	 * - error codes returned by distortos::devices::SerialPort::close();
+	 */
+
+	int close();
+
+	/**
+	 * \brief Opens serial port of the bus.
+	 *
+	 * \param [in] baudRate is the desired baud rate, bps
+	 * \param [in] characterLength selects character length, bits
+	 * \param [in] parity selects parity
+	 * \param [in] mode selects transmission mode of the bus, default - Mode::rtu
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EBADF - the gateway is already opened;
+	 * - error codes returned by distortos::devices::SerialPort::open();
+	 */
+
+	int open(uint32_t baudRate, uint8_t characterLength, distortos::devices::UartParity parity, Mode mode = Mode::rtu);
+
+	/**
+	 * \brief Executes a Modbus transaction with RTU slave.
+	 *
+	 * Blocks until the response is available. The response replaces the request in \a pdu. If the slave does not
+	 * respond correctly, exception response "gateway target device failed to respond" is generated. If the gateway is
+	 * not opened, exception response "gateway path unavailable" is generated.
+	 *
+	 * \param [in] unitId is the unit identifier of RTU slave, 0 for broadcast
+	 * \param [in,out] pdu is a pointer to buffer with request PDU, response PDU is written here
+	 * \param [in] pduSize is the size of request PDU, bytes, [1; maxPduSize]
+	 * \param [in] bufferSize is the size of \a pdu buffer, bytes, at least 2, should be at least maxPduSize - response
+	 * which does not fit is replaced with exception response
+	 *
+	 * \return size of response PDU written to \a pdu, bytes, 0 if no response should be sent
+	 */
+
+	size_t transact(uint8_t unitId, uint8_t* pdu, size_t pduSize, size_t bufferSize);
+
+private:
+
+	/// Request is a single request waiting in the queue
+	struct Request
+	{
+		/// pointer to next request in the queue, nullptr if this is the last one
+		Request* next;
+
+		/// pointer to buffer with request PDU, response PDU is written here
+		uint8_t* pdu;
+
+		/// copy of initial bytes of request PDU, valid also after response is written to \a pdu
+		uint8_t header[cachedRequestSize];
+
+		/// size of \a pdu buffer, bytes
+		size_t bufferSize;
+
+		/// size of request PDU, bytes
+		size_t requestSize;
+
+		/// size of response PDU, bytes
+		size_t responseSize;
+
+		/// unit identifier of RTU slave
+		uint8_t unitId;
+
+		/// true if response is ready, false otherwise
+		bool done;
+	};
+
+	/**
+	 * \brief Moves requests which can be coalesced with the executed one from the queue to its list.
+	 *
+	 * Requests which were coalesced are linked to \a request via Request::next.
+	 *
+	 * Must be called with mutex locked.
+	 *
+	 * \param [in,out] request is a reference to request which is about to be executed, must not be in the queue
+	 *
+	 * \return true if at least one request was coalesced with \a request, false otherwise
+	 */
+
+	bool coalesce(Request& request);
+
+	/**
+	 * \brief Executes a Modbus transaction on the serial bus.
+	 *
+	 * Must be called with mutex unlocked and with busy_ flag set.
+	 *
+	 * \param [in,out] request is a reference to executed request
+	 */
+
+	void execute(Request& request);
+
+	/**
+	 * \brief Executes coalesced requests with one Modbus transaction on the serial bus.
+	 *
+	 * If the slave rejects the coalesced read, all requests are executed separately.
+	 *
+	 * Must be called with mutex unlocked and with busy_ flag set.
+	 *
+	 * \param [in,out] request is a reference to first of coalesced requests
+	 */
+
+	void executeCoalesced(Request& request);
+
+	/**
+	 * \brief Tries to find response to the request in the cache.
+	 *
+	 * Must be called with mutex locked.
+	 *
+	 * \param [in,out] request is a reference to request for which the response is searched
+	 *
+	 * \return true if response was found and copied to request, false otherwise
+	 */
+
+	bool findInCache(Request& request) const;
+
+	/**
+	 * \brief Receives Modbus ASCII frame and decodes it into frameBuffer_.
+	 *
+	 * Frames with invalid characters or wrong LRC are dropped. If frame is not completed within the inter-character
+	 * timeout, it is dropped too.
+	 *
+	 * Must be called with mutex unlocked and with busy_ flag set.
+	 *
+	 * \param [in] responseDeadline is the deadline of receiving start of the frame
+	 *
+	 * \return size of decoded frame (address and PDU, without LRC) in frameBuffer_, bytes, 0 if no valid frame was
+	 * received before \a responseDeadline
+	 */
+
+	size_t readAsciiFrame(distortos::TickClock::time_point responseDeadline);
+
+	/**
+	 * \brief Updates the cache with the response to executed request.
+	 *
+	 * Responses to read requests are stored, all other requests invalidate cached responses of their unit.
+	 *
+	 * Must be called with mutex locked.
+	 *
+	 * \param [in] request is a reference to executed request
+	 */
+
+	void updateCache(const Request& request);
+
+	/**
+	 * \brief Encodes frame from frameBuffer_ as Modbus ASCII frame and sends it.
+	 *
+	 * Must be called with mutex unlocked and with busy_ flag set.
+	 *
+	 * \param [in] frameSize is the size of frame (address and PDU) in frameBuffer_, bytes
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by distortos::devices::SerialPort::write();
+	 */
+
+	int writeAsciiFrame(size_t frameSize);
+
+	/// condition variable used to notify waiting requests about changes in the queue
+	distortos::ConditionVariable conditionVariable_;
+
+	/// mutex used for serialization of access to the queue and cache
+	distortos::Mutex mutex_;
+
+	/// range of entries of response cache
+	CacheRange cacheRange_;
+
+	/// duration for which the entries of response cache are valid
+	distortos::TickClock::duration cacheLifetime_;
+
+	/// minimal duration of silence between frames on the bus
+	distortos::TickClock::duration frameDelay_;
+
+	/// time point of last activity on the bus
+	distortos::TickClock::time_point lastActivity_;
+
+	/// max duration between sending the request and receiving the first byte of response
+	distortos::TickClock::duration responseTimeout_;
+
+	/// first request in the queue, nullptr if queue is empty
+	Request* queueHead_;
+
+	/// last request in the queue, nullptr if queue is empty
+	Request* queueTail_;
+
+	/// reference to serial port of the bus
+	distortos::devices::SerialPort& serialPort_;
+
+	/// buffer for PDU of coalesced request, used only by the request which is currently executed
+	uint8_t coalescedPdu_[maxPduSize];
+
+	/// buffer for RTU frames, used only by the request which is currently executed
+	uint8_t frameBuffer_[MB_SER_SIZE_MAX];
+
+	/// transmission mode of the bus
+	Mode mode_;
+
+	/// true if a request is currently executed on the bus, false otherwise
+	bool busy_;
+
+	/// true if the gateway is opened, false otherwise
+	bool opened_;
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_MODBUSGATEWAY_HPP_
@@ -0,0 +1,257 @@
+/**
+ * \file
+ * \brief ModbusTcpMaster class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_MODBUSTCPMASTER_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_MODBUSTCPMASTER_HPP_
+
+#include "FreemodbusTcpInstance.hpp"
+
+#if MB_TCP_ENABLED == 1
+
+/**
+ * ModbusTcpMaster is a single connection of Modbus TCP master (client) to Modbus TCP slave (server).
+ *
+ * Transactions are asynchronous - startTransaction() only queues the request and sends as much of it as the socket
+ * accepts without blocking, its completion is reported via callback from poll(). Socket stays in non-blocking mode, so
+ * part of the request which was not accepted by the socket is sent by poll() when the socket becomes writable. Up to
+ * the size of transactions range may be outstanding at the same time, responses are matched by transaction identifier.
+ * All connections of one thread are polled together, so any number of slaves may be polled without dedicated threads.
+ */
+
+class ModbusTcpMaster
+{
+public:
+
+	/**
+	 * \brief Type of function called when transaction is completed.
+	 *
+	 * \param [in] context is the context pointer passed to startTransaction()
+	 * \param [in] error is 0 on success, error code otherwise:
+	 * - ECONNABORTED - connection was closed with disconnect();
+	 * - ETIMEDOUT - response was not received before the deadline;
+	 * - error codes returned by lwIP library which caused the connection to be closed;
+	 * \param [in] pdu is a pointer to response PDU, valid only during the call, nullptr if \a error is not 0
+	 * \param [in] pduSize is the size of response PDU, bytes, 0 if \a error is not 0
+	 */
+
+	using Callback = void(void* context, int error, const uint8_t* pdu, size_t pduSize);
+
+	/// State contains possible states of connection
+	enum class State : uint8_t
+	{
+		/// not connected
+		disconnected,
+		/// connection is being established
+		connecting,
+		/// connected
+		connected,
+	};
+
+	/// Transaction is a single outstanding transaction
+	struct Transaction
+	{
+		/// deadline of response
+		distortos::TickClock::time_point deadline;
+
+		/// pointer to function called when transaction is completed, nullptr if this transaction slot is free
+		Callback* callback;
+
+		/// context pointer passed to \a callback
+		void* context;
+
+		/// transaction identifier
+		uint16_t transactionId;
+	};
+
+	/// type alias for range of transaction slots
+	using TransactionsRange = estd::ContiguousRange<Transaction>;
+
+	/// type alias for range of pointers to connections polled together
+	using Range = estd::ContiguousRange<ModbusTcpMaster* const>;
+
+	/**
+	 * \brief ModbusTcpMaster's constructor
+	 *
+	 * \param [in] transactionsRange is a range of transaction slots, its size is the max number of outstanding
+	 * transactions
+	 */
+
+	constexpr explicit ModbusTcpMaster(const TransactionsRange transactionsRange) :
+			transactionsRange_{transactionsRange},
+			connectDeadline_{},
+			bytesInBuffer_{},
+			bytesToSend_{},
+			socket_{-1},
+			nextTransactionId_{},
+			state_{State::disconnected},
+			frameBuffer_{},
+			txBuffer_{}
+	{
+
+	}
+
+	/**
+	 * \brief Starts establishing connection with Modbus TCP slave.
+	 *
+	 * The connection is established asynchronously by poll(), use getState() to check whether it succeeded.
+	 *
+	 * \param [in] address is the IPv4 address of Modbus TCP slave, host byte order
+	 * \param [in] port is the port of Modbus TCP slave
+	 * \param [in] timeout is the max duration of establishing the connection
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EISCONN - connection is already established or being established;
+	 * - error codes returned by lwIP library;
+	 */
+
+	int connect(uint32_t address, uint16_t port, distortos::TickClock::duration timeout);
+
+	/**
+	 * \brief Closes the connection.
+	 *
+	 * Outstanding transactions are completed with ECONNABORTED.
+	 */
+
+	void disconnect();
+
+	/**
+	 * \return earliest deadline of this connection (response timeouts, connection timeout),
+	 * distortos::TickClock::time_point::max() if there is none
+	 */
+
+	distortos::TickClock::time_point getDeadline() const;
+
+	/**
+	 * \return current state of connection
+	 */
+
+	State getState() const
+	{
+		return state_;
+	}
+
+	/**
+	 * \brief Starts a transaction.
+	 *
+	 * \param [in] unitId is the unit identifier
+	 * \param [in] pdu is a pointer to request PDU
+	 * \param [in] pduSize is the size of request PDU, bytes, [1; MB_SER_SIZE_MAX - 3]
+	 * \param [in] timeout is the max duration of waiting for response
+	 * \param [in] callback is a reference to function called when transaction is completed
+	 * \param [in] context is the context pointer passed to \a callback
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - EAGAIN - max number of outstanding transactions was reached or queue of unsent requests has no space for this
+	 * request;
+	 * - EINVAL - \a pduSize is invalid;
+	 * - ENOTCONN - connection is not established;
+	 * - error codes returned by lwIP library which caused the connection to be closed;
+	 */
+
+	int startTransaction(uint8_t unitId, const uint8_t* pdu, size_t pduSize, distortos::TickClock::duration timeout,
+			Callback& callback, void* context);
+
+	/**
+	 * \brief Polls connections.
+	 *
+	 * Waits for activity on any of the connections until \a deadline or until earliest deadline of connections, then
+	 * sends queued requests, handles received responses, established connections and expired deadlines. All callbacks
+	 * are called from this function.
+	 *
+	 * \param [in] range is a range of pointers to connections which will be polled
+	 * \param [in] deadline is the deadline of polling operation
+	 */
+
+	static void poll(Range range, distortos::TickClock::time_point deadline);
+
+private:
+
+	/**
+	 * \brief Closes the connection and completes outstanding transactions.
+	 *
+	 * \param [in] error is the error code with which outstanding transactions are completed
+	 */
+
+	void closeConnection(int error);
+
+	/**
+	 * \brief Completes all transactions whose deadline has expired with ETIMEDOUT.
+	 */
+
+	void handleDeadlines();
+
+	/**
+	 * \brief Finishes establishing the connection.
+	 */
+
+	void handleConnected();
+
+	/**
+	 * \brief Receives all available data from the connection and completes matching transactions.
+	 */
+
+	void handleReceive();
+
+	/**
+	 * \brief Completes transaction which matches complete response frame.
+	 *
+	 * \param [in] frameSize is the size of response frame in buffer, bytes
+	 */
+
+	void handleResponse(size_t frameSize);
+
+	/**
+	 * \brief Sends queued requests, closes the connection on error.
+	 */
+
+	void handleSend();
+
+	/**
+	 * \brief Sends queued requests until the socket accepts no more data without blocking.
+	 *
+	 * \return 0 on success (including the case when some bytes are left in the queue), error code otherwise:
+	 * - EIO - socket accepted no data;
+	 * - error codes returned by lwIP library;
+	 */
+
+	int sendQueued();
+
+	/// range of transaction slots
+	TransactionsRange transactionsRange_;
+
+	/// deadline of establishing the connection
+	distortos::TickClock::time_point connectDeadline_;
+
+	/// number of bytes stored in buffer
+	size_t bytesInBuffer_;
+
+	/// number of bytes stored in queue of unsent requests
+	size_t bytesToSend_;
+
+	/// socket of the connection, -1 if not connected
+	int socket_;
+
+	/// transaction identifier of next transaction
+	uint16_t nextTransactionId_;
+
+	/// current state of connection
+	State state_;
+
+	/// buffer for response frame
+	uint8_t frameBuffer_[FreemodbusTcpInstance::tcpBufferSize];
+
+	/// queue of unsent requests
+	uint8_t txBuffer_[FreemodbusTcpInstance::tcpBufferSize];
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_MODBUSTCPMASTER_HPP_
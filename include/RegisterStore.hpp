@@ -0,0 +1,786 @@
+/**
+ * \file
+ * \brief RegisterStore class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_REGISTERSTORE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_REGISTERSTORE_HPP_
+
+#include "HotRangeCache.hpp"
+#include "WriteNotificationQueue.hpp"
+
+#include "mbproto.h"
+
+#include "distortos/Mutex.hpp"
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+#include <cerrno>
+#include <cstring>
+
+/**
+ * RegisterStore is a register map of Modbus slave with coils, discrete inputs, input registers and holding registers.
+ *
+ * All tables are kept in two copies. Writers modify the inactive copy, publish it by incrementing the generation
+ * counter and then repeat the modification in the other copy. Readers copy data from the active copy and retry only
+ * if the generation counter changed during the copy, so they never wait for writers - even when a reader preempts a
+ * writer in the middle of modification. Writers are serialized with a mutex.
+ *
+ * Registers are stored in Modbus byte order and coils are stored packed, so reading a range of registers is a single
+ * memcpy() to the frame.
+ *
+ * All tables and the generation counter form an Image with fixed, versioned binary layout. The image is either a member
+ * of the store or - if ExternalImage is true - a region of memory provided by the application, for example a
+ * memory-mapped file, battery-backed SRAM or a section which is not initialized at startup. Writes land directly in the
+ * external image, without any extra copy, so after restart openImage() makes values from the previous run available
+ * immediately. A write interrupted by reset affects only one copy, the other one stays consistent and is used when the
+ * image is opened.
+ *
+ * Optional HotRangeCache attached with setHotRangeCache() is updated by all writes of registers, in the same order in
+ * which the writes are done. Optional WriteNotificationQueue attached with setWriteNotificationQueue() gets a
+ * notification about each write of coils and holding registers - when register callbacks of FreeMODBUS write through
+ * the store and the queue is also attached to the instance (FreemodbusExtensions::writeNotificationQueue), the
+ * application is notified about writes of masters without any code in the callbacks.
+ *
+ * All addresses are 0-based protocol addresses. Note that register callbacks of FreeMODBUS receive addresses
+ * incremented by one.
+ *
+ * \tparam CoilsCount is the number of coils
+ * \tparam DiscreteInputsCount is the number of discrete inputs
+ * \tparam InputRegistersCount is the number of input registers
+ * \tparam HoldingRegistersCount is the number of holding registers
+ * \tparam ExternalImage selects whether the image is provided by the application (true) or is a member of the store
+ * (false), default - false
+ */
+
+template<size_t CoilsCount, size_t DiscreteInputsCount, size_t InputRegistersCount, size_t HoldingRegistersCount,
+		bool ExternalImage = false>
+class RegisterStore
+{
+public:
+
+	/// alignment of each copy of tables, size of cache line of Cortex-M7
+	constexpr static size_t alignment {32};
+
+	/// magic value at the beginning of the image, "MBRS" in little-endian byte order
+	constexpr static uint32_t imageMagic {0x5352424d};
+
+	/// version of layout of the image, incremented on each incompatible change
+	constexpr static uint16_t imageVersion {1};
+
+	/// Copy is a single copy of all tables
+	struct alignas(alignment) Copy
+	{
+		/// packed values of coils
+		std::array<uint8_t, (CoilsCount + 7) / 8> coils;
+
+		/// packed values of discrete inputs
+		std::array<uint8_t, (DiscreteInputsCount + 7) / 8> discreteInputs;
+
+		/// values of holding registers, big-endian
+		std::array<uint8_t, HoldingRegistersCount * 2> holdingRegisters;
+
+		/// values of input registers, big-endian
+		std::array<uint8_t, InputRegistersCount * 2> inputRegisters;
+	};
+
+	/// ImageHeader describes layout of the image
+	struct ImageHeader
+	{
+		/// imageMagic
+		uint32_t magic;
+
+		/// imageVersion
+		uint16_t version;
+
+		/// size of ImageHeader, bytes
+		uint16_t headerSize;
+
+		/// number of coils
+		uint32_t coilsCount;
+
+		/// number of discrete inputs
+		uint32_t discreteInputsCount;
+
+		/// number of input registers
+		uint32_t inputRegistersCount;
+
+		/// number of holding registers
+		uint32_t holdingRegistersCount;
+
+		/// size of Image, bytes
+		uint32_t imageSize;
+	};
+
+	/// Image is the complete state of the store with fixed binary layout
+	struct Image
+	{
+		/// header of the image
+		ImageHeader header;
+
+		/// generation counter, the copy with index equal to its lowest bit is active
+		std::atomic<uint32_t> generation;
+
+		/// two copies of all tables
+		Copy copies[2];
+	};
+
+	static_assert(std::is_standard_layout<Image>::value == true, "Image must have fixed binary layout!");
+
+	/**
+	 * \brief RegisterStore's constructor
+	 *
+	 * All coils, discrete inputs and registers are initialized with zeroes.
+	 */
+
+	template<bool External = ExternalImage, typename std::enable_if<External == false, int>::type = 0>
+	constexpr RegisterStore() :
+			image_{getExpectedHeader(), {}, {}},
+			writeMutex_{distortos::Mutex::Type::normal, distortos::Mutex::Protocol::priorityInheritance},
+			hotRangeCache_{},
+			writeNotificationQueue_{}
+	{
+
+	}
+
+	/**
+	 * \brief RegisterStore's constructor
+	 *
+	 * The image must be opened with openImage() before the store is used.
+	 *
+	 * \param [in] image is a reference to image provided by the application, suitably aligned
+	 */
+
+	template<bool External = ExternalImage, typename std::enable_if<External == true, int>::type = 0>
+	constexpr explicit RegisterStore(Image& image) :
+			image_{&image},
+			writeMutex_{distortos::Mutex::Type::normal, distortos::Mutex::Protocol::priorityInheritance},
+			hotRangeCache_{},
+			writeNotificationQueue_{}
+	{
+
+	}
+
+	/**
+	 * \brief Opens the image.
+	 *
+	 * If the header of the image matches layout of the store, values from previous run are kept and the other copy is
+	 * synchronized with the active one. Otherwise the image is formatted - all values are zeroed and the header is
+	 * written.
+	 *
+	 * Must be called before the store is used if the image is provided by the application, before the hot range cache
+	 * is attached.
+	 *
+	 * \return true if values from previous run were restored, false if the image was formatted
+	 */
+
+	bool openImage()
+	{
+		const std::lock_guard<distortos::Mutex> lockGuard {writeMutex_};
+
+		auto& image = getImage();
+		const auto expectedHeader = getExpectedHeader();
+		if (memcmp(&image.header, &expectedHeader, sizeof(expectedHeader)) == 0)
+		{
+			const auto generation = image.generation.load(std::memory_order_relaxed);
+			image.copies[(generation + 1) % 2] = image.copies[generation % 2];
+			return true;
+		}
+
+		// magic is written last, so formatting interrupted by reset is repeated
+		image.header.magic = {};
+		image.generation.store({}, std::memory_order_relaxed);
+		memset(image.copies, 0, sizeof(image.copies));
+		image.header = expectedHeader;
+		return false;
+	}
+
+	/**
+	 * \brief Reads values of coils.
+	 *
+	 * \param [out] buffer is a pointer to buffer for packed values of coils, first coil in least significant bit of
+	 * first byte
+	 * \param [in] address is the address of first coil
+	 * \param [in] count is the number of coils
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of coils is out of bounds;
+	 */
+
+	int readCoils(uint8_t* const buffer, const uint16_t address, const uint16_t count) const
+	{
+		return readBits(Table::coils, buffer, address, count);
+	}
+
+	/**
+	 * \brief Reads values of discrete inputs.
+	 *
+	 * \param [out] buffer is a pointer to buffer for packed values of discrete inputs, first discrete input in least
+	 * significant bit of first byte
+	 * \param [in] address is the address of first discrete input
+	 * \param [in] count is the number of discrete inputs
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of discrete inputs is out of bounds;
+	 */
+
+	int readDiscreteInputs(uint8_t* const buffer, const uint16_t address, const uint16_t count) const
+	{
+		return readBits(Table::discreteInputs, buffer, address, count);
+	}
+
+	/**
+	 * \brief Reads values of holding registers.
+	 *
+	 * \param [out] buffer is a pointer to buffer for values of holding registers, big-endian
+	 * \param [in] address is the address of first holding register
+	 * \param [in] count is the number of holding registers
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of holding registers is out of bounds;
+	 */
+
+	int readHoldingRegisters(uint8_t* const buffer, const uint16_t address, const uint16_t count) const
+	{
+		return readRegisters(Table::holdingRegisters, buffer, address, count);
+	}
+
+	/**
+	 * \brief Reads values of input registers.
+	 *
+	 * \param [out] buffer is a pointer to buffer for values of input registers, big-endian
+	 * \param [in] address is the address of first input register
+	 * \param [in] count is the number of input registers
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of input registers is out of bounds;
+	 */
+
+	int readInputRegisters(uint8_t* const buffer, const uint16_t address, const uint16_t count) const
+	{
+		return readRegisters(Table::inputRegisters, buffer, address, count);
+	}
+
+	/**
+	 * \brief Writes values of coils.
+	 *
+	 * \param [in] buffer is a pointer to buffer with packed values of coils, first coil in least significant bit of
+	 * first byte
+	 * \param [in] address is the address of first coil
+	 * \param [in] count is the number of coils
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of coils is out of bounds;
+	 */
+
+	int writeCoils(const uint8_t* const buffer, const uint16_t address, const uint16_t count)
+	{
+		return writeBits(Table::coils, buffer, address, count);
+	}
+
+	/**
+	 * \brief Writes values of discrete inputs.
+	 *
+	 * \param [in] buffer is a pointer to buffer with packed values of discrete inputs, first discrete input in least
+	 * significant bit of first byte
+	 * \param [in] address is the address of first discrete input
+	 * \param [in] count is the number of discrete inputs
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of discrete inputs is out of bounds;
+	 */
+
+	int writeDiscreteInputs(const uint8_t* const buffer, const uint16_t address, const uint16_t count)
+	{
+		return writeBits(Table::discreteInputs, buffer, address, count);
+	}
+
+	/**
+	 * \brief Writes values of holding registers.
+	 *
+	 * \param [in] buffer is a pointer to buffer with values of holding registers, big-endian
+	 * \param [in] address is the address of first holding register
+	 * \param [in] count is the number of holding registers
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of holding registers is out of bounds;
+	 */
+
+	int writeHoldingRegisters(const uint8_t* const buffer, const uint16_t address, const uint16_t count)
+	{
+		return writeRegisters(Table::holdingRegisters, buffer, address, count);
+	}
+
+	/**
+	 * \brief Writes values of input registers.
+	 *
+	 * \param [in] buffer is a pointer to buffer with values of input registers, big-endian
+	 * \param [in] address is the address of first input register
+	 * \param [in] count is the number of input registers
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of input registers is out of bounds;
+	 */
+
+	int writeInputRegisters(const uint8_t* const buffer, const uint16_t address, const uint16_t count)
+	{
+		return writeRegisters(Table::inputRegisters, buffer, address, count);
+	}
+
+	/**
+	 * \brief Gets value of holding register.
+	 *
+	 * \param [in] address is the address of holding register
+	 *
+	 * \return pair with return code (0 on success, error code otherwise) and value of holding register; error codes:
+	 * - error codes returned by readHoldingRegisters();
+	 */
+
+	std::pair<int, uint16_t> getHoldingRegister(const uint16_t address) const
+	{
+		uint8_t buffer[2] {};
+		const auto ret = readHoldingRegisters(buffer, address, 1);
+		return {ret, buffer[0] << 8 | buffer[1]};
+	}
+
+	/**
+	 * \brief Sets value of holding register.
+	 *
+	 * \param [in] address is the address of holding register
+	 * \param [in] value is the new value of holding register
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by writeHoldingRegisters();
+	 */
+
+	int setHoldingRegister(const uint16_t address, const uint16_t value)
+	{
+		const uint8_t buffer[2] {static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+		return writeHoldingRegisters(buffer, address, 1);
+	}
+
+	/**
+	 * \brief Attaches hot range cache to the store.
+	 *
+	 * The cache is initialized and filled with current values of holding and input registers, all following writes of
+	 * registers also update the cache.
+	 *
+	 * \param [in] hotRangeCache is a pointer to cache which will be attached, nullptr to detach currently attached
+	 * cache
+	 */
+
+	void setHotRangeCache(HotRangeCache* const hotRangeCache)
+	{
+		const std::lock_guard<distortos::Mutex> lockGuard {writeMutex_};
+
+		hotRangeCache_ = hotRangeCache;
+		if (hotRangeCache_ == nullptr)
+			return;
+
+		// both copies are equal while the mutex is locked
+		const auto& image = getImage();
+		const auto& copy = image.copies[image.generation.load(std::memory_order_relaxed) % 2];
+		hotRangeCache_->initialize();
+		hotRangeCache_->update(MB_FUNC_READ_HOLDING_REGISTER, 0, copy.holdingRegisters.data(),
+				HoldingRegistersCount);
+		hotRangeCache_->update(MB_FUNC_READ_INPUT_REGISTER, 0, copy.inputRegisters.data(), InputRegistersCount);
+	}
+
+	/**
+	 * \brief Attaches queue of notifications about writes to the store.
+	 *
+	 * All following writes of coils and holding registers - also the ones done by the application - push notifications
+	 * to the queue. Notifications are published by instances to which the queue is attached, or by explicit call to
+	 * WriteNotificationQueue::publish().
+	 *
+	 * \param [in] writeNotificationQueue is a pointer to queue which will be attached, nullptr to detach currently
+	 * attached queue
+	 */
+
+	void setWriteNotificationQueue(WriteNotificationQueue* const writeNotificationQueue)
+	{
+		const std::lock_guard<distortos::Mutex> lockGuard {writeMutex_};
+		writeNotificationQueue_ = writeNotificationQueue;
+	}
+
+	/**
+	 * \brief Sets value of input register.
+	 *
+	 * \param [in] address is the address of input register
+	 * \param [in] value is the new value of input register
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by writeInputRegisters();
+	 */
+
+	int setInputRegister(const uint16_t address, const uint16_t value)
+	{
+		const uint8_t buffer[2] {static_cast<uint8_t>(value >> 8), static_cast<uint8_t>(value)};
+		return writeInputRegisters(buffer, address, 1);
+	}
+
+private:
+
+	/// Table contains identifiers of tables
+	enum class Table : uint8_t
+	{
+		/// coils
+		coils,
+		/// discrete inputs
+		discreteInputs,
+		/// holding registers
+		holdingRegisters,
+		/// input registers
+		inputRegisters,
+	};
+
+	/**
+	 * \brief Copies bits.
+	 *
+	 * \param [out] destination is a pointer to destination buffer
+	 * \param [in] destinationOffset is the index of first bit in \a destination
+	 * \param [in] source is a pointer to source buffer
+	 * \param [in] sourceOffset is the index of first bit in \a source
+	 * \param [in] count is the number of copied bits
+	 */
+
+	static void copyBits(uint8_t* const destination, const size_t destinationOffset, const uint8_t* const source,
+			const size_t sourceOffset, const size_t count)
+	{
+		for (size_t i {}; i < count; ++i)
+		{
+			const auto bit = (source[(sourceOffset + i) / 8] >> ((sourceOffset + i) % 8)) & 1;
+			auto& byte = destination[(destinationOffset + i) / 8];
+			const auto mask = 1 << ((destinationOffset + i) % 8);
+			byte = bit != 0 ? byte | mask : byte & ~mask;
+		}
+	}
+
+	/**
+	 * \brief Gets number of elements in table.
+	 *
+	 * \param [in] table selects the table
+	 *
+	 * \return number of coils, discrete inputs or registers in selected table
+	 */
+
+	constexpr static size_t getCount(const Table table)
+	{
+		return table == Table::coils ? CoilsCount : table == Table::discreteInputs ? DiscreteInputsCount :
+				table == Table::holdingRegisters ? HoldingRegistersCount : InputRegistersCount;
+	}
+
+	/**
+	 * \return header of image with layout of this store
+	 */
+
+	constexpr static ImageHeader getExpectedHeader()
+	{
+		return {imageMagic, imageVersion, sizeof(ImageHeader), CoilsCount, DiscreteInputsCount, InputRegistersCount,
+				HoldingRegistersCount, sizeof(Image)};
+	}
+
+	/**
+	 * \return reference to the image
+	 */
+
+	Image& getImage()
+	{
+		return getImage(image_);
+	}
+
+	/**
+	 * \return const reference to the image
+	 */
+
+	const Image& getImage() const
+	{
+		return getImage(image_);
+	}
+
+	/**
+	 * \param [in] image is a reference to image which is a member of the store
+	 *
+	 * \return reference to \a image
+	 */
+
+	constexpr static Image& getImage(Image& image)
+	{
+		return image;
+	}
+
+	/**
+	 * \param [in] image is a reference to image which is a member of the store
+	 *
+	 * \return const reference to \a image
+	 */
+
+	constexpr static const Image& getImage(const Image& image)
+	{
+		return image;
+	}
+
+	/**
+	 * \param [in] image is a pointer to image provided by the application
+	 *
+	 * \return reference to \a image
+	 */
+
+	constexpr static Image& getImage(Image* const image)
+	{
+		return *image;
+	}
+
+	/**
+	 * \brief Gets table from copy of tables.
+	 *
+	 * \param [in] copy is a reference to copy of tables
+	 * \param [in] table selects the table
+	 *
+	 * \return pointer to first byte of selected table in \a copy
+	 */
+
+	static const uint8_t* getTable(const Copy& copy, const Table table)
+	{
+		return table == Table::coils ? copy.coils.data() : table == Table::discreteInputs ?
+				copy.discreteInputs.data() : table == Table::holdingRegisters ? copy.holdingRegisters.data() :
+				copy.inputRegisters.data();
+	}
+
+	/**
+	 * \brief Gets table from copy of tables.
+	 *
+	 * \param [in] copy is a reference to copy of tables
+	 * \param [in] table selects the table
+	 *
+	 * \return pointer to first byte of selected table in \a copy
+	 */
+
+	static uint8_t* getTable(Copy& copy, const Table table)
+	{
+		return const_cast<uint8_t*>(getTable(static_cast<const Copy&>(copy), table));
+	}
+
+	/**
+	 * \brief Checks whether range of elements is within table.
+	 *
+	 * \param [in] table selects the table
+	 * \param [in] address is the address of first element
+	 * \param [in] count is the number of elements
+	 *
+	 * \return true if range is within selected table, false otherwise
+	 */
+
+	constexpr static bool isInRange(const Table table, const uint16_t address, const uint16_t count)
+	{
+		return static_cast<size_t>(address) + count <= getCount(table);
+	}
+
+	/**
+	 * \brief Reads data from active copy of tables.
+	 *
+	 * Retries the read if a writer published new copy in the meantime.
+	 *
+	 * \tparam Functor is the type of \a functor
+	 *
+	 * \param [in] functor is a functor which reads data, called with const reference to active copy
+	 */
+
+	template<typename Functor>
+	void read(Functor functor) const
+	{
+		const auto& image = getImage();
+		uint32_t generation;
+		do
+		{
+			generation = image.generation.load(std::memory_order_acquire);
+			functor(image.copies[generation % 2]);
+			std::atomic_thread_fence(std::memory_order_acquire);
+		} while (image.generation.load(std::memory_order_relaxed) != generation);
+	}
+
+	/**
+	 * \brief Reads packed bits from table.
+	 *
+	 * \param [in] table selects the table
+	 * \param [out] buffer is a pointer to buffer for packed bits
+	 * \param [in] address is the address of first bit
+	 * \param [in] count is the number of bits
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of bits is out of bounds;
+	 */
+
+	int readBits(const Table table, uint8_t* const buffer, const uint16_t address, const uint16_t count) const
+	{
+		if (isInRange(table, address, count) == false)
+			return ENOENT;
+
+		read([table, buffer, address, count](const Copy& copy)
+				{
+					copyBits(buffer, 0, getTable(copy, table), address, count);
+				});
+
+		// unused bits of last byte must be zero
+		if (count % 8 != 0)
+			buffer[count / 8] &= (1 << count % 8) - 1;
+
+		return 0;
+	}
+
+	/**
+	 * \brief Reads registers from table.
+	 *
+	 * \param [in] table selects the table
+	 * \param [out] buffer is a pointer to buffer for registers, big-endian
+	 * \param [in] address is the address of first register
+	 * \param [in] count is the number of registers
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of registers is out of bounds;
+	 */
+
+	int readRegisters(const Table table, uint8_t* const buffer, const uint16_t address, const uint16_t count) const
+	{
+		if (isInRange(table, address, count) == false)
+			return ENOENT;
+
+		read([table, buffer, address, count](const Copy& copy)
+				{
+					memcpy(buffer, getTable(copy, table) + address * 2, count * 2);
+				});
+		return 0;
+	}
+
+	/**
+	 * \brief Modifies both copies of tables.
+	 *
+	 * The inactive copy is modified first and published, then the same modification is done to the other copy.
+	 *
+	 * \tparam Functor is the type of \a functor
+	 *
+	 * \param [in] functor is a functor which modifies data, called twice with reference to each copy
+	 */
+
+	template<typename Functor>
+	void write(Functor functor)
+	{
+		write(functor, [](const Copy&)
+				{
+
+				});
+	}
+
+	/**
+	 * \brief Modifies both copies of tables.
+	 *
+	 * The inactive copy is modified first and published, then the same modification is done to the other copy.
+	 *
+	 * \tparam Functor is the type of \a functor
+	 * \tparam Published is the type of \a published
+	 *
+	 * \param [in] functor is a functor which modifies data, called twice with reference to each copy
+	 * \param [in] published is a functor called once with const reference to modified copy, after both copies were
+	 * modified, while the mutex is still locked
+	 */
+
+	template<typename Functor, typename Published>
+	void write(Functor functor, Published published)
+	{
+		std::lock_guard<distortos::Mutex> lockGuard {writeMutex_};
+
+		auto& image = getImage();
+		const auto generation = image.generation.load(std::memory_order_relaxed);
+		functor(image.copies[(generation + 1) % 2]);
+		image.generation.store(generation + 1, std::memory_order_release);
+		// readers which observe any of the following writes must also observe new generation
+		std::atomic_thread_fence(std::memory_order_release);
+		functor(image.copies[generation % 2]);
+		published(static_cast<const Copy&>(image.copies[generation % 2]));
+	}
+
+	/**
+	 * \brief Writes packed bits to table.
+	 *
+	 * \param [in] table selects the table
+	 * \param [in] buffer is a pointer to buffer with packed bits
+	 * \param [in] address is the address of first bit
+	 * \param [in] count is the number of bits
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of bits is out of bounds;
+	 */
+
+	int writeBits(const Table table, const uint8_t* const buffer, const uint16_t address, const uint16_t count)
+	{
+		if (isInRange(table, address, count) == false)
+			return ENOENT;
+
+		write([table, buffer, address, count](Copy& copy)
+				{
+					copyBits(getTable(copy, table), address, buffer, 0, count);
+				},
+				[this, table, address, count](const Copy&)
+				{
+					if (writeNotificationQueue_ != nullptr && table == Table::coils)
+						writeNotificationQueue_->push(WriteNotificationQueue::Type::coils, address, count);
+				});
+		return 0;
+	}
+
+	/**
+	 * \brief Writes registers to table.
+	 *
+	 * \param [in] table selects the table
+	 * \param [in] buffer is a pointer to buffer with registers, big-endian
+	 * \param [in] address is the address of first register
+	 * \param [in] count is the number of registers
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - ENOENT - range of registers is out of bounds;
+	 */
+
+	int writeRegisters(const Table table, const uint8_t* const buffer, const uint16_t address, const uint16_t count)
+	{
+		if (isInRange(table, address, count) == false)
+			return ENOENT;
+
+		write([table, buffer, address, count](Copy& copy)
+				{
+					memcpy(getTable(copy, table) + address * 2, buffer, count * 2);
+				},
+				[this, table, address, count](const Copy& copy)
+				{
+					if (hotRangeCache_ != nullptr)
+						hotRangeCache_->update(table == Table::holdingRegisters ? MB_FUNC_READ_HOLDING_REGISTER :
+								MB_FUNC_READ_INPUT_REGISTER, address, getTable(copy, table) + address * 2, count);
+					if (writeNotificationQueue_ != nullptr && table == Table::holdingRegisters)
+						writeNotificationQueue_->push(WriteNotificationQueue::Type::holdingRegisters, address, count);
+				});
+		return 0;
+	}
+
+	/// image which is a member of the store or pointer to image provided by the application
+	typename std::conditional<ExternalImage == false, Image, Image*>::type image_;
+
+	/// mutex used for serialization of writers
+	distortos::Mutex writeMutex_;
+
+	/// pointer to attached hot range cache, nullptr if not used
+	HotRangeCache* hotRangeCache_;
+
+	/// pointer to attached queue of notifications about writes, nullptr if not used
+	WriteNotificationQueue* writeNotificationQueue_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_REGISTERSTORE_HPP_
@@ -0,0 +1,265 @@
+/**
+ * \file
+ * \brief RequestRateLimiter class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_REQUESTRATELIMITER_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_REQUESTRATELIMITER_HPP_
+
+#include "distortos/Mutex.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+/**
+ * RequestRateLimiter limits the rate of requests which are handled by Modbus TCP and Modbus UDP instances.
+ *
+ * Each connection (master address and port) matched by a rule has its own token bucket with parameters of the rule -
+ * sustained rate and burst. Rules match master address with a mask and optionally the unit identifier, first matching
+ * rule is used. Request which exceeds the rate is either delayed until the bucket allows it (if the delay is not
+ * longer than max delay of the rule) or answered with Server Busy exception (06).
+ *
+ * Optional capacity - token bucket shared by all requests - gives priority order under contention. Request with
+ * priority p (0 - highest) is admitted by the shared bucket only if at least p * reservePerPriority tokens remain in
+ * it, so when the instances are overloaded the least important masters are throttled first, while the most important
+ * ones may use the whole capacity. Requests which match no rule are not limited per connection and have the lowest
+ * priority.
+ *
+ * Rules match IPv4 addresses only. IPv4 master connected to dual-stack listen socket is matched with its IPv4 address.
+ * Any other IPv6 master has address 0, so it is matched only by rules with address 0 (rule with mask 0 matches all
+ * masters, rule with address 0 and mask 0xffffffff matches only IPv6 masters), and its connection is identified by its
+ * port alone.
+ *
+ * Buckets are implemented as generic cell rate algorithm (a bucket is a single time point), with nanosecond
+ * resolution. Bucket storage is provided by the application, bucket of a connection which was idle long enough to be
+ * full again is reused for other connections. One limiter may be shared by any number of instances
+ * (FreemodbusTcpExtensions::requestRateLimiter).
+ *
+ * Delayed request is deferred without blocking the thread which polls the instance - the instance keeps the request in
+ * its frame buffer and receives nothing else until the request is handled, while its poll (and the wait of
+ * FreemodbusScheduler or FreemodbusExecutor) is bounded by the admission time.
+ */
+
+class RequestRateLimiter
+{
+public:
+
+	/// Action is the action taken for request which exceeds its rate
+	enum class Action : uint8_t
+	{
+		/// request is deferred, it is rejected if required delay is longer than max delay of the rule
+		delay,
+		/// request is answered with Server Busy exception
+		reject,
+	};
+
+	/// Counters contains counters of requests
+	struct Counters
+	{
+		/// number of requests admitted without delay
+		uint32_t admitted;
+
+		/// number of requests admitted after delay
+		uint32_t delayed;
+
+		/// number of requests answered with Server Busy exception
+		uint32_t rejected;
+	};
+
+	/// Rule is a rule which selects parameters of token bucket for requests
+	struct Rule
+	{
+		/**
+		 * \brief Rule's constructor
+		 *
+		 * \param [in] addresss is the IPv4 address of masters matched by this rule, network byte order
+		 * \param [in] maskk is the mask of \a addresss, network byte order, 0 matches all masters
+		 * \param [in] unitIdd is the unit identifier matched by this rule, anyUnitId matches all unit identifiers
+		 * \param [in] ratee is the sustained rate, requests per second, 0 disables per-connection limit of the rule
+		 * \param [in] burstt is the max number of requests which may be sent back-to-back, at least 1
+		 * \param [in] priorityy is the priority of requests for the shared capacity, 0 - highest
+		 * \param [in] actionn is the action taken for request which exceeds its rate
+		 * \param [in] maxDelayy is the max delay of request for Action::delay, default - 0
+		 */
+
+		constexpr Rule(const uint32_t addresss, const uint32_t maskk, const uint16_t unitIdd, const uint32_t ratee,
+				const uint16_t burstt, const uint8_t priorityy, const Action actionn,
+				const distortos::TickClock::duration maxDelayy = {}) :
+						maxDelay{maxDelayy},
+						counters{},
+						address{addresss},
+						mask{maskk},
+						rate{ratee},
+						burst{burstt},
+						unitId{unitIdd},
+						action{actionn},
+						priority{priorityy}
+		{
+
+		}
+
+		/// max delay of request for Action::delay
+		distortos::TickClock::duration maxDelay;
+
+		/// counters of requests matched by this rule
+		Counters counters;
+
+		/// IPv4 address of masters matched by this rule, network byte order
+		uint32_t address;
+
+		/// mask of address, network byte order
+		uint32_t mask;
+
+		/// sustained rate, requests per second, 0 if there is no per-connection limit
+		uint32_t rate;
+
+		/// max number of requests which may be sent back-to-back
+		uint16_t burst;
+
+		/// unit identifier matched by this rule, anyUnitId if all unit identifiers are matched
+		uint16_t unitId;
+
+		/// action taken for request which exceeds its rate
+		Action action;
+
+		/// priority of requests for the shared capacity, 0 - highest
+		uint8_t priority;
+	};
+
+	/// time point with resolution finer than tick, used by buckets
+	using TimePoint = std::chrono::time_point<distortos::TickClock, std::chrono::nanoseconds>;
+
+	/// Bucket is a token bucket of one connection
+	struct Bucket
+	{
+		/**
+		 * \brief Bucket's constructor
+		 */
+
+		constexpr Bucket() :
+				theoreticalArrival{},
+				address{},
+				port{},
+				rule{},
+				used{}
+		{
+
+		}
+
+		/// theoretical arrival time of next request, bucket is full when it is in the past
+		TimePoint theoreticalArrival;
+
+		/// IPv4 address of master, network byte order
+		uint32_t address;
+
+		/// port of master, network byte order
+		uint16_t port;
+
+		/// index of rule which configures this bucket
+		uint8_t rule;
+
+		/// true if bucket is assigned to a connection, false otherwise
+		bool used;
+	};
+
+	/// value of Rule::unitId which matches all unit identifiers
+	constexpr static uint16_t anyUnitId {0x100};
+
+	/// priority of requests which match no rule
+	constexpr static uint8_t unmatchedPriority {UINT8_MAX};
+
+	/// type alias for range of buckets
+	using BucketsRange = estd::ContiguousRange<Bucket>;
+
+	/// type alias for range of rules
+	using RulesRange = estd::ContiguousRange<Rule>;
+
+	/**
+	 * \brief RequestRateLimiter's constructor
+	 *
+	 * \param [in] rulesRangee is a range of rules, at most 256 elements
+	 * \param [in] bucketsRangee is a range of buckets, should have at least as many elements as the number of
+	 * connections matched by rules with non-zero rate
+	 * \param [in] capacityy is the rate of the capacity shared by all requests, requests per second, 0 disables the
+	 * shared capacity
+	 * \param [in] capacityBurstt is the max number of requests which may be admitted back-to-back by the shared
+	 * capacity, at least 1
+	 * \param [in] reservePerPriorityy is the number of tokens of the shared capacity reserved for each higher priority
+	 */
+
+	constexpr RequestRateLimiter(const RulesRange rulesRangee, const BucketsRange bucketsRangee,
+			const uint32_t capacityy, const uint16_t capacityBurstt, const uint16_t reservePerPriorityy) :
+					mutex_{distortos::Mutex::Type::normal, distortos::Mutex::Protocol::priorityInheritance},
+					capacityTheoreticalArrival_{},
+					unmatchedCounters_{},
+					bucketsRange_{bucketsRangee},
+					rulesRange_{rulesRangee},
+					capacity_{capacityy},
+					capacityBurst_{capacityBurstt},
+					reservePerPriority_{reservePerPriorityy}
+	{
+
+	}
+
+	/**
+	 * \brief Decides whether request may be handled.
+	 *
+	 * \param [in] address is the IPv4 address of master, network byte order, 0 for IPv6 master
+	 * \param [in] port is the port of master, network byte order
+	 * \param [in] unitId is the unit identifier of request
+	 * \param [out] admissionTime is a reference to variable for time point at which the request may be handled, in the
+	 * past if it may be handled immediately
+	 *
+	 * \return 0 if request is admitted, error code otherwise:
+	 * - EBUSY - request must be answered with Server Busy exception;
+	 */
+
+	int admit(uint32_t address, uint16_t port, uint8_t unitId, distortos::TickClock::time_point& admissionTime);
+
+	/**
+	 * \param [in] rule is the index of rule
+	 *
+	 * \return counters of requests matched by \a rule
+	 */
+
+	Counters getCounters(size_t rule) const;
+
+	/**
+	 * \return counters of requests which match no rule
+	 */
+
+	Counters getUnmatchedCounters() const;
+
+private:
+
+	/// mutex used for serialization of access to buckets and counters
+	mutable distortos::Mutex mutex_;
+
+	/// theoretical arrival time of next request for the shared capacity
+	TimePoint capacityTheoreticalArrival_;
+
+	/// counters of requests which match no rule
+	Counters unmatchedCounters_;
+
+	/// range of buckets
+	BucketsRange bucketsRange_;
+
+	/// range of rules
+	RulesRange rulesRange_;
+
+	/// rate of the shared capacity, requests per second, 0 if disabled
+	uint32_t capacity_;
+
+	/// max number of requests which may be admitted back-to-back by the shared capacity
+	uint16_t capacityBurst_;
+
+	/// number of tokens of the shared capacity reserved for each higher priority
+	uint16_t reservePerPriority_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_REQUESTRATELIMITER_HPP_
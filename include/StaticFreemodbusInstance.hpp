@@ -0,0 +1,117 @@
+/**
+ * \file
+ * \brief StaticFreemodbusInstance and StaticFreemodbusTcpInstance class templates header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_STATICFREEMODBUSINSTANCE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_STATICFREEMODBUSINSTANCE_HPP_
+
+#include "FreemodbusSerialInstance.hpp"
+#include "FreemodbusUdpInstance.hpp"
+
+/**
+ * StaticFreemodbusInstance is a variant of FreemodbusSerialInstance that has automatic storage for frame buffer.
+ *
+ * \tparam FrameBufferSize is the size of frame buffer, bytes
+ */
+
+template<size_t FrameBufferSize = FreemodbusSerialInstance::serialBufferSize>
+class StaticFreemodbusInstance : public FreemodbusSerialInstance
+{
+public:
+
+	/**
+	 * \brief StaticFreemodbusInstance's constructor
+	 *
+	 * \param [in] serialPortt is a reference to serial port that will be used for communication for Modbus ASCII/RTU
+	 */
+
+	constexpr explicit StaticFreemodbusInstance(distortos::devices::SerialPort& serialPortt) :
+			FreemodbusSerialInstance{serialPortt, frameBufferStorage_, sizeof(frameBufferStorage_)},
+			frameBufferStorage_{}
+	{
+
+	}
+
+private:
+
+	/// storage for frame buffer
+	uint8_t frameBufferStorage_[FrameBufferSize];
+};
+
+#if MB_TCP_ENABLED == 1
+
+/**
+ * StaticFreemodbusTcpInstance is a variant of FreemodbusTcpInstance that has automatic storage for frame buffer.
+ *
+ * \tparam FrameBufferSize is the size of frame buffer, bytes
+ */
+
+template<size_t FrameBufferSize = FreemodbusTcpInstance::tcpBufferSize>
+class StaticFreemodbusTcpInstance : public FreemodbusTcpInstance
+{
+public:
+
+	/**
+	 * \brief StaticFreemodbusTcpInstance's constructor
+	 *
+	 * \param [in] listenSocketsRangee is a range of listen sockets for Modbus TCP
+	 * \param [in] listenSocketsRangeMutexx is a pointer to mutex used for serialization of access to shared listen
+	 * sockets for Modbus TCP
+	 */
+
+	constexpr StaticFreemodbusTcpInstance(const ListenSocketsRange listenSocketsRangee,
+			distortos::Mutex* const listenSocketsRangeMutexx) :
+					FreemodbusTcpInstance{listenSocketsRangee, listenSocketsRangeMutexx, frameBufferStorage_,
+							sizeof(frameBufferStorage_)},
+					frameBufferStorage_{}
+	{
+
+	}
+
+private:
+
+	/// storage for frame buffer
+	uint8_t frameBufferStorage_[FrameBufferSize];
+};
+
+/**
+ * StaticFreemodbusUdpInstance is a variant of FreemodbusUdpInstance that has automatic storage for frame buffer.
+ *
+ * \tparam FrameBufferSize is the size of frame buffer, bytes
+ */
+
+template<size_t FrameBufferSize = FreemodbusTcpInstance::tcpBufferSize>
+class StaticFreemodbusUdpInstance : public FreemodbusUdpInstance
+{
+public:
+
+	/**
+	 * \brief StaticFreemodbusUdpInstance's constructor
+	 *
+	 * \param [in] localAddresss is the local address to which the socket is bound, default - any local IPv4 address
+	 */
+
+	constexpr explicit StaticFreemodbusUdpInstance(
+			const ListenSocket::LocalAddress& localAddresss = ListenSocket::ipv4Address({})) :
+					FreemodbusUdpInstance{frameBufferStorage_, sizeof(frameBufferStorage_), localAddresss},
+					frameBufferStorage_{}
+	{
+
+	}
+
+private:
+
+	/// storage for frame buffer
+	uint8_t frameBufferStorage_[FrameBufferSize];
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_STATICFREEMODBUSINSTANCE_HPP_
@@ -0,0 +1,103 @@
+/**
+ * \file
+ * \brief TcpTransport class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_TCPTRANSPORT_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_TCPTRANSPORT_HPP_
+
+#include "mbconfig.h"
+
+#if MB_TCP_ENABLED == 1
+
+#include "distortos/TickClock.hpp"
+
+#include "lwip/sockets.h"
+
+/**
+ * TcpTransport is an interface of transport layer used by Modbus TCP instance on top of connected client socket.
+ *
+ * Instance without transport uses the socket directly. Each instance needs its own transport object, as it holds the
+ * state of the connection.
+ *
+ * accept() and receive() are called from the poll loop of the instance, which waits for the socket with select(), so
+ * they must not block - work which needs more data (like the rest of partially received record) is left for the next
+ * call.
+ */
+
+class TcpTransport
+{
+public:
+
+	/**
+	 * \brief TcpTransport's destructor
+	 */
+
+	virtual ~TcpTransport() = default;
+
+	/**
+	 * \brief Starts the transport on newly accepted client socket.
+	 *
+	 * \param [in] socket is the accepted client socket
+	 *
+	 * \return 0 on success, error code otherwise
+	 */
+
+	virtual int accept(int socket) = 0;
+
+	/**
+	 * \brief Stops the transport before client socket is closed.
+	 *
+	 * \param [in] socket is the client socket
+	 */
+
+	virtual void close(int socket) = 0;
+
+	/**
+	 * \return time point at which receive() must be called even if the socket has no data - e.g. to enforce timeout
+	 * of handshake, distortos::TickClock::time_point::max() if there is none
+	 */
+
+	virtual distortos::TickClock::time_point getDeadline() const = 0;
+
+	/**
+	 * \return true if the transport has received data which can be read without waiting for the socket, false otherwise
+	 */
+
+	virtual bool hasBufferedData() const = 0;
+
+	/**
+	 * \brief Receives data.
+	 *
+	 * \param [in] socket is the client socket
+	 * \param [out] buffer is a pointer to buffer for received data
+	 * \param [in] size is the size of \a buffer, bytes
+	 *
+	 * \return number of received bytes, 0 if connection was closed, negative value on error - if errno is EAGAIN,
+	 * no data is available yet and the connection is still usable
+	 */
+
+	virtual ssize_t receive(int socket, void* buffer, size_t size) = 0;
+
+	/**
+	 * \brief Sends data.
+	 *
+	 * \param [in] socket is the client socket
+	 * \param [in] iov is a pointer to array with buffers which will be sent in order
+	 * \param [in] iovCount is the number of elements in \a iov array
+	 *
+	 * \return number of sent bytes, negative value on error
+	 */
+
+	virtual ssize_t send(int socket, const iovec* iov, int iovCount) = 0;
+};
+
+#endif	// MB_TCP_ENABLED == 1
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_TCPTRANSPORT_HPP_
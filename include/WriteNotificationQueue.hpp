@@ -0,0 +1,158 @@
+/**
+ * \file
+ * \brief WriteNotificationQueue class header
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_INCLUDE_WRITENOTIFICATIONQUEUE_HPP_
+#define FREEMODBUS_INTEGRATION_INCLUDE_WRITENOTIFICATIONQUEUE_HPP_
+
+#include "distortos/Semaphore.hpp"
+#include "distortos/TickClock.hpp"
+
+#include "estd/ContiguousRange.hpp"
+
+#include <atomic>
+
+/**
+ * WriteNotificationQueue is a bounded lock-free queue of notifications about writes of coils and holding registers,
+ * with serialized producers and single consumer (application thread).
+ *
+ * Notifications are pushed with push() - by RegisterStore to which the queue is attached or directly by register
+ * callbacks. They become visible to the consumer only when they are published - and the consumer is woken - when the
+ * instance goes back to waiting for next event in xMBPortEventGet(), so the consumer sees all writes of a request at
+ * once.
+ */
+
+class WriteNotificationQueue
+{
+public:
+
+	/// Type contains possible types of written objects
+	enum class Type : uint8_t
+	{
+		/// coils
+		coils,
+		/// holding registers
+		holdingRegisters,
+	};
+
+	/// Notification is a single notification about write
+	struct Notification
+	{
+		/// time point of write
+		distortos::TickClock::time_point timestamp;
+
+		/// address of first written object
+		uint16_t address;
+
+		/// number of written objects
+		uint16_t count;
+
+		/// type of written objects
+		Type type;
+	};
+
+	/// type alias for range of storage for notifications
+	using StorageRange = estd::ContiguousRange<Notification>;
+
+	/**
+	 * \brief WriteNotificationQueue's constructor
+	 *
+	 * \param [in] storageRange is a range of storage for notifications, its size is the capacity of the queue
+	 */
+
+	constexpr explicit WriteNotificationQueue(const StorageRange storageRange) :
+			storageRange_{storageRange},
+			semaphore_{0, 1},
+			readPosition_{},
+			writePosition_{},
+			overflowCount_{},
+			publishedPosition_{}
+	{
+
+	}
+
+	/**
+	 * \return number of notifications which were dropped because the queue was full
+	 */
+
+	size_t getOverflowCount() const
+	{
+		return overflowCount_.load(std::memory_order_relaxed);
+	}
+
+	/**
+	 * \brief Publishes all pushed notifications and wakes the consumer if any were pushed since last call.
+	 *
+	 * May be called concurrently by any number of threads.
+	 */
+
+	void publish();
+
+	/**
+	 * \brief Pushes notification to the queue.
+	 *
+	 * Calls must be serialized - RegisterStore calls it with its writer mutex locked.
+	 *
+	 * \param [in] type is the type of written objects
+	 * \param [in] address is the address of first written object
+	 * \param [in] count is the number of written objects
+	 *
+	 * \return true if notification was pushed, false if the queue is full
+	 */
+
+	bool push(Type type, uint16_t address, uint16_t count);
+
+	/**
+	 * \brief Tries to pop published notification from the queue.
+	 *
+	 * Must be called only by the consumer.
+	 *
+	 * \param [out] notification is a reference to buffer for popped notification
+	 *
+	 * \return true if notification was popped, false if there are no published notifications
+	 */
+
+	bool tryPop(Notification& notification);
+
+	/**
+	 * \brief Waits until the consumer is woken by publish().
+	 *
+	 * Must be called only by the consumer.
+	 *
+	 * \param [in] deadline is the deadline of waiting
+	 *
+	 * \return 0 on success, error code otherwise:
+	 * - error codes returned by distortos::Semaphore::tryWaitUntil();
+	 */
+
+	int waitUntil(distortos::TickClock::time_point deadline);
+
+private:
+
+	/// range of storage for notifications
+	StorageRange storageRange_;
+
+	/// semaphore used to wake the consumer
+	distortos::Semaphore semaphore_;
+
+	/// number of notifications popped so far, written only by the consumer
+	std::atomic<size_t> readPosition_;
+
+	/// number of notifications pushed so far, written only by the producer
+	std::atomic<size_t> writePosition_;
+
+	/// number of notifications which were dropped because the queue was full
+	std::atomic<size_t> overflowCount_;
+
+	/// number of notifications published so far, only the notifications before it are visible to the consumer
+	std::atomic<size_t> publishedPosition_;
+};
+
+#endif	// FREEMODBUS_INTEGRATION_INCLUDE_WRITENOTIFICATIONQUEUE_HPP_
@@ -2,7 +2,7 @@
  * \file
  * \brief FreeMODBUS configuration
  *
- * \author Copyright (C) 2019 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ * \author Copyright (C) 2019-2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
  *
  * \par License
  * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
@@ -28,6 +28,11 @@ extern "C"
 #define MB_ASCII_TIMEOUT_WAIT_BEFORE_SEND_MS		0
 #endif	/* !def MB_ASCII_TIMEOUT_WAIT_BEFORE_SEND_MS */
 
+#ifndef MB_TCP_TLS_ENABLED
+/** Enables Modbus/TCP Security transport implemented with mbedTLS (MbedtlsTransport) */
+#define MB_TCP_TLS_ENABLED							0
+#endif	/* !def MB_TCP_TLS_ENABLED */
+
 #ifndef MB_FUNC_HANDLERS_MAX
 /** Number of supported Modbus functions codes */
 #define MB_FUNC_HANDLERS_MAX						16
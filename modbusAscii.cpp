@@ -0,0 +1,94 @@
+/**
+ * \file
+ * \brief Definitions of Modbus ASCII codec functions
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "modbusAscii.hpp"
+
+#include <cerrno>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+int modbusAsciiDecode(const char* const input, const size_t size, uint8_t* const output, uint8_t& sum)
+{
+	/// values of hex digits, 0xff for characters which are not hex digits
+	static const uint8_t table[256]
+	{
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+			0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+	};
+
+	const auto characters = reinterpret_cast<const uint8_t*>(input);
+	auto localSum = sum;
+	for (size_t i {}; i < size; ++i)
+	{
+		// both characters are read before the byte is written, so decoding in place is safe
+		const auto high = table[characters[2 * i]];
+		const auto low = table[characters[2 * i + 1]];
+		if (((high | low) & 0xf0) != 0)
+			return EINVAL;
+
+		const uint8_t byte = high << 4 | low;
+		output[i] = byte;
+		localSum += byte;
+	}
+
+	sum = localSum;
+	return 0;
+}
+
+uint8_t modbusAsciiEncode(const uint8_t* const input, const size_t size, char* const output, uint8_t sum)
+{
+	/// pairs of upper case hex digits for all values of byte
+	static const char table[2 * 256 + 1]
+	{
+			"000102030405060708090A0B0C0D0E0F"
+			"101112131415161718191A1B1C1D1E1F"
+			"202122232425262728292A2B2C2D2E2F"
+			"303132333435363738393A3B3C3D3E3F"
+			"404142434445464748494A4B4C4D4E4F"
+			"505152535455565758595A5B5C5D5E5F"
+			"606162636465666768696A6B6C6D6E6F"
+			"707172737475767778797A7B7C7D7E7F"
+			"808182838485868788898A8B8C8D8E8F"
+			"909192939495969798999A9B9C9D9E9F"
+			"A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+			"B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+			"C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+			"D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+			"E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+			"F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF"
+	};
+
+	for (size_t i {}; i < size; ++i)
+	{
+		const auto byte = input[i];
+		output[2 * i] = table[2 * byte];
+		output[2 * i + 1] = table[2 * byte + 1];
+		sum += byte;
+	}
+
+	return sum;
+}
@@ -0,0 +1,57 @@
+/**
+ * \file
+ * \brief Header with Modbus ASCII codec functions
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_MODBUSASCII_HPP_
+#define FREEMODBUS_INTEGRATION_MODBUSASCII_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Decodes hex characters of Modbus ASCII frame to binary data and calculates its sum for LRC.
+ *
+ * Each character is decoded with one table lookup. Both upper and lower case hex digits are accepted. Decoding may be
+ * done in place - \a output may be the same buffer as \a input.
+ *
+ * \param [in] input is a pointer to hex characters, 2 * \a size characters are decoded
+ * \param [in] size is the number of decoded bytes
+ * \param [out] output is a pointer to buffer for decoded bytes, at least \a size bytes
+ * \param [in,out] sum is the sum (modulo 256) of previously decoded bytes, all decoded bytes are added to it, allows
+ * decoding data split into multiple chunks; sum of complete frame including its LRC field is 0 for frames without
+ * errors
+ *
+ * \return 0 on success, error code otherwise:
+ * - EINVAL - \a input contains character which is not a hex digit, contents of \a output and \a sum are undefined;
+ */
+
+int modbusAsciiDecode(const char* input, size_t size, uint8_t* output, uint8_t& sum);
+
+/**
+ * \brief Encodes binary data as hex characters of Modbus ASCII frame and calculates its sum for LRC.
+ *
+ * Each byte is encoded as two upper case hex digits with one table lookup.
+ *
+ * \param [in] input is a pointer to encoded bytes
+ * \param [in] size is the number of encoded bytes
+ * \param [out] output is a pointer to buffer for hex characters, at least 2 * \a size characters
+ * \param [in] sum is the sum (modulo 256) of previously encoded bytes, allows encoding data split into multiple chunks,
+ * default - 0
+ *
+ * \return \a sum increased by all encoded bytes (modulo 256), LRC of the frame is its two's complement
+ */
+
+uint8_t modbusAsciiEncode(const uint8_t* input, size_t size, char* output, uint8_t sum = {});
+
+#endif	// FREEMODBUS_INTEGRATION_MODBUSASCII_HPP_
@@ -0,0 +1,37 @@
+/**
+ * \file
+ * \brief modbusCrc16() declaration
+ *
+ * \author Copyright (C) 2026 Kamil Szczygiel https://distortec.com https://freddiechopin.info
+ *
+ * \par License
+ * This Source Code Form is subject to the terms of the Mozilla Public License, v. 2.0. If a copy of the MPL was not
+ * distributed with this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef FREEMODBUS_INTEGRATION_MODBUSCRC16_HPP_
+#define FREEMODBUS_INTEGRATION_MODBUSCRC16_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+/*---------------------------------------------------------------------------------------------------------------------+
+| global functions
++---------------------------------------------------------------------------------------------------------------------*/
+
+/**
+ * \brief Calculates CRC-16 of Modbus RTU frame.
+ *
+ * Calculating CRC of complete frame (including its CRC field) gives 0 for frames without errors.
+ *
+ * \param [in] buffer is a pointer to data for which CRC will be calculated
+ * \param [in] size is the size of \a buffer, bytes
+ * \param [in] crc is the initial value of CRC, allows calculating CRC of data split into multiple chunks, default -
+ * 0xffff
+ *
+ * \return CRC-16 of \a buffer, low byte is transmitted first
+ */
+
+uint16_t modbusCrc16(const void* buffer, size_t size, uint16_t crc = 0xffff);
+
+#endif	// FREEMODBUS_INTEGRATION_MODBUSCRC16_HPP_